@@ -79,6 +79,11 @@ class IVisitor;
  *          the beginning of each new scenario) or in a stabilization
  *          run (where we might have to run each stabilization period
  *          many times to find the right GHG tax).
+ *
+ *          When built with HECTOR_ROLLBACK_ENABLED the core is instead
+ *          rolled back to the end of the previous GCAM period once it
+ *          has been spun up for the scenario, see restoreCheckpoint().
+ *          This is experimental and off by default.
  */
 class HectorModel: public IClimateModel {
 public:
@@ -190,12 +195,23 @@ private:
 
     //! output stream visitor
     std::auto_ptr<Hector::CSVOutputStreamVisitor> mHosv;
+
+#if HECTOR_ROLLBACK_ENABLED
+    //! Whether mHcore has been spun up for the current scenario and so
+    //! may be rolled back rather than re-initialized.
+    bool mIsCoreReady;
+#endif
     
     // private functions
     
     //! reset the Hector GCAM component and the Hector model for a new run
     void reset( const int aPeriod );
 
+#if HECTOR_ROLLBACK_ENABLED
+    //! roll the Hector model back to the checkpoint before the given period
+    bool restoreCheckpoint( const int aPeriod );
+#endif
+
     //! worker routine for setting emissions
     bool setEmissionsByYear( const std::string& aGasName, const int aYear, double aEmissions );
 
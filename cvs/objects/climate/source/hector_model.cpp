@@ -86,6 +86,9 @@ namespace {
 } 
 
 HectorModel::HectorModel()
+#if HECTOR_ROLLBACK_ENABLED
+:mIsCoreReady( false )
+#endif
 {
     // Set default values for config variables.  All of these can be
     // overridden in XML input.
@@ -198,6 +201,11 @@ void HectorModel::completeInit( const string& aScenarioName ) {
         climatelog << "Parsing ini file= " << mHectorIniFile << endl;
         Hector::INIToCoreReader coreParser( mHcore.get() );
         coreParser.parse( mHectorIniFile ); 
+#if HECTOR_ROLLBACK_ENABLED
+        // This is a new scenario so the first reset must spin the core up
+        // from scratch.
+        mIsCoreReady = false;
+#endif
     }
     catch( const h_exception& e ) {
         cerr << "Exception: " << e << endl;
@@ -332,15 +340,22 @@ void HectorModel::completeInit( const string& aScenarioName ) {
  *          that we can run a new scenario or rerun some periods that
  *          we've already done.  Currently this entails shutting down
  *          all of the hector components, freeing them, and
- *          re-initializing.  Hopefully we will at some point fix
- *          hector so that we can just roll it back to a previous
- *          time.
+ *          re-initializing.  When built with HECTOR_ROLLBACK_ENABLED
+ *          and the core has already been spun up for this scenario it
+ *          is instead rolled back to the end of the period before
+ *          aPeriod, see restoreCheckpoint().
  */
 void HectorModel::reset( const int aPeriod ) {
     ILogger& climatelog = ILogger::getLogger( "climate-log" );
     climatelog.setLevel( ILogger::DEBUG );
 
     climatelog << "Hector reset to period= " << aPeriod << endl;
+
+#if HECTOR_ROLLBACK_ENABLED
+    if( mIsCoreReady && restoreCheckpoint( aPeriod ) ) {
+        return;
+    }
+#endif
     
     if (mHcore.get() ) {
         // shutdown all Hector components and delete.
@@ -366,6 +381,9 @@ void HectorModel::reset( const int aPeriod ) {
     coreParser.parse( mHectorIniFile );
     mHcore->addVisitor( mHosv.get() ); 
     mHcore->prepareToRun();
+#if HECTOR_ROLLBACK_ENABLED
+    mIsCoreReady = true;
+#endif
 
     const Modeltime* modeltime = scenario->getModeltime();
 
@@ -404,6 +422,51 @@ void HectorModel::reset( const int aPeriod ) {
     mHcore->run( static_cast<double>( mLastYear ) );
 }
 
+#if HECTOR_ROLLBACK_ENABLED
+/*!
+ * \brief Roll the hector model back to the end of the period before aPeriod.
+ * \details Uses Hector::Core::reset which restores the state hector keeps
+ *          for every year it has run rather than re-reading its
+ *          configuration and re-running the spin-up.  Unlike the full
+ *          reset the emissions are not replayed: the core keeps every
+ *          emission point set in the previous trial, including those after
+ *          aPeriod, and the state at the checkpoint was computed with the
+ *          previous aPeriod emissions.  The results therefore only match
+ *          the full reset if hector interpolates emissions linearly between
+ *          points.  This has not been validated which is why it is only
+ *          compiled in when HECTOR_ROLLBACK_ENABLED is set.
+ * \param aPeriod The period which is about to be rerun.
+ * \return Whether the core could be rolled back, if not a full reset is
+ *         required.
+ */
+bool HectorModel::restoreCheckpoint( const int aPeriod ) {
+    const Modeltime* modeltime = scenario->getModeltime();
+    const int checkpointYear = aPeriod > 1 ? modeltime->getper_to_yr( aPeriod - 1 ) :
+        modeltime->getStartYear();
+    if( checkpointYear > mLastYear ) {
+        // We never ran that far with this core.
+        return false;
+    }
+
+    ILogger& climatelog = ILogger::getLogger( "climate-log" );
+    try {
+        climatelog.setLevel( ILogger::DEBUG );
+        climatelog << "Restoring Hector core to year= " << checkpointYear << endl;
+        mHcore->reset( static_cast<double>( checkpointYear ) );
+    }
+    catch( const h_exception& e ) {
+        climatelog.setLevel( ILogger::WARNING );
+        climatelog << "Could not restore Hector core to year= " << checkpointYear
+                   << ", re-initializing instead: " << e << endl;
+        return false;
+    }
+    (*mOfile) << "\n\n################ Hector Core Restored to " << checkpointYear
+              << " ################\n\n";
+    mLastYear = checkpointYear;
+    return true;
+}
+#endif // HECTOR_ROLLBACK_ENABLED
+
 /*! \brief Set emissions for hector model 
  *  \details Set emissions for the requested gas, unless the year is
  *           before the historical switch-over year, in which case we
@@ -46,10 +46,12 @@
 
 #include <string>
 #include <list>
+#include <vector>
 #include <memory>
 #include <xercesc/dom/DOMNode.hpp>
 #include "containers/include/iscenario_runner.h"
 class Timer;
+class BatchCSVOutputter;
 
 /*! 
  * \ingroup Objects
@@ -76,6 +78,19 @@ class Timer;
  *          "BatchMode". The name of the configuration file is determined by the
  *          file configuration value "BatchFileName".
  *
+ *          All permutations are collected into a queue before any are run. By
+ *          default the queue is run one scenario at a time. If the integer
+ *          configuration value "max-parallel-scenarios" is greater than one, up
+ *          to that many scenarios are run at once, each in a forked child
+ *          process so that scenarios share nothing but the already parsed
+ *          configuration and batch file. The parent process never runs a
+ *          scenario itself, so no solver threads exist at the time of a fork.
+ *          Writing to the XML database and the batch CSV file is serialized
+ *          between the children with a lock file, however log files are shared
+ *          and messages from concurrent scenarios will be interleaved.
+ *          Parallel scenarios are not supported on Windows and the queue is run
+ *          serially there.
+ *
  *          <b>XML specification for BatchRunner</b>
  *          - XML name: \c BatchRunner
  *          - Contained by: None.
@@ -178,12 +193,37 @@ protected:
     //! The current scenario runner.
     IScenarioRunner* mInternalRunner;
 
+    //! File descriptor of the lock file which serializes output between
+    //! parallel scenarios, or -1 when running serially.
+    int mOutputLockFD;
+
+    //! A single scenario waiting to be run: a set of files and the runner to
+    //! run them with.
+    struct QueuedScenario {
+        //! The component containing the file sets to read.
+        Component mComponent;
+
+        //! The scenario runner to use.
+        IScenarioRunner* mRunner;
+    };
+
 	BatchRunner();
 	bool runSingleScenario( IScenarioRunner* aScenarioRunner,
                             const Component& aCurrComponent,
                             const int aSinglePeriod,
                             Timer& aTimer );
 
+    bool runQueuedScenario( const QueuedScenario& aQueuedScenario,
+                            BatchCSVOutputter& aCSVOutputter,
+                            const int aSinglePeriod,
+                            Timer& aTimer );
+
+    bool runQueueInParallel( const std::vector<QueuedScenario>& aQueue,
+                             const unsigned int aMaxWorkers,
+                             BatchCSVOutputter& aCSVOutputter,
+                             const int aSinglePeriod,
+                             Timer& aTimer );
+
     bool XMLParseComponentSet( const xercesc::DOMNode* aNode );
 
     bool XMLParseRunnerSet( const xercesc::DOMNode* aNode );
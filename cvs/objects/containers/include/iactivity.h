@@ -71,6 +71,17 @@ public:
      * \return A description of this activity.
      */
     virtual std::string getDescription() const = 0;
+    
+    /*!
+     * \brief Get the model object whose state this activity calculates.
+     * \details This is used to group the state data each activity works on
+     *          together in memory.  Activities which do not own any state may
+     *          return null.
+     * \return The object which will be calculated by this activity.
+     */
+    virtual const void* getStateOwner() const {
+        return 0;
+    }
 };
 
 /*!
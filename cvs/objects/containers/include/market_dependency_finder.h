@@ -48,11 +48,17 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <list>
+
+#if GCAM_PARALLEL_ENABLED
+#include <mutex>
+#endif
 
 class Marketplace;
 class IActivity;
 #if GCAM_PARALLEL_ENABLED
 class GcamFlowGraph;
+template<class nodeid_t> class digraph;
 #endif
 
 /*! 
@@ -97,7 +103,11 @@ public:
     const std::vector<IActivity*> getOrdering( const int aMarketNumber = -1 ) const;
 
 #if GCAM_PARALLEL_ENABLED
-    GcamFlowGraph* getFlowGraph( const int aMarketNumber = -1 );
+    GcamFlowGraph* getFlowGraph();
+    
+    GcamFlowGraph* acquireFlowGraph( const int aMarketNumber );
+    
+    void releaseFlowGraph( const int aMarketNumber );
 #endif
 
     void resolveActivityToDependency( const std::string& aRegionName, 
@@ -278,7 +288,7 @@ public:
     struct MarketToDependencyItem {
         MarketToDependencyItem( const int aMarketNumber ):mMarket( aMarketNumber )
 #if GCAM_PARALLEL_ENABLED
-                                                          ,mFlowGraph( 0 )
+                                                          ,mFlowGraph( 0 ), mFlowGraphUsers( 0 )
 #endif
         {}
         
@@ -300,8 +310,14 @@ public:
         //! A flow graph of vertices to re-calculate in parallel should this market
         //! change it's price.  Note that this is essentially a cache and only computed
         //! the first time it is needed.  This memory is owned my MarketDependencyFinder
-        //! and will be released explictly by it.
+        //! and will be released explictly by it, possibly before the end of the model
+        //! run if the cache grows too large.
         GcamFlowGraph* mFlowGraph;
+        
+        //! The number of callers which have acquired mFlowGraph and not yet
+        //! released it.  The graph can not be evicted from the cache until this
+        //! drops back to zero.
+        int mFlowGraphUsers;
 #endif
     };
     
@@ -335,6 +351,24 @@ public:
 #if GCAM_PARALLEL_ENABLED
     //! The global flow graph to calculate the full model in parallel
     GcamFlowGraph* mTBBGraphGlobal;
+    
+    //! The dependency graph of all activities which is needed to generate any
+    //! flow graph.  It is kept to avoid regenerating it for each market.
+    digraph<IActivity*>* mGCAMFlowGraph;
+    
+    //! The markets which currently have a flow graph cached ordered from most
+    //! to least recently acquired.
+    std::list<MarketToDependencyItem*> mFlowGraphLRU;
+    
+    //! The maximum number of market flow graphs to keep cached, graphs which
+    //! have not been acquired recently will be released beyond this limit.
+    size_t mMaxCachedFlowGraphs;
+    
+    //! Guards generating and evicting market flow graphs which may be requested
+    //! from many threads at once while calculating partial derivatives.
+    std::mutex mFlowGraphMutex;
+    
+    void createGCAMFlowGraph();
 #endif
     
     void findVerticesToCalculate( CalcVertex* aVertex, std::set<IActivity*>& aVisited ) const;
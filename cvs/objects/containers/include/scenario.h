@@ -111,6 +111,7 @@ public:
     static const std::string& getXMLNameStatic();
     const std::vector<int>& getUnsolvedPeriods() const;
     void invalidatePeriod( const int aPeriod );
+    bool solversReusePriorSolutions() const;
     ManageStateVariables* getManageStateVariables() const;
 
     //! Constant which when passed to the run method means to run all model periods.
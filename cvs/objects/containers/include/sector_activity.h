@@ -73,6 +73,8 @@ public:
     
     std::string getDescription() const;
     
+    const void* getStateOwner() const;
+    
     IActivity* getSectorPriceActivity() const;
     
     IActivity* getSectorDemandActivity() const;
@@ -111,6 +113,8 @@ public:
     virtual void calc( const int aPeriod );
     
     virtual std::string getDescription() const;
+    
+    virtual const void* getStateOwner() const;
 private:
     SectorPriceActivity( boost::shared_ptr<SectorActivity> aSectorActivity );
     
@@ -134,6 +138,8 @@ public:
     virtual void calc( const int aPeriod );
     
     virtual std::string getDescription() const;
+    
+    virtual const void* getStateOwner() const;
 private:
     SectorDemandActivity( boost::shared_ptr<SectorActivity> aSectorActivity );
     
@@ -58,7 +58,8 @@ class Curve;
 *        already run scenario.
 * \details This class runs a scenario multiple times while varying a fixed
 *          carbon price, to determine the MAC curve and total cost for the
-*          scenario.
+*          scenario. The runs for each point on the curve may be made in
+*          parallel, see runTrials.
 * \author Josh Lurz
 */
 class TotalPolicyCostCalculator {
@@ -108,6 +109,10 @@ private:
     RegionCurves mRegionalCostCurves;
 
     bool runTrials();
+    bool runTrial( const int aPoint );
+#if !defined(_WIN32) && !GCAM_PARALLEL_ENABLED
+    bool runTrialsInChildProcesses( const unsigned int aMaxRunning );
+#endif
     void createCostCurvesByPeriod();
     void createRegionalCostCurves();
     const std::string createXMLOutputString() const;
@@ -43,6 +43,13 @@
 
 #include "util/base/include/definitions.h"
 #include <string>
+#include <cstdio>
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
 #include <xercesc/dom/DOMNode.hpp>
 #include <xercesc/dom/DOMNodeList.hpp>
 #include "containers/include/batch_runner.h"
@@ -51,6 +58,7 @@
 #include "util/base/include/xml_helper.h"
 #include "util/base/include/configuration.h"
 #include "util/logger/include/ilogger.h"
+#include "util/base/include/child_process_pool.h"
 #include "containers/include/scenario.h"
 #include "reporting/include/batch_csv_outputter.h"
 
@@ -61,11 +69,68 @@ extern Scenario* scenario;
 
 typedef list<IScenarioRunner*>::iterator RunnerIterator;
 
+namespace {
+    /*!
+     * \brief Holds an exclusive lock on the batch output lock file for its
+     *        lifetime.
+     * \details Parallel scenarios share the XML database and the batch CSV
+     *          file so their output is written one process at a time. Does
+     *          nothing if the file descriptor is negative which is the case
+     *          when scenarios are run serially.
+     */
+    class OutputLock {
+    public:
+        explicit OutputLock( const int aFD ):mFD( aFD ) {
+            setLock( true );
+        }
+
+        ~OutputLock() {
+            setLock( false );
+        }
+
+        /*!
+         * \brief Check if no other process has written output yet and mark that
+         *        output has now been written.
+         * \details The lock file is empty until the first writer appends a byte
+         *          to it.
+         * \return Whether this is the first writer.
+         */
+        bool claimFirstOutput() {
+#if !defined(_WIN32)
+            struct stat lockStat;
+            if( mFD >= 0 && fstat( mFD, &lockStat ) == 0 && lockStat.st_size == 0 ) {
+                return pwrite( mFD, "1", 1, 0 ) == 1;
+            }
+#endif
+            return false;
+        }
+    private:
+        //! The lock file descriptor.
+        const int mFD;
+
+        void setLock( const bool aIsLocked ) {
+#if !defined(_WIN32)
+            if( mFD < 0 ) {
+                return;
+            }
+            struct flock lock = {};
+            lock.l_type = aIsLocked ? F_WRLCK : F_UNLCK;
+            lock.l_whence = SEEK_SET;
+            lock.l_start = 0;
+            lock.l_len = 0;
+            while( fcntl( mFD, F_SETLKW, &lock ) == -1 && errno == EINTR ) {
+            }
+#endif
+        }
+    };
+}
+
 /*!
  * \brief Constructor
  */
 BatchRunner::BatchRunner() :
-mInternalRunner( 0 ){ 
+mInternalRunner( 0 ),
+mOutputLockFD( -1 ){ 
 }
 
 //! Destructor
@@ -135,8 +200,7 @@ bool BatchRunner::runScenarios( const int aSinglePeriod,
     // All generated scenarios are run with each scenario runner in the order in
     // which the scenario runners were read.
     bool shouldExit = false;
-    bool success = true;
-    BatchCSVOutputter csvOutputter;
+    vector<QueuedScenario> scenarioQueue;
     while( !shouldExit ){
         // The data structure containing the current run.
         Component fileSetsToRun;
@@ -147,15 +211,10 @@ bool BatchRunner::runScenarios( const int aSinglePeriod,
             fileSetsToRun.mName += currSet->mFileSetIterator->mName;
         }
 
-        // Run it using each possible type of IScenarioRunner.
+        // Queue it to run using each possible type of IScenarioRunner.
         for( RunnerIterator runner = mScenarioRunners.begin(); runner != mScenarioRunners.end(); ++runner ){
-            bool scenarioSuccess = runSingleScenario( *runner, fileSetsToRun, aSinglePeriod, aTimer );
-            success &= scenarioSuccess;
-            (*runner)->getInternalScenario()->accept( &csvOutputter, -1 );
-            csvOutputter.writeDidScenarioSolve( scenarioSuccess );
-            // Clean up the current scenario runner before we move on to the next
-            // so that we do not accumulate a large amount of idle memory.
-            (*runner)->cleanup();
+            QueuedScenario queuedScenario = { fileSetsToRun, *runner };
+            scenarioQueue.push_back( queuedScenario );
         }
 
         // Loop forward to find a position to increment.
@@ -175,8 +234,112 @@ bool BatchRunner::runScenarios( const int aSinglePeriod,
             }
         }
     }
+
+    BatchCSVOutputter csvOutputter;
+    const int maxParallel = Configuration::getInstance()->getInt( "max-parallel-scenarios", 1, false );
+    if( maxParallel > 1 && scenarioQueue.size() > 1 ){
+#if !defined(_WIN32)
+        return runQueueInParallel( scenarioQueue, maxParallel, csvOutputter, aSinglePeriod, aTimer );
+#else
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "Parallel scenarios are not supported on this platform, running serially." << endl;
+#endif
+    }
+
+    bool success = true;
+    for( vector<QueuedScenario>::const_iterator queued = scenarioQueue.begin(); queued != scenarioQueue.end(); ++queued ){
+        success &= runQueuedScenario( *queued, csvOutputter, aSinglePeriod, aTimer );
+    }
+    return success;
+}
+
+/*!
+ * \brief Run a queued scenario and write its batch CSV results.
+ * \param aQueuedScenario The scenario to run.
+ * \param aCSVOutputter The batch CSV file to write results to.
+ * \param aSinglePeriod The model period to run.
+ * \param aTimer The timer used to print out the amount of time spent performing
+ *        operations.
+ * \return Whether the model run solved successfully.
+ */
+bool BatchRunner::runQueuedScenario( const QueuedScenario& aQueuedScenario,
+                                     BatchCSVOutputter& aCSVOutputter,
+                                     const int aSinglePeriod,
+                                     Timer& aTimer )
+{
+    IScenarioRunner* runner = aQueuedScenario.mRunner;
+    bool success = runSingleScenario( runner, aQueuedScenario.mComponent, aSinglePeriod, aTimer );
+    {
+        OutputLock lock( mOutputLockFD );
+        if( mOutputLockFD >= 0 ){
+            // Each process has its own copy of the outputter so the header
+            // state must be shared through the lock file.
+            aCSVOutputter.setIsFirstScenario( lock.claimFirstOutput() );
+        }
+        runner->getInternalScenario()->accept( &aCSVOutputter, -1 );
+        aCSVOutputter.writeDidScenarioSolve( success );
+    }
+    // Clean up the current scenario runner before we move on to the next
+    // so that we do not accumulate a large amount of idle memory.
+    runner->cleanup();
+    return success;
+}
+
+#if !defined(_WIN32)
+/*!
+ * \brief Run the queued scenarios with up to the given number running at once.
+ * \details Each scenario is run in a child process forked from this one, which
+ *          has only parsed the configuration and batch file and so has not
+ *          started any solver threads.
+ * \param aQueue The scenarios to run.
+ * \param aMaxWorkers The maximum number of scenarios to run at once.
+ * \param aCSVOutputter The batch CSV file to write results to.
+ * \param aSinglePeriod The model period to run.
+ * \param aTimer The timer used to print out the amount of time spent performing
+ *        operations.
+ * \return Whether all model runs solved successfully.
+ */
+bool BatchRunner::runQueueInParallel( const vector<QueuedScenario>& aQueue,
+                                      const unsigned int aMaxWorkers,
+                                      BatchCSVOutputter& aCSVOutputter,
+                                      const int aSinglePeriod,
+                                      Timer& aTimer )
+{
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    FILE* lockFile = tmpfile();
+    if( !lockFile ){
+        mainLog.setLevel( ILogger::ERROR );
+        mainLog << "Could not create the batch output lock file, running scenarios serially." << endl;
+        bool success = true;
+        for( vector<QueuedScenario>::const_iterator queued = aQueue.begin(); queued != aQueue.end(); ++queued ){
+            success &= runQueuedScenario( *queued, aCSVOutputter, aSinglePeriod, aTimer );
+        }
+        return success;
+    }
+    mOutputLockFD = fileno( lockFile );
+
+    mainLog.setLevel( ILogger::NOTICE );
+    mainLog << "Running " << aQueue.size() << " scenarios with up to "
+            << aMaxWorkers << " at a time." << endl;
+
+    const vector<bool> solved = util::runInChildProcesses( aQueue.size(), aMaxWorkers,
+        [&]( const unsigned int aIndex ) {
+            return runQueuedScenario( aQueue[ aIndex ], aCSVOutputter, aSinglePeriod, aTimer );
+        } );
+
+    bool success = true;
+    for( unsigned int i = 0; i < aQueue.size(); ++i ){
+        if( !solved[ i ] ){
+            mUnsolvedNames.push_back( aQueue[ i ].mComponent.mName );
+            success = false;
+        }
+    }
+
+    mOutputLockFD = -1;
+    fclose( lockFile );
     return success;
 }
+#endif
 
 void BatchRunner::printOutput( Timer& aTimer ) const {
     // Print out any scenarios that did not solve.
@@ -258,8 +421,11 @@ bool BatchRunner::runSingleScenario( IScenarioRunner* aScenarioRunner,
     // Run the scenario.
     success = mInternalRunner->runScenarios( aSinglePeriod, false, aTimer );
     
-    // Print the output.
-    mInternalRunner->printOutput( aTimer );
+    // Print the output. Parallel scenarios take turns writing to the database.
+    {
+        OutputLock lock( mOutputLockFD );
+        mInternalRunner->printOutput( aTimer );
+    }
     
     // If the run failed, add to the list of failed runs. CHECK ME!
     if( !success ){
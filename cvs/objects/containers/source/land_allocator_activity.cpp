@@ -62,3 +62,7 @@ void LandAllocatorActivity::calc( const int aPeriod ) {
 string LandAllocatorActivity::getDescription() const {
     return mRegionName + " land-allocator";
 }
+
+const void* LandAllocatorActivity::getStateOwner() const {
+    return mLandAllocator;
+}
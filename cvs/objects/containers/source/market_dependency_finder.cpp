@@ -49,6 +49,7 @@
 #include "marketplace/include/market.h"
 #include "marketplace/include/linked_market.h"
 #include "containers/include/iactivity.h"
+#include "util/base/include/configuration.h"
 
 #if GCAM_PARALLEL_ENABLED
 #include "parallel/include/gcam_parallel.hpp"
@@ -63,7 +64,9 @@ using namespace std;
 MarketDependencyFinder::MarketDependencyFinder( Marketplace* aMarketplace ):
 mMarketplace( aMarketplace ), mCalcVertexUIDCount( 0 )
 #if GCAM_PARALLEL_ENABLED
-,mTBBGraphGlobal( 0 )
+,mTBBGraphGlobal( 0 ),
+mGCAMFlowGraph( 0 ),
+mMaxCachedFlowGraphs( Configuration::getInstance()->getInt( "max-cached-flow-graphs", 100 ) )
 #endif
 {
 }
@@ -79,6 +82,7 @@ MarketDependencyFinder::~MarketDependencyFinder() {
     }
 #if GCAM_PARALLEL_ENABLED
     delete mTBBGraphGlobal;
+    delete mGCAMFlowGraph;
     for( CMarketToDepIterator it = mMarketsToDep.begin(); it != mMarketsToDep.end(); ++it ) {
         delete (*it)->mFlowGraph;
     }
@@ -259,83 +263,121 @@ const vector<IActivity*> MarketDependencyFinder::getOrdering( const int aMarketN
 
 #if GCAM_PARALLEL_ENABLED
 /*!
- * \brief Get flow graph which can be used to calculate the model in parallel.
- * \details If called with a market number of -1 (the default value) then the global
- *          graph which will calculate all objects in the model is returned.
- *          When a valid market number is given the flow graph of activities which
- *          would be affected by that market changing it's price would be generated
- *          and returned.
- * \param aMarketNumber The market number to get a flow graph of items which
- *                      are required to be calculated if that market changes prices,
- *                      or if -1 the full global list.
- * \return The appropriate list of activities to calculate for the given market.
+ * \brief Generate the dependency graph of all activities which is the starting
+ *        point for creating any flow graph.
+ */
+void MarketDependencyFinder::createGCAMFlowGraph() {
+    GcamParallel config;
+    mGCAMFlowGraph = new GcamParallel::FlowGraph();
+    // convert dependency table to flow graph
+    config.makeGCAMFlowGraph( *this, *mGCAMFlowGraph );
+    if( !mGCAMFlowGraph->topology_valid() ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::ERROR );
+        mainLog << "Topological indices not computed." << endl;
+        abort();
+    }
+}
+
+/*!
+ * \brief Get flow graph which can be used to calculate the full model in parallel.
+ * \return The flow graph which will calculate all objects in the model.
  *         Note the caller is not responsible for the returned memory.
  */
-GcamFlowGraph* MarketDependencyFinder::getFlowGraph( const int aMarketNumber ) {
-    if( aMarketNumber == -1 ) {
-        if( !mTBBGraphGlobal ) {
-            // reads parameters from the global configuration
-            GcamParallel config;
-            GcamParallel::FlowGraph gcamFlowGraph;
-            GcamParallel::FlowGraph grainGraph;
-
-            // convert dependency table to flow graph 
-            config.makeGCAMFlowGraph( *this, gcamFlowGraph );
-            // parse flow graph
-            config.graphParseGrainCollect( gcamFlowGraph, grainGraph ); 
-            if( !gcamFlowGraph.topology_valid() ) {
-                ILogger& mainLog = ILogger::getLogger( "main_log" );
-                mainLog.setLevel( ILogger::ERROR );
-                mainLog << "Topological indices not computed." << endl;
-                abort();
-            }
-            // build the tbb graph structure
-            mTBBGraphGlobal = new GcamFlowGraph();
-            config.makeTBBFlowGraph( grainGraph, gcamFlowGraph, *mTBBGraphGlobal ); 
+GcamFlowGraph* MarketDependencyFinder::getFlowGraph() {
+    if( !mTBBGraphGlobal ) {
+        if( !mGCAMFlowGraph ) {
+            createGCAMFlowGraph();
         }
-        return mTBBGraphGlobal;
+        // reads parameters from the global configuration
+        GcamParallel config;
+        GcamParallel::FlowGraph grainGraph;
+
+        // parse flow graph
+        config.graphParseGrainCollect( *mGCAMFlowGraph, grainGraph );
+        // build the tbb graph structure
+        mTBBGraphGlobal = new GcamFlowGraph();
+        config.makeTBBFlowGraph( grainGraph, *mGCAMFlowGraph, *mTBBGraphGlobal );
     }
-    else {
-        // Find the entry points into the graph for the given market.
-        auto_ptr<MarketToDependencyItem> marketToDep( new MarketToDependencyItem( aMarketNumber ) );
-        CMarketToDepIterator mrktIter = mMarketsToDep.find( marketToDep.get() );
-        if( mrktIter == mMarketsToDep.end() ) {
-            // Somehow this market was not linked to any entry points into the graph.
-            ILogger& mainLog = ILogger::getLogger( "main_log" );
-            mainLog.setLevel( ILogger::ERROR );
-            mainLog << "Could not find market: " << mMarketplace->mMarkets[ aMarketNumber ]->getName()
-                    << " to get an ordering for." << endl;
-            exit( 1 );
-        }
+    return mTBBGraphGlobal;
+}
 
-        // First check the MarketToDependencyItem and see if we have this cached.
-        if( (*mrktIter)->mFlowGraph ) {
-            return (*mrktIter)->mFlowGraph;
-        }
+/*!
+ * \brief Get a flow graph of the activities which would be affected by the given
+ *        market changing it's price.
+ * \details The graph is generated the first time it is needed and then cached.
+ *          Only up to max-cached-flow-graphs are kept, releasing the least recently
+ *          acquired, so the graph stays valid only until the matching call to
+ *          releaseFlowGraph.  This method is safe to call from multiple threads
+ *          however the same graph should not be run by more than one at a time.
+ * \param aMarketNumber The market number to get a flow graph of items which
+ *                      are required to be calculated if that market changes prices.
+ * \return The flow graph of activities to calculate for the given market.
+ *         Note the caller is not responsible for the returned memory.
+ */
+GcamFlowGraph* MarketDependencyFinder::acquireFlowGraph( const int aMarketNumber ) {
+    // Find the entry points into the graph for the given market.
+    auto_ptr<MarketToDependencyItem> marketToDep( new MarketToDependencyItem( aMarketNumber ) );
+    CMarketToDepIterator mrktIter = mMarketsToDep.find( marketToDep.get() );
+    if( mrktIter == mMarketsToDep.end() ) {
+        // Somehow this market was not linked to any entry points into the graph.
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::ERROR );
+        mainLog << "Could not find market: " << mMarketplace->mMarkets[ aMarketNumber ]->getName()
+                << " to get an ordering for." << endl;
+        exit( 1 );
+    }
+    MarketToDependencyItem* marketItem = *mrktIter;
 
+    lock_guard<mutex> lock( mFlowGraphMutex );
+    if( marketItem->mFlowGraph ) {
+        // We have this cached, just mark it as the most recently used.
+        mFlowGraphLRU.remove( marketItem );
+    }
+    else {
         // We must generate the flow graph following the same procedure as the global graph.
-        // It may be a good idea to make some of these tempararies members to avoid recalculating
-        // them over and over.
+        if( !mGCAMFlowGraph ) {
+            createGCAMFlowGraph();
+        }
         GcamParallel config;
-        GcamParallel::FlowGraph gcamFlowGraph;
         GcamParallel::FlowGraph grainGraph;
         
-        // convert dependency table to flow graph
-        config.makeGCAMFlowGraph( *this, gcamFlowGraph );
         // Parse flow graph subsetting for only the activities effected.  Use getOrdering
         // to get this list incase it has not yet been calculated.
-        config.graphParseGrainCollect( gcamFlowGraph, grainGraph, getOrdering( aMarketNumber ) );
-        if( !gcamFlowGraph.topology_valid() ) {
-            ILogger& mainLog = ILogger::getLogger( "main_log" );
-            mainLog.setLevel( ILogger::ERROR );
-            mainLog << "Topological indices not computed." << endl;
-            abort();
-        }
+        config.graphParseGrainCollect( *mGCAMFlowGraph, grainGraph, getOrdering( aMarketNumber ) );
         // build the tbb graph structure
-        (*mrktIter)->mFlowGraph = new GcamFlowGraph();
-        config.makeTBBFlowGraph( grainGraph, gcamFlowGraph, *(*mrktIter)->mFlowGraph );
-        return (*mrktIter)->mFlowGraph;
+        marketItem->mFlowGraph = new GcamFlowGraph();
+        config.makeTBBFlowGraph( grainGraph, *mGCAMFlowGraph, *marketItem->mFlowGraph );
     }
+    mFlowGraphLRU.push_front( marketItem );
+    ++marketItem->mFlowGraphUsers;
+    
+    // Release the least recently used graphs which are not in use until we are
+    // back under the limit.
+    list<MarketToDependencyItem*>::iterator lruIter = mFlowGraphLRU.end();
+    while( mFlowGraphLRU.size() > mMaxCachedFlowGraphs && lruIter != mFlowGraphLRU.begin() ) {
+        --lruIter;
+        if( (*lruIter)->mFlowGraphUsers == 0 ) {
+            delete (*lruIter)->mFlowGraph;
+            (*lruIter)->mFlowGraph = 0;
+            lruIter = mFlowGraphLRU.erase( lruIter );
+        }
+    }
+    return marketItem->mFlowGraph;
+}
+
+/*!
+ * \brief Indicate the caller is done with a flow graph from acquireFlowGraph.
+ * \param aMarketNumber The market number the flow graph was acquired for.
+ */
+void MarketDependencyFinder::releaseFlowGraph( const int aMarketNumber ) {
+    auto_ptr<MarketToDependencyItem> marketToDep( new MarketToDependencyItem( aMarketNumber ) );
+    CMarketToDepIterator mrktIter = mMarketsToDep.find( marketToDep.get() );
+    assert( mrktIter != mMarketsToDep.end() );
+    
+    lock_guard<mutex> lock( mFlowGraphMutex );
+    assert( (*mrktIter)->mFlowGraphUsers > 0 );
+    --(*mrktIter)->mFlowGraphUsers;
 }
 #endif
 
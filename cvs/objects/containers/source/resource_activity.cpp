@@ -75,3 +75,7 @@ void ResourceActivity::calc( const int aPeriod ) {
 string ResourceActivity::getDescription() const {
     return mRegionName + " " + mResource->getName();
 }
+
+const void* ResourceActivity::getStateOwner() const {
+    return mResource;
+}
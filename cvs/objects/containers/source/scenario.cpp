@@ -58,6 +58,7 @@
 #include "solution/solvers/include/solver.h"
 #include "util/base/include/auto_file.h"
 #include "util/base/include/timer.h"
+#include "util/base/include/trace_recorder.h"
 #include "reporting/include/graph_printer.h"
 #include "reporting/include/land_allocator_printer.h"
 #include "solution/solvers/include/solver_factory.h"
@@ -260,6 +261,12 @@ void Scenario::completeInit() {
         mainLog << "No world container was parsed from the input files." << endl;
     }
 
+    // The model structure may have changed so any state collected for a previous
+    // run is no longer valid.
+    if( mManageStateVars ) {
+        mManageStateVars->clearCollectedState();
+    }
+
     // Set the valid period vector to false.
     mIsValidPeriod.clear();
     mIsValidPeriod.resize( mModeltime->getmaxper(), false );
@@ -271,6 +278,11 @@ const string& Scenario::getName() const {
 }
 
 /*! \brief Run the scenario.
+* \details If the configuration string trace-file is set a Chrome trace of the
+*          periods, solvers, World::calc grains and activities is recorded and
+*          written to that file, keeping at most trace-max-events individual events.
+*          If the file solved-prices is enabled the solved prices are written for
+*          use as the reference-prices of another run.
 * \param aSinglePeriod Single period to run or RUN_ALL_PERIODS if all periods
 *        should be run.
 * \param aPrintDebugging Whether to print extra debugging files.
@@ -299,6 +311,13 @@ bool Scenario::run( const int aSinglePeriod,
     Timer& fullScenarioTimer = TimerRegistry::getInstance().getTimer( TimerRegistry::FULLSCENARIO );
     fullScenarioTimer.start();
     
+    // Record nested timings of the periods, solvers and activities if a trace
+    // file was requested.
+    const Configuration* conf = Configuration::getInstance();
+    const string traceFileName = conf->getString( "trace-file", "", false );
+    TraceRecorder::getInstance().setEnabled( !traceFileName.empty(),
+                                             conf->getInt( "trace-max-events", 1000000, false ) );
+    
     // Log that a run is beginning.
     logRunBeginning();
 
@@ -357,6 +376,18 @@ bool Scenario::run( const int aSinglePeriod,
     mainLog.setLevel( ILogger::DEBUG );
     fullScenarioTimer.stop();
     TimerRegistry::getInstance().printAllTimers( mainLog );
+    if( !traceFileName.empty() ) {
+        ofstream traceFile( traceFileName.c_str() );
+        TraceRecorder::getInstance().writeChromeTrace( traceFile );
+        mainLog << "Wrote calculation trace to " << traceFileName << endl;
+    }
+
+    // Save the solved prices so that they may be used to warm start another scenario.
+    AutoOutputFile solvedPricesFile( "solved-prices", "solved-prices.csv",
+                                     conf->shouldWriteFile( "solved-prices", false, false ) );
+    if( solvedPricesFile.shouldWrite() ) {
+        mMarketplace->writeSolvedPrices( *solvedPricesFile, mIsValidPeriod );
+    }
 
     // Run the climate model.
     mWorld->runClimateModel();
@@ -385,6 +416,8 @@ bool Scenario::calculatePeriod( const int aPeriod,
                                 bool aPrintDebugging )
 {
     logPeriodBeginning( aPeriod );
+    TraceScope periodScope( "scenario", TraceRecorder::isEnabled() ?
+                            "period " + util::toString( mModeltime->getper_to_yr( aPeriod ) ) : string() );
 
     // If this is period 0 initialize market price.
     if( aPeriod == 0 ){
@@ -404,8 +437,10 @@ bool Scenario::calculatePeriod( const int aPeriod,
     }
     
     // Set up the state data for the current period.
-    delete mManageStateVars;
-    mManageStateVars = new ManageStateVariables( aPeriod );
+    if( !mManageStateVars ) {
+        mManageStateVars = new ManageStateVariables();
+    }
+    mManageStateVars->setPeriod( aPeriod );
     
     // Be sure to clear out any supplies and demands in the marketplace before making our
     // initial call to world.calc.  There may already be values in there if for instance
@@ -471,6 +506,10 @@ bool Scenario::calculatePeriod( const int aPeriod,
     
     
     bool success = solve( aPeriod ); // solution uses Bisect and NR routine to clear markets
+    if( success ) {
+        // Keep the solved prices to warm start the next time this period is solved.
+        mMarketplace->storeSolution( aPeriod );
+    }
 
     mWorld->postCalc( aPeriod );
         
@@ -501,8 +540,7 @@ bool Scenario::calculatePeriod( const int aPeriod,
         writeDebuggingFiles( aXMLDebugFile, aTabs, aPeriod );
     }
 
-    delete mManageStateVars;
-    mManageStateVars = 0;
+    mManageStateVars->releasePeriod();
     
     return success;
 }
@@ -629,11 +667,18 @@ void Scenario::printLandAllocatorGraph( const int aPeriod, const bool aPrintValu
 }
 
 /*! \brief Set a tax into all regions.
-* \details TODO
+* \details If the tax creates a new market the state collected for previous
+*          runs is discarded as it would not include the new market.
 * \param aTax Tax to set.
 */
 void Scenario::setTax( const GHGPolicy* aTax ){
+    const int numMarkets = mMarketplace->getNumMarkets();
     mWorld->setTax( aTax );
+    
+    // A new tax market holds state which was not collected in previous runs.
+    if( mManageStateVars && mMarketplace->getNumMarkets() != numMarkets ) {
+        mManageStateVars->clearCollectedState();
+    }
 }
 
 /*! \brief Get the climate model.
@@ -773,6 +818,22 @@ void Scenario::invalidatePeriod( const int aPeriod ) {
     mIsValidPeriod[ aPeriod ] = false;
 }
 
+/*!
+ * \brief Whether any of the solvers start from information kept from earlier
+ *        runs of this scenario.
+ * \details If so the result of a run may depend on the runs which came before
+ *          it in this process.
+ * \return True if any solver reuses prior solutions.
+ */
+bool Scenario::solversReusePriorSolutions() const {
+    for( vector<boost::shared_ptr<Solver> >::const_iterator solverIt = mSolvers.begin(); solverIt != mSolvers.end(); ++solverIt ) {
+        if( (*solverIt).get() && (*solverIt)->reusesPriorSolutions() ) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /*!
  * \brief Get a reference to the object responsible for managing state.
  * \return The ManageStateVariables object.
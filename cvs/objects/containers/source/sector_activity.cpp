@@ -108,6 +108,14 @@ string SectorActivity::getDescription() const {
     return mRegionName + " " + mSector->getName();
 }
 
+/*!
+ * \brief Get the sector which is calculated by both the price and demand activities.
+ * \return The wrapped sector.
+ */
+const void* SectorActivity::getStateOwner() const {
+    return mSector;
+}
+
 /*!
  * \brief Get the activity that will calculate the prices of this sector.
  * \return The associated price activity.
@@ -148,6 +156,10 @@ string SectorPriceActivity::getDescription() const {
     return mSectorActivity->getDescription() + " Price";
 }
 
+const void* SectorPriceActivity::getStateOwner() const {
+    return mSectorActivity->getStateOwner();
+}
+
 /*!
  * \brief Constructor linking back to the sector activity which will do the work.
  * \param aSectorActivity The shared sector activity.
@@ -171,3 +183,7 @@ void SectorDemandActivity::calc( const int aPeriod ) {
 string SectorDemandActivity::getDescription() const {
     return mSectorActivity->getDescription() + " Demand";
 }
+
+const void* SectorDemandActivity::getStateOwner() const {
+    return mSectorActivity->getStateOwner();
+}
@@ -51,6 +51,7 @@
 #include "util/logger/include/ilogger.h"
 #include "util/logger/include/logger_factory.h"
 #include "reporting/include/xml_db_outputter.h"
+#include "reporting/include/columnar_outputter.h"
 
 using namespace std;
 using namespace xercesc;
@@ -227,6 +228,16 @@ void SingleScenarioRunner::printOutput( Timer& aTimer ) const {
         // Print the output.
         mXMLDBOutputter->finish();
     }
+
+    // The columnar output does not require Java so may be written with or
+    // without the XML database.
+    if( ColumnarOutputter::isEnabled() ) {
+        mainLog.setLevel( ILogger::NOTICE );
+        mainLog << "Starting columnar output." << endl;
+        ColumnarOutputter columnarOutputter;
+        mScenario->accept( &columnarOutputter, -1 );
+        columnarOutputter.finish();
+    }
     writeTimer.stop();
     
     // Print the timestamps.
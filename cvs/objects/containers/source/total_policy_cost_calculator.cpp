@@ -40,6 +40,7 @@
 
 #include "util/base/include/definitions.h"
 #include <cassert>
+#include <cstdio>
 #include <vector>
 #include <string>
 #include "containers/include/scenario.h"
@@ -55,6 +56,7 @@
 #include "util/base/include/xml_helper.h"
 #include "util/curves/include/explicit_point_set.h"
 #include "util/base/include/auto_file.h"
+#include "util/base/include/child_process_pool.h"
 #include "util/logger/include/ilogger.h"
 #include "containers/include/total_policy_cost_calculator.h"
 #include "containers/include/single_scenario_runner.h"
@@ -147,19 +149,22 @@ bool TotalPolicyCostCalculator::calculateAbatementCostCurve() {
 }
 
 /*! \brief Run a trial for each point and store the abatement curves.
-* \details First calculates a fraction of the total carbon tax to use, based 
-* on the trial number and the total number of points, so that the data points are equally
-* distributed from 0 to the full carbon tax for each period. It then calculates and 
-* sets the fixed tax for each year. The scenario is then run, and the emissions and 
-* tax curves are stored for each region.
+* \details Runs a trial for each point from the highest tax to the lowest,
+*          restoring the prices solved in the policy scenario after each one.
+*          If the integer configuration value "max-parallel-cost-points" is
+*          greater than one all points other than the last are instead run in
+*          forked child processes, up to that many at once, since each trial
+*          depends only on the policy scenario. The last point is always run in
+*          this process so that it is left in the same state as when running
+*          serially. Points can not be run in parallel when a restart period is
+*          used as then each trial starts from the prices of the one before,
+*          when a solver reuses information such as the Jacobian from the
+*          previous trial or prices are forecast from the previous trial, nor in GCAM_PARALLEL_ENABLED builds as a process can not be forked
+*          once it has started the solver threads.
 * \return Whether all model runs completed successfully.
 * \author Josh Lurz
 */
 bool TotalPolicyCostCalculator::runTrials(){
-    // Get the number of max periods.
-    const Modeltime* modeltime = mSingleScenario->getInternalScenario()->getModeltime();
-    const int maxPeriod = modeltime->getmaxper();
-
     bool success = true;
     const static bool usingRestartPeriod = Configuration::getInstance()->getInt(
         "restart-period", -1 ) != -1;
@@ -167,42 +172,41 @@ bool TotalPolicyCostCalculator::runTrials(){
     if( !usingRestartPeriod ) {
         mSingleScenario->getInternalScenario()->getMarketplace()->store_prices_for_cost_calculation();
     }
-    // Loop through for each point.
-    for( int currPoint = mNumPoints - 1; currPoint >= 0; currPoint-- ){
-        // Determine the fraction of the full tax this tax will be.
-        const double fraction = static_cast<double>( currPoint ) / static_cast<double>( mNumPoints );
-        // Iterate through the regions to set different taxes for each if necessary.
-        // Currently this will set the same for all of them.
-        for( CRegionCurvesIterator rIter = mEmissionsTCurves[ mNumPoints ].begin(); rIter != mEmissionsTCurves[ mNumPoints ].end(); ++rIter ){
-            // Vector which will contain taxes for this trial.
-            vector<double> currTaxes( maxPeriod );
-
-            // Set the tax for each year. 
-            for( int per = 0; per < maxPeriod; per++ ){
-                const int year = modeltime->getper_to_yr( per );
-                double origTax = rIter->second->getY( year );
-                currTaxes[ per ] = origTax == Marketplace::NO_MARKET_PRICE ? Marketplace::NO_MARKET_PRICE :
-                    origTax * fraction;
-            }
-            // Set the fixed taxes into the world.
-            GHGPolicy tax( mGHGName, rIter->first, currTaxes );
-            mSingleScenario->getInternalScenario()->setTax( &tax );
-        }
 
-        // Create an ending for the output files using the run number.
-        ILogger& mainLog = ILogger::getLogger( "main_log" );
-        mainLog.setLevel( ILogger::NOTICE );
-        mainLog << "Starting cost curve point run number " << currPoint << "." << endl;
-
-        // Run the scenario with the add-on extension to the output file names
-        // as the point number. This allows the output file to be named debug +
-        // point number.
-        success &= mSingleScenario->getInternalScenario()->run( Scenario::RUN_ALL_PERIODS, true,
-                                                                util::toString( currPoint ) );
+    int firstSerialPoint = mNumPoints - 1;
+    const int maxParallel = Configuration::getInstance()->getInt( "max-parallel-cost-points", 1, false );
+    if( maxParallel > 1 && mNumPoints > 1 ) {
+        // Child processes only see the policy scenario so the points can only
+        // be run in parallel if no trial starts from the results of the one
+        // before it.
+        string serialReason;
+        if( usingRestartPeriod ) {
+            serialReason = "restart-period is set";
+        }
+        else if( mSingleScenario->getInternalScenario()->solversReusePriorSolutions() ) {
+            serialReason = "a solver reuses information from the previous trial";
+        }
+        else if( mSingleScenario->getInternalScenario()->getMarketplace()->forecastsFromPriorTrials() ) {
+            serialReason = "price-forecast includes prior-trial";
+        }
+#if !defined(_WIN32) && !GCAM_PARALLEL_ENABLED
+        if( serialReason.empty() ) {
+            success &= runTrialsInChildProcesses( maxParallel );
+            firstSerialPoint = 0;
+        }
+#else
+        serialReason = "this build can not fork processes";
+#endif
+        if( firstSerialPoint != 0 ) {
+            ILogger& mainLog = ILogger::getLogger( "main_log" );
+            mainLog.setLevel( ILogger::WARNING );
+            mainLog << "Cost curve points can not be run in parallel as " << serialReason << ", running serially." << endl;
+        }
+    }
 
-        // Save information.
-        mEmissionsQCurves[ currPoint ] = mSingleScenario->getInternalScenario()->getEmissionsQuantityCurves( mGHGName );
-        mEmissionsTCurves[ currPoint ] = mSingleScenario->getInternalScenario()->getEmissionsPriceCurves( mGHGName );
+    // Loop through for each point.
+    for( int currPoint = firstSerialPoint; currPoint >= 0; currPoint-- ){
+        success &= runTrial( currPoint );
 
         // Restore original solved market prices after each cost iteration to ensure same
         // starting prices for each iteration.  This is necessary due to changing initial prices.
@@ -213,6 +217,141 @@ bool TotalPolicyCostCalculator::runTrials(){
     return success;
 }
 
+/*! \brief Run the trial for a single point and store its abatement curves.
+* \details First calculates a fraction of the total carbon tax to use, based 
+* on the trial number and the total number of points, so that the data points are equally
+* distributed from 0 to the full carbon tax for each period. It then calculates and 
+* sets the fixed tax for each year. The scenario is then run, and the emissions and 
+* tax curves are stored for each region.
+* \param aPoint The point on the cost curve to run.
+* \return Whether the model run completed successfully.
+*/
+bool TotalPolicyCostCalculator::runTrial( const int aPoint ){
+    // Get the number of max periods.
+    const Modeltime* modeltime = mSingleScenario->getInternalScenario()->getModeltime();
+    const int maxPeriod = modeltime->getmaxper();
+
+    // Determine the fraction of the full tax this tax will be.
+    const double fraction = static_cast<double>( aPoint ) / static_cast<double>( mNumPoints );
+    // Iterate through the regions to set different taxes for each if necessary.
+    // Currently this will set the same for all of them.
+    for( CRegionCurvesIterator rIter = mEmissionsTCurves[ mNumPoints ].begin(); rIter != mEmissionsTCurves[ mNumPoints ].end(); ++rIter ){
+        // Vector which will contain taxes for this trial.
+        vector<double> currTaxes( maxPeriod );
+
+        // Set the tax for each year. 
+        for( int per = 0; per < maxPeriod; per++ ){
+            const int year = modeltime->getper_to_yr( per );
+            double origTax = rIter->second->getY( year );
+            currTaxes[ per ] = origTax == Marketplace::NO_MARKET_PRICE ? Marketplace::NO_MARKET_PRICE :
+                origTax * fraction;
+        }
+        // Set the fixed taxes into the world.
+        GHGPolicy tax( mGHGName, rIter->first, currTaxes );
+        mSingleScenario->getInternalScenario()->setTax( &tax );
+    }
+
+    // Create an ending for the output files using the run number.
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    mainLog.setLevel( ILogger::NOTICE );
+    mainLog << "Starting cost curve point run number " << aPoint << "." << endl;
+
+    // Run the scenario with the add-on extension to the output file names
+    // as the point number. This allows the output file to be named debug +
+    // point number.
+    const bool success = mSingleScenario->getInternalScenario()->run( Scenario::RUN_ALL_PERIODS, true,
+                                                                      util::toString( aPoint ) );
+
+    // Save information.
+    mEmissionsQCurves[ aPoint ] = mSingleScenario->getInternalScenario()->getEmissionsQuantityCurves( mGHGName );
+    mEmissionsTCurves[ aPoint ] = mSingleScenario->getInternalScenario()->getEmissionsPriceCurves( mGHGName );
+    return success;
+}
+
+#if !defined(_WIN32) && !GCAM_PARALLEL_ENABLED
+/*! \brief Run the trials for all points but the last in forked child processes.
+* \details Each child runs a single trial starting from the policy scenario and
+*          writes the emissions quantity and price for each region and period
+*          to a temporary file. The curves for the point are then rebuilt from
+*          copies of the policy scenario curves, which have the same regions
+*          and years, so they are identical to those from a serial run. Any
+*          point whose results could not be read back is run in this process.
+* \param aMaxRunning The maximum number of trials to run at once.
+* \return Whether all model runs completed successfully.
+*/
+bool TotalPolicyCostCalculator::runTrialsInChildProcesses( const unsigned int aMaxRunning ){
+    const Modeltime* modeltime = mSingleScenario->getInternalScenario()->getModeltime();
+    const int maxPeriod = modeltime->getmaxper();
+    const RegionCurves& policyQCurves = mEmissionsQCurves[ mNumPoints ];
+    const RegionCurves& policyTCurves = mEmissionsTCurves[ mNumPoints ];
+    const size_t numValues = 2 * policyQCurves.size() * maxPeriod;
+
+    // Child i runs point mNumPoints - 1 - i so that points are started in the
+    // same order as a serial run.
+    const unsigned int numChildPoints = mNumPoints - 1;
+    vector<FILE*> resultFiles( numChildPoints );
+    for( unsigned int i = 0; i < numChildPoints; ++i ){
+        resultFiles[ i ] = tmpfile();
+    }
+
+    const vector<bool> childSuccess = util::runInChildProcesses( numChildPoints, aMaxRunning,
+        [&]( const unsigned int aIndex ) {
+            const int point = mNumPoints - 1 - aIndex;
+            const bool success = runTrial( point );
+            vector<double> values;
+            values.reserve( numValues );
+            for( CRegionCurvesIterator rIter = policyQCurves.begin(); rIter != policyQCurves.end(); ++rIter ){
+                for( int per = 0; per < maxPeriod; ++per ){
+                    values.push_back( mEmissionsQCurves[ point ][ rIter->first ]->getY( modeltime->getper_to_yr( per ) ) );
+                }
+                for( int per = 0; per < maxPeriod; ++per ){
+                    values.push_back( mEmissionsTCurves[ point ][ rIter->first ]->getY( modeltime->getper_to_yr( per ) ) );
+                }
+            }
+            FILE* results = resultFiles[ aIndex ];
+            return results && fwrite( &values[ 0 ], sizeof( double ), values.size(), results ) == values.size()
+                && fflush( results ) == 0 && success;
+        } );
+
+    bool success = true;
+    for( unsigned int i = 0; i < numChildPoints; ++i ){
+        const int point = mNumPoints - 1 - i;
+        vector<double> values( numValues );
+        FILE* results = resultFiles[ i ];
+        if( !results || fseek( results, 0, SEEK_SET ) != 0
+            || fread( &values[ 0 ], sizeof( double ), values.size(), results ) != values.size() )
+        {
+            ILogger& mainLog = ILogger::getLogger( "main_log" );
+            mainLog.setLevel( ILogger::WARNING );
+            mainLog << "No results for cost curve point " << point << ", running it again." << endl;
+            success &= runTrial( point );
+            mSingleScenario->getInternalScenario()->getMarketplace()->restore_prices_for_cost_calculation();
+        }
+        else {
+            vector<double>::const_iterator value = values.begin();
+            for( CRegionCurvesIterator rIter = policyQCurves.begin(); rIter != policyQCurves.end(); ++rIter ){
+                Curve* qCurve = rIter->second->clone();
+                for( int per = 0; per < maxPeriod; ++per ){
+                    qCurve->setY( modeltime->getper_to_yr( per ), *value++ );
+                }
+                mEmissionsQCurves[ point ][ rIter->first ] = qCurve;
+
+                Curve* tCurve = policyTCurves.find( rIter->first )->second->clone();
+                for( int per = 0; per < maxPeriod; ++per ){
+                    tCurve->setY( modeltime->getper_to_yr( per ), *value++ );
+                }
+                mEmissionsTCurves[ point ][ rIter->first ] = tCurve;
+            }
+            success &= childSuccess[ i ];
+        }
+        if( results ){
+            fclose( results );
+        }
+    }
+    return success;
+}
+#endif
+
 /*! \brief Create a cost curve for each period and region.
 * \details Using the cost curves generated by the trials, generate and stored a set of cost
 * curves by period and region.
@@ -40,6 +40,7 @@
 
 #include "util/base/include/definitions.h"
 #include "util/base/include/timer.h"
+#include "util/base/include/trace_recorder.h"
 
 #include <string>
 #include <cassert>
@@ -80,6 +81,7 @@
 
 #if GCAM_PARALLEL_ENABLED
 #include "parallel/include/gcam_parallel.hpp"
+#include "util/base/include/manage_state_variables.hpp"
 #endif
 
 // Uncommenting the following two lines will turn on floating-point exceptions within World::calc(),
@@ -310,6 +312,7 @@ void World::calc( const int aPeriod, const std::vector<IActivity*>& aItemsToCalc
      *              total number of items globally inclusive. 
      */
     assert( aItemsToCalc.size() <= mGlobalOrdering.size() );
+    TraceScope calcScope( "world", "World::calc" );
 
 #ifdef GNU_SOURCE
     int except = feenableexcept(FE_DIVBYZERO | FE_INVALID);
@@ -317,9 +320,14 @@ void World::calc( const int aPeriod, const std::vector<IActivity*>& aItemsToCalc
     
     // Increment the world.calc count based on the number of items to solve. 
     mCalcCounter->incrementCount( static_cast<double>( aItemsToCalc.size() ) / static_cast<double>( mGlobalOrdering.size() ) );
+    const bool isTracing = TraceRecorder::isEnabled();
+    if( isTracing ) {
+        TraceRecorder::getInstance().recordCounter( "World::calc count", mCalcCounter->getTotalCount() );
+    }
     
     // Perform calculation on each item to calculate. 
     for( vector<IActivity*>::const_iterator it = aItemsToCalc.begin(); it != aItemsToCalc.end(); ++it ) {
+        TraceScope activityScope( "activity", isTracing ? (*it)->getDescription() : string() );
         (*it)->calc( aPeriod );
     }
 #ifdef GNU_SOURCE
@@ -342,12 +350,16 @@ void World::calc( const int aPeriod, const std::vector<IActivity*>& aItemsToCalc
  */
 void World::calc( const int aPeriod, GcamFlowGraph *aWorkGraph, const vector<IActivity*>* aCalcList )
 {
+    TraceScope calcScope( "world", "World::calc" );
 #ifdef GNU_SOURCE
     int except = feenableexcept(FE_DIVBYZERO | FE_INVALID);
 #endif
 
     // increment the evaulation count by the fraction of the whole model that we're solving
     mCalcCounter->incrementCount( aCalcList ? (double)(aCalcList->size()) / (double) mGlobalOrdering.size() : 1.0 );
+    if( TraceRecorder::isEnabled() ) {
+        TraceRecorder::getInstance().recordCounter( "World::calc count", mCalcCounter->getTotalCount() );
+    }
 
     if( !aWorkGraph ) {
         // If a work graph was not provided just use the global flow graph and set the
@@ -362,6 +374,7 @@ void World::calc( const int aPeriod, GcamFlowGraph *aWorkGraph, const vector<IAc
         aWorkGraph->mCalcList = 0;
     }
     aWorkGraph->mPeriod = aPeriod;
+    aWorkGraph->mStateData = ManageStateVariables::getThreadState();
     // do the model calculation
     aWorkGraph->mHead.try_put( tbb::flow::continue_msg() );
     aWorkGraph->mTBBFlowGraph.wait_for_all();
@@ -56,6 +56,7 @@
 #include "util/base/include/iparsable.h"
 #include "util/base/include/ivisitable.h"
 #include "util/base/include/value.h"
+#include "marketplace/include/cached_market.h"
 #include "util/base/include/time_vector.h"
 #include "util/base/include/data_definition_util.h"
 
@@ -67,7 +68,6 @@ class AEmissionsDriver;
 class AEmissionsControl;
 class ICaptureComponent;
 class IInput;
-class CachedMarket;
 
 // Need to forward declare the subclasses as well.
 class CO2Emissions;
@@ -213,7 +213,7 @@ protected:
     
     //! Pre-located market which has been cached from the marketplace to get the price
     //! of this ghg and add demands to the market.
-    std::auto_ptr<CachedMarket> mCachedMarket;
+    CachedMarket mCachedMarket;
 
     /*!
      * \brief Parses any child nodes specific to derived classes
@@ -48,6 +48,8 @@
 
 #include "emissions/include/aemissions_control.h"
 #include "util/base/include/time_vector.h"
+#include "marketplace/include/cached_market.h"
+#include "util/curves/include/piecewise_linear_table.h"
 
 class PointSetCurve;
 
@@ -112,6 +114,13 @@ protected:
     // DEFINE_VARIABLE( ARRAY, "tech-change", mTechChange, std::shared_ptr<objects::PeriodVector<double> > ),
     std::shared_ptr<objects::PeriodVector<double> > mTechChange;
 
+    //! A pre-located market which has been cached from the marketplace for the
+    //! price used to look up the curve.
+    CachedMarket mCachedPriceMarket;
+    
+    //! A copy of mMacCurve which is quick to evaluate during calc, set in completeInit.
+    PiecewiseLinearTable mMacTable;
+
 private:
     void copy( const MACControl& other );
     double getMACValue( const double aCarbonPrice ) const;
@@ -172,7 +172,7 @@ void AGHG::initCalc( const string& aRegionName, const IInfo* aLocalInfo, const i
  */
 void AGHG::addEmissionsToMarket( const string& aRegionName, const int aPeriod ){
     // set emissions as demand side of gas market
-    mCachedMarket->addToDemand( getName(), aRegionName,
+    mCachedMarket.addToDemand( getName(), aRegionName,
                                 mEmissions[ aPeriod ],
                                 aPeriod, false );
 }
@@ -196,7 +196,7 @@ double AGHG::getGHGValue( const IInput* aInput, const string& aRegionName,
                           const int aPeriod ) const
 {
     // Determine if there is a tax.
-    double ghgTax = mCachedMarket->getPrice( getName(), aRegionName, aPeriod, false );
+    double ghgTax = mCachedMarket.getPrice( getName(), aRegionName, aPeriod, false );
     if( ghgTax == Marketplace::NO_MARKET_PRICE ){
         ghgTax = 0;
     }
@@ -234,7 +234,7 @@ double AGHG::getGHGValue( const IOutput* aOutput, const string& aRegionName,
                           const int aPeriod ) const
 {
     // Determine if there is a tax.
-    double ghgTax = mCachedMarket->getPrice( getName(), aRegionName, aPeriod, false );
+    double ghgTax = mCachedMarket.getPrice( getName(), aRegionName, aPeriod, false );
     if( ghgTax == Marketplace::NO_MARKET_PRICE ){
         ghgTax = 0;
     }
@@ -115,6 +115,7 @@ void MACControl::copy( const MACControl& aOther ){
     mZeroCostPhaseInTime = aOther.mZeroCostPhaseInTime;
     mCovertPriceValue = aOther.mCovertPriceValue;
     mPriceMarketName = aOther.mPriceMarketName;
+    mMacTable = aOther.mMacTable;
 }
 
 /*!
@@ -187,7 +188,8 @@ void MACControl::completeInit( const string& aRegionName, const string& aSectorN
 {
     scenario->getMarketplace()->getDependencyFinder()->addDependency( aSectorName, aRegionName, mPriceMarketName, aRegionName );
 
-    if ( mMacCurve->getMaxX() == -DBL_MAX ) {
+    mMacTable.setCurve( mMacCurve );
+    if ( mMacTable.getMaxX() == -DBL_MAX ) {
         ILogger& mainLog = ILogger::getLogger( "main_log" );
         mainLog.setLevel( ILogger::WARNING );
         mainLog << "MAC Curve " << getName() << " appears to have no data. " << endl;
@@ -199,6 +201,7 @@ void MACControl::initCalc( const string& aRegionName,
                            const NonCO2Emissions* aParentGHG,
                            const int aPeriod )
 {
+    mCachedPriceMarket = scenario->getMarketplace()->locateMarket( mPriceMarketName, aRegionName, aPeriod );
 }
 
 void MACControl::calcEmissionsReduction( const std::string& aRegionName, const int aPeriod, const GDP* aGDP ) {
@@ -208,8 +211,7 @@ void MACControl::calcEmissionsReduction( const std::string& aRegionName, const i
         return;
     }
     
-    const Marketplace* marketplace = scenario->getMarketplace();
-    double emissionsPrice = marketplace->getPrice( mPriceMarketName, aRegionName, aPeriod, false );
+    double emissionsPrice = mCachedPriceMarket.getPrice( mPriceMarketName, aRegionName, aPeriod, false );
     if( emissionsPrice == Marketplace::NO_MARKET_PRICE ) {
         emissionsPrice = 0;
     }
@@ -241,7 +243,7 @@ void MACControl::calcEmissionsReduction( const std::string& aRegionName, const i
     if ( ( reduction > 0.0 ) && ( zeroCostReduction > 0.0 ) &&
         ( modelYear <= ( lastCalYear + mZeroCostPhaseInTime ) ) )
     {
-        const double maxEmissionsTax = mMacCurve->getMaxX();
+        const double maxEmissionsTax = mMacTable.getMaxX();
 
 		// Fraction of zero cost that is removed from original reduction value
 		// Equal to 1 at last calibration year and zero at the zero cost phase in time
@@ -265,16 +267,16 @@ void MACControl::calcEmissionsReduction( const std::string& aRegionName, const i
  * \param aCarbonPrice carbon price
  */
 double MACControl::getMACValue( const double aCarbonPrice ) const {
-    const double maxCO2Tax = mMacCurve->getMaxX();
+    const double maxCO2Tax = mMacTable.getMaxX();
     
     // so that getY function won't interpolate beyond last value
     double effectiveCarbonPrice = min( aCarbonPrice, maxCO2Tax );
 
-    double reduction = mMacCurve->getY( effectiveCarbonPrice );
+    double reduction = mMacTable.getY( effectiveCarbonPrice );
 
     // If no mac curve read in then reduction should be zero.
     // This is a legitimate option for a user to remove a mac curve
-    if ( ( mMacCurve->getMinX() == mMacCurve->getMaxX() ) && ( mMacCurve->getMaxX() == 0 ) ) {
+    if ( ( mMacTable.getMinX() == mMacTable.getMaxX() ) && ( mMacTable.getMaxX() == 0 ) ) {
          reduction = 0;
     }
     // Check to see if some other error has occurred
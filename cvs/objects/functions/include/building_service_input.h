@@ -49,6 +49,7 @@
 
 #include "functions/include/inested_input.h"
 #include "util/base/include/value.h"
+#include "marketplace/include/cached_market.h"
 #include "util/base/include/time_vector.h"
 
 class IFunction;
@@ -324,6 +325,10 @@ protected:
         DEFINE_VARIABLE( CONTAINER, "satiation-demand-function", mSatiationDemandFunction, SatiationDemandFunction* )
     )
     
+    //! A pre-located market which has been cached from the marketplace for the
+    //! building service.
+    CachedMarket mCachedMarket;
+    
     void copy( const BuildingServiceInput& aInput );
 };
 
@@ -47,6 +47,7 @@
 #include <string>
 #include <xercesc/dom/DOMNode.hpp>
 #include "functions/include/minicam_input.h"
+#include "marketplace/include/cached_market.h"
 #include <memory>
 
 class Tabs;
@@ -160,6 +161,14 @@ protected:
         //! The C coef associated with mFuelName
         DEFINE_VARIABLE( SIMPLE, "fuel-C-coef", mCachedCCoef, double )
     )
+    
+    //! A pre-located market which has been cached from the marketplace for the
+    //! fraction of the carbon tax to apply.
+    CachedMarket mCachedMarket;
+    
+    //! A pre-located market which has been cached from the marketplace for the
+    //! carbon tax.
+    CachedMarket mCachedCO2Market;
 };
 
 #endif // _CTAX_INPUT_H_
@@ -50,6 +50,7 @@
 
 #include "functions/include/minicam_input.h"
 #include "util/base/include/value.h"
+#include "marketplace/include/cached_market.h"
 #include "util/base/include/time_vector.h"
 
 class Tabs;
@@ -171,6 +172,17 @@ protected:
 
     //! Stash the current sector name for use in setPhysicalDemand
     std::string mSectorName;
+
+    //! A pre-located market which has been cached from the marketplace for the
+    //! subsidy.
+    CachedMarket mCachedMarket;
+
+    //! A pre-located market which has been cached from the marketplace for the
+    //! sector in case the subsidy is share based.
+    CachedMarket mCachedSectorMarket;
+
+    //! Whether the subsidy is share based as set in the market info.
+    bool mIsShareBased;
 private:
     const static std::string XML_REPORTING_NAME; //!< tag name for reporting xml db
 };
@@ -48,6 +48,7 @@
 #include <vector>
 #include <xercesc/dom/DOMNode.hpp>
 #include "util/base/include/value.h"
+#include "marketplace/include/cached_market.h"
 #include "util/base/include/time_vector.h"
 #include "functions/include/iinput.h"
 #include "functions/include/inested_input.h"
@@ -55,7 +56,6 @@
 class Tabs;
 class DemandInput;
 class ProductionInput;
-class CachedMarket;
 
 /*! 
  * \ingroup Objects
@@ -276,7 +276,7 @@ protected:
 
     //! A pre-located market which has been cahced from the marketplace to get
     //! the price and add demands to.
-    std::auto_ptr<CachedMarket> mCachedMarket;
+    CachedMarket mCachedMarket;
 
     void initializeTypeFlags( const std::string& aRegionName );
     void initializeCachedCoefficients( const std::string& aRegionName );
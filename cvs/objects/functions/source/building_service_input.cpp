@@ -142,6 +142,8 @@ void BuildingServiceInput::initCalc( const string& aRegionName,
 {
     /*! \pre There must be a valid region name. */
     assert( !aRegionName.empty() );
+
+    mCachedMarket = scenario->getMarketplace()->locateMarket( mName, aRegionName, aPeriod );
 }
 
 void BuildingServiceInput::copyParam( const IInput* aInput,
@@ -240,7 +242,7 @@ void BuildingServiceInput::setPhysicalDemand( double aPhysicalDemand, const stri
         mServiceDemand[ aPeriod ].set( aPhysicalDemand );
     }
     
-    scenario->getMarketplace()->addToDemand( mName, aRegionName,
+    mCachedMarket.addToDemand( mName, aRegionName,
         mServiceDemand[ aPeriod ], aPeriod );
 }
 
@@ -269,7 +271,7 @@ void BuildingServiceInput::setCoefficient( const double aCoefficient, const int
  * \return The market or unadjusted price.
  */
 double BuildingServiceInput::getPrice( const string& aRegionName, const int aPeriod ) const {
-    return scenario->getMarketplace()->getPrice( mName, aRegionName, aPeriod );
+    return mCachedMarket.getPrice( mName, aRegionName, aPeriod );
 }
 
 void BuildingServiceInput::setPrice( const string& aRegionName,
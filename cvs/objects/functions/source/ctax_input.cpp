@@ -186,6 +186,10 @@ void CTaxInput::initCalc( const string& aRegionName,
     // There must be a valid region name.
     assert( !aRegionName.empty() );
     mCachedCCoef = FunctionUtils::getCO2Coef( aRegionName, mFuelName, aPeriod );
+
+    const Marketplace* marketplace = scenario->getMarketplace();
+    mCachedMarket = marketplace->locateMarket( mName, aRegionName, aPeriod );
+    mCachedCO2Market = marketplace->locateMarket( "CO2", aRegionName, aPeriod );
 }
 
 void CTaxInput::copyParam( const IInput* aInput,
@@ -234,9 +238,8 @@ double CTaxInput::getPrice( const string& aRegionName,
     // Conversion from teragrams of carbon per EJ to metric tons of carbon per GJ
     const double CVRT_TG_MT = 1e-3;
     // A high tax decreases demand.
-    const Marketplace* marketplace = scenario->getMarketplace();
-    double taxFraction = marketplace->getPrice( mName, aRegionName, aPeriod, true );
-    double ctax = marketplace->getPrice( "CO2", aRegionName, aPeriod, false );
+    double taxFraction = mCachedMarket.getPrice( mName, aRegionName, aPeriod, true );
+    double ctax = mCachedCO2Market.getPrice( "CO2", aRegionName, aPeriod, false );
     
     // note we need to perform some unit conversions since C prices and technology
     // costs in different units
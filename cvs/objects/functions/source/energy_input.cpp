@@ -93,8 +93,7 @@ const string& EnergyInput::getXMLReportingName() const{
 }
 
 //! Constructor
-EnergyInput::EnergyInput() :
-    mCachedMarket( 0 )
+EnergyInput::EnergyInput()
 {
     
     mCoefficient = 0;
@@ -353,7 +352,7 @@ void EnergyInput::setPhysicalDemand( double aPhysicalDemand,
                                      const int aPeriod )
 {
     mPhysicalDemand[ aPeriod ].set( aPhysicalDemand );
-    mCachedMarket->addToDemand( mName, mMarketName,
+    mCachedMarket.addToDemand( mName, mMarketName,
                                        mPhysicalDemand[ aPeriod ],
                                        aPeriod, true );
 }
@@ -379,7 +378,7 @@ double EnergyInput::getPrice( const string& aRegionName,
                               const int aPeriod ) const
 {
     return mPriceUnitConversionFactor *
-        mCachedMarket->getPrice( mName, mMarketName, aPeriod );
+        mCachedMarket.getPrice( mName, mMarketName, aPeriod );
 }
 
 void EnergyInput::setPrice( const string& aRegionName,
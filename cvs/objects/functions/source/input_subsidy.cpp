@@ -93,7 +93,8 @@ const string& InputSubsidy::getXMLReportingName() const{
 }
 
 //! Constructor
-InputSubsidy::InputSubsidy()
+InputSubsidy::InputSubsidy():
+mIsShareBased( false )
 {
     TechVectorParseHelper<Value>::setDefaultValue( Value( 1.0 ), mAdjustedCoefficients );
 }
@@ -113,7 +114,8 @@ InputSubsidy::~InputSubsidy() {
  *          allocated memory.
  * \param aOther subsidy input from which to copy.
  */
-InputSubsidy::InputSubsidy( const InputSubsidy& aOther )
+InputSubsidy::InputSubsidy( const InputSubsidy& aOther ):
+mIsShareBased( false )
 {
     MiniCAMInput::copy( aOther );
     // Do not clone the input coefficient as the calculated
@@ -208,6 +210,15 @@ void InputSubsidy::initCalc( const string& aRegionName,
     // There must be a valid region name.
     assert( !aRegionName.empty() );
     mAdjustedCoefficients[ aPeriod ] = 1.0;
+
+    Marketplace* marketplace = scenario->getMarketplace();
+    mCachedMarket = marketplace->locateMarket( mName, aRegionName, aPeriod );
+    mCachedSectorMarket = marketplace->locateMarket( mSectorName, aRegionName, aPeriod );
+
+    // Check if marketInfo exists and has the "isShareBased" boolean.
+    const IInfo* marketInfo = marketplace->getMarketInfo( mName, aRegionName, 0, true );
+    mIsShareBased = marketInfo && marketInfo->hasValue( "isShareBased" ) &&
+                    marketInfo->getBoolean( "isShareBased", true );
 }
 
 void InputSubsidy::copyParam( const IInput* aInput,
@@ -242,17 +253,10 @@ void InputSubsidy::setPhysicalDemand( double aPhysicalDemand,
                                      const string& aRegionName,
                                      const int aPeriod )
 {
-
-    Marketplace* marketplace = scenario->getMarketplace();
-    IInfo* marketInfo = marketplace->getMarketInfo( mName, aRegionName, 0, true );
-
     // If subsidy is shared based, then divide by sector output.
-    // Check if marketInfo exists and has the "isShareBased" boolean.
-    if( marketInfo && marketInfo->hasValue( "isShareBased" ) ){
-        if( marketInfo->getBoolean( "isShareBased", true ) ){
-            // Each share is additive
-            aPhysicalDemand/= marketplace->getDemand( mSectorName, aRegionName, aPeriod );
-        }
+    if( mIsShareBased ){
+        // Each share is additive
+        aPhysicalDemand/= mCachedSectorMarket.getDemand( mSectorName, aRegionName, aPeriod );
     }
     // mPhysicalDemand can be a share if subsidy is share based.
     mPhysicalDemand[ aPeriod ].set( aPhysicalDemand );
@@ -260,8 +264,8 @@ void InputSubsidy::setPhysicalDemand( double aPhysicalDemand,
     // This is so solver can use the excess demand to determine
     // whether to increase or decrease a subsidy. 
     // Each technology share is additive.
-    marketplace->addToSupply( mName, aRegionName, mPhysicalDemand[ aPeriod ],
-                              aPeriod, true );
+    mCachedMarket.addToSupply( mName, aRegionName, mPhysicalDemand[ aPeriod ],
+                               aPeriod, true );
     ILogger& mainLog = ILogger::getLogger( "main_log" );
     mainLog.setLevel( ILogger::NOTICE );
 }
@@ -285,7 +289,7 @@ double InputSubsidy::getPrice( const string& aRegionName,
     // Return negative of price to reflect subsidy for portfolio
     // standard market.
     // A high subsidy increases supply.
-    return - scenario->getMarketplace()->getPrice( mName, aRegionName, aPeriod, true );
+    return - mCachedMarket.getPrice( mName, aRegionName, aPeriod, true );
 }
 
 void InputSubsidy::setPrice( const string& aRegionName,
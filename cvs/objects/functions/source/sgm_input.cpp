@@ -360,7 +360,7 @@ void SGMInput::setPhysicalDemand( double aPhysicalDemand, const string& aRegionN
     // this physical demand is a quantity of capital and the Capital market
     // works in annual dollar amounts
     if( !hasTypeFlag( IInput::CAPITAL ) && aPhysicalDemand > util::getSmallNumber() ) {
-        mCachedMarket->addToDemand( mName, aRegionName, mPhysicalDemand[ aPeriod ], aPeriod );
+        mCachedMarket.addToDemand( mName, aRegionName, mPhysicalDemand[ aPeriod ], aPeriod );
     }
 }
 
@@ -402,7 +402,7 @@ void SGMInput::setCoefficient( const double aCoefficient, const int aPeriod ) {
 * \author Josh Lurz
 */
 double SGMInput::getPrice( const string& aRegionName, const int aPeriod ) const {
-    return mCachedMarket->getPrice( mName, aRegionName, aPeriod );
+    return mCachedMarket.getPrice( mName, aRegionName, aPeriod );
 }
 
 void SGMInput::setPrice( const string& aRegionName,
@@ -67,6 +67,9 @@ public:
     virtual ~CarbonLandLeaf();
     static const std::string& getXMLNameStatic();
 
+    virtual void initCalc( const std::string& aRegionName,
+                           const int aPeriod );
+
     virtual void setUnmanagedLandProfitRate( const std::string& aRegionName,
                                              double aAverageProfitRate,
                                              const int aPeriod );
@@ -83,6 +86,9 @@ protected:
     DEFINE_DATA_WITH_PARENT(
         LandLeaf
     )
+
+    //! A pre-located market which has been cached from the marketplace for CO2.
+    CachedMarket mCachedCO2Market;
     
     virtual const std::string& getXMLName() const;
 
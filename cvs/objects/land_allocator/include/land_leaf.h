@@ -48,6 +48,7 @@
 #include <xercesc/dom/DOMNode.hpp>
 #include "land_allocator/include/aland_allocator_item.h"
 #include "util/base/include/ivisitable.h"
+#include "marketplace/include/cached_market.h"
 
 class Tabs;
 class ICarbonCalc;
@@ -184,6 +185,14 @@ protected:
         DEFINE_VARIABLE( SIMPLE | STATE, "luc-state", mLastCalcCO2Value, Value )
     )
 
+    //! A pre-located market which has been cached from the marketplace for the
+    //! land expansion cost constraint, if any.
+    CachedMarket mCachedLandExpansionCostMarket;
+
+    //! A pre-located market which has been cached from the marketplace for
+    //! land use change CO2.
+    CachedMarket mCachedCO2LUCMarket;
+
     double getCarbonSubsidy( const std::string& aRegionName,
                            const int aPeriod ) const;
 
@@ -90,17 +90,15 @@ const string& CarbonLandLeaf::getXMLNameStatic() {
 }
 
 /*!
-* \brief Sets a the profit rate of a land leaf
-* \details This method adjusts the profit rate of an unmanaged land leaf
-*          to account for the carbon value of land if the ag subsidy is
-*          is active and a carbon price exists. 
+* \brief Initialize the carbon land leaf for the period.
+* \details Warns if the ag subsidy is also in use and locates the CO2 market
+*          which values the carbon in the land.
 * \param aRegionName Region.
 * \param aPeriod Period.
 */
-void CarbonLandLeaf::setUnmanagedLandProfitRate( const string& aRegionName,
-                                                    double aAverageProfitRate,
-                                                    const int aPeriod )
-{
+void CarbonLandLeaf::initCalc( const string& aRegionName, const int aPeriod ) {
+    LandLeaf::initCalc( aRegionName, aPeriod );
+
     bool agSubsidy = Configuration::getInstance()->getBool( "agSubsidy", true );
     if ( agSubsidy ){
         ILogger& mainLog = ILogger::getLogger( "main_log" );
@@ -109,13 +107,27 @@ void CarbonLandLeaf::setUnmanagedLandProfitRate( const string& aRegionName,
         mainLog << "carbon plantations." << endl;
     }
 
+    mCachedCO2Market = scenario->getMarketplace()->locateMarket( "CO2", aRegionName, aPeriod );
+}
+
+/*!
+* \brief Sets a the profit rate of a land leaf
+* \details This method adjusts the profit rate of an unmanaged land leaf
+*          to account for the carbon value of land if the ag subsidy is
+*          is active and a carbon price exists. 
+* \param aRegionName Region.
+* \param aPeriod Period.
+*/
+void CarbonLandLeaf::setUnmanagedLandProfitRate( const string& aRegionName,
+                                                    double aAverageProfitRate,
+                                                    const int aPeriod )
+{
     double profitRate = 0.0;
 
     // The base profit rate is based on the carbon density and the carbon price
     
     // Check if a carbon market exists and has a non-zero price.
-    const Marketplace* marketplace = scenario->getMarketplace();
-    double carbonPrice = marketplace->getPrice( "CO2", aRegionName, aPeriod, false );
+    double carbonPrice = mCachedCO2Market.getPrice( "CO2", aRegionName, aPeriod, false );
 
     // If a carbon price exists, calculate the subsidy
     if( carbonPrice != Marketplace::NO_MARKET_PRICE && carbonPrice > 0.0 ){
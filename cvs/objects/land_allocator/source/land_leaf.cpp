@@ -243,6 +243,12 @@ void LandLeaf::initCalc( const string& aRegionName, const int aPeriod )
     }
 
     mCarbonContentCalc->initCalc( aPeriod );
+
+    Marketplace* marketplace = scenario->getMarketplace();
+    if ( mIsLandExpansionCost ) {
+        mCachedLandExpansionCostMarket = marketplace->locateMarket( mLandExpansionCostName, aRegionName, aPeriod );
+    }
+    mCachedCO2LUCMarket = marketplace->locateMarket( "CO2_LUC", aRegionName, aPeriod );
 }
 
 /*!
@@ -316,11 +322,10 @@ void LandLeaf::setProfitRate( const string& aRegionName,
 {
     // adjust profit rate for land expnasion costs if applicable
     double adjustedProfitRate = aProfitRate;
-    const Marketplace* marketplace = scenario->getMarketplace();
 
     if ( mIsLandExpansionCost ) {
         //subtract off expansion cost from profit rate
-        double expansionCost = marketplace->getPrice( mLandExpansionCostName, aRegionName, aPeriod );
+        double expansionCost = mCachedLandExpansionCostMarket.getPrice( mLandExpansionCostName, aRegionName, aPeriod );
         adjustedProfitRate = aProfitRate - expansionCost;
     }
 
@@ -340,8 +345,7 @@ void LandLeaf::setProfitRate( const string& aRegionName,
 double LandLeaf::getCarbonSubsidy( const string& aRegionName, const int aPeriod ) const {
     const double dollar_conversion_75_90 = 2.212;
     // Check if a carbon market exists and has a non-zero price.
-    const Marketplace* marketplace = scenario->getMarketplace();
-    double carbonPrice = marketplace->getPrice( "CO2_LUC", aRegionName, aPeriod, false );
+    double carbonPrice = mCachedCO2LUCMarket.getPrice( "CO2_LUC", aRegionName, aPeriod, false );
 
     // If a carbon price exists, calculate the subsidy
     if( carbonPrice != Marketplace::NO_MARKET_PRICE && carbonPrice > 0.0 ){
@@ -467,8 +471,7 @@ void LandLeaf::calcLandAllocation( const string& aRegionName,
 
     // compute any demands for land use constraint resources
     if ( mIsLandExpansionCost ) {
-        Marketplace* marketplace = scenario->getMarketplace();
-        marketplace->addToDemand( mLandExpansionCostName, aRegionName,
+        mCachedLandExpansionCostMarket.addToDemand( mLandExpansionCostName, aRegionName,
             mLandAllocation[ aPeriod ], aPeriod, true );
     }
 
@@ -491,9 +494,8 @@ void LandLeaf::calcLUCEmissions( const string& aRegionName,
 
     // Add emissions to the carbon market.
     if ( !aStoreFullEmiss ) {
-        Marketplace* marketplace = scenario->getMarketplace();
-        marketplace->addToDemand( "CO2_LUC", aRegionName,
-                                  mLastCalcCO2Value, aPeriod, false );
+        mCachedCO2LUCMarket.addToDemand( "CO2_LUC", aRegionName,
+                                         mLastCalcCO2Value, aPeriod, false );
     }  
 }
 
@@ -106,11 +106,10 @@ void UnmanagedLandLeaf::setUnmanagedLandProfitRate( const string& aRegionName,
 {
     // Adjust profit rate for land expnasion costs if applicable
     double adjustedProfitRate = aAverageProfitRate;
-    const Marketplace* marketplace = scenario->getMarketplace();
 
     if ( mIsLandExpansionCost ) {
         //subtract off expansion cost from profit rate
-        double expansionCost = marketplace->getPrice( mLandExpansionCostName, aRegionName, aPeriod );
+        double expansionCost = mCachedLandExpansionCostMarket.getPrice( mLandExpansionCostName, aRegionName, aPeriod );
         adjustedProfitRate = adjustedProfitRate - expansionCost;
     }
 
@@ -0,0 +1,466 @@
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+* \file bench_main.cpp
+* \ingroup Objects
+* \brief The main program for gcam-bench which times the solver and model
+*        calculations for a configuration over a sweep of thread counts.
+* \details Each run reads the configuration, runs the scenario to the configured
+*          stop-period and writes the output just as gcam.exe would.  All of the
+*          predefined and named timers in the TimerRegistry are then collected,
+*          which include the XML parse, full and partial World::calc evaluations,
+*          Jacobian calculations, Broyden iterations, state copies and writing
+*          the XML database.  Since the globals and singletons used by the model
+*          can not be reset each run happens in a child process so that every
+*          repetition starts from the same clean state.  The results are written
+*          as CSV (the default) or JSON.
+*
+*          A small stop-period is recommended so that a sweep completes in
+*          reasonable time.  On Windows, where child processes are not available,
+*          a single run is done in process.
+*/
+
+#include "util/base/include/definitions.h"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <memory>
+#include <list>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include "util/base/include/xml_helper.h"
+#include "util/base/include/configuration.h"
+#include "containers/include/scenario.h"
+#include "containers/include/iscenario_runner.h"
+#include "containers/include/scenario_runner_factory.h"
+#include "util/logger/include/ilogger.h"
+#include "util/logger/include/logger_factory.h"
+#include "util/base/include/timer.h"
+#include "util/base/include/version.h"
+#include "util/base/include/util.h"
+#include "util/base/include/child_process_pool.h"
+
+#if GCAM_PARALLEL_ENABLED
+#include <tbb/task_scheduler_init.h>
+#endif
+
+using namespace std;
+
+// The model expects these globals to be defined by the main program.
+ofstream outFile;
+Scenario* scenario;
+
+//! The time and number of calls collected from a single timer.
+struct BenchTiming {
+    string mName;
+    double mSeconds;
+    unsigned int mNumCalls;
+};
+
+//! The timings collected from a single run of the model.
+struct BenchRun {
+    int mNumThreads;
+    int mRepeat;
+    bool mSuccess;
+    vector<BenchTiming> mTimings;
+};
+
+void parseArgs( unsigned int argc, char* argv[], string& confArg, string& logFacArg,
+                string& outputArg, string& formatArg, vector<int>& threadsArg, int& repeatsArg );
+void printUsageMessage( unsigned int argc, char* argv[] );
+bool runModel( const int aNumThreads );
+void writeTimings( FILE* aFile );
+bool readTimings( FILE* aFile, vector<BenchTiming>& aTimings );
+void writeCSV( ostream& aOut, const vector<BenchRun>& aRuns );
+void writeJSON( ostream& aOut, const vector<BenchRun>& aRuns, const string& aConfigurationFileName );
+
+//! Benchmark program.
+int main( int argc, char *argv[] ) {
+    string configurationArg = "configuration.xml";
+    string loggerFactoryArg = "log_conf.xml";
+    string outputArg;
+    string formatArg = "csv";
+    vector<int> threadsArg;
+    int repeatsArg = 1;
+    parseArgs( argc, argv, configurationArg, loggerFactoryArg, outputArg, formatArg, threadsArg, repeatsArg );
+    if( outputArg.empty() ) {
+        outputArg = "gcam-bench." + formatArg;
+    }
+
+    // Initialize the LoggerFactory
+    LoggerFactoryWrapper loggerFactoryWrapper;
+    bool success = XMLHelper<void>::parseXML( loggerFactoryArg, &loggerFactoryWrapper );
+    if( !success ){
+        return 1;
+    }
+
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    mainLog.setLevel( ILogger::NOTICE );
+    mainLog << "Running GCAM benchmarks with code base version " << __ObjECTS_VER__ << " revision "
+        << __REVISION_NUMBER__ << endl;
+    mainLog << "Configuration file:  " << configurationArg << endl;
+    success = XMLHelper<void>::parseXML( configurationArg, Configuration::getInstance() );
+    if( !success ){
+        return 1;
+    }
+
+#if !GCAM_PARALLEL_ENABLED
+    if( threadsArg.size() > 1 || ( !threadsArg.empty() && threadsArg[ 0 ] != 1 ) ) {
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "GCAM was not built with GCAM_PARALLEL_ENABLED, only a single thread will be benchmarked." << endl;
+    }
+    threadsArg.assign( 1, 1 );
+#else
+    if( threadsArg.empty() ) {
+        threadsArg.push_back( tbb::task_scheduler_init::default_num_threads() );
+    }
+#endif
+
+    vector<BenchRun> runs;
+    for( int threads : threadsArg ) {
+        for( int repeat = 0; repeat < repeatsArg; ++repeat ) {
+            BenchRun run = { threads, repeat, false, vector<BenchTiming>() };
+            runs.push_back( run );
+        }
+    }
+
+#if !defined(_WIN32)
+    // Each run must start from freshly read inputs and the model can not be
+    // reset in process so run them one at a time in child processes.
+    vector<FILE*> resultFiles( runs.size() );
+    for( size_t i = 0; i < runs.size(); ++i ) {
+        resultFiles[ i ] = tmpfile();
+    }
+    const vector<bool> childSuccess = util::runInChildProcesses( runs.size(), 1,
+        [&]( const unsigned int aIndex ) {
+            const bool success = runModel( runs[ aIndex ].mNumThreads );
+            FILE* results = resultFiles[ aIndex ];
+            if( results ) {
+                writeTimings( results );
+            }
+            return results && fflush( results ) == 0 && success;
+        } );
+    for( size_t i = 0; i < runs.size(); ++i ) {
+        if( resultFiles[ i ] ) {
+            rewind( resultFiles[ i ] );
+            runs[ i ].mSuccess = readTimings( resultFiles[ i ], runs[ i ].mTimings ) && childSuccess[ i ];
+            fclose( resultFiles[ i ] );
+        }
+    }
+#else
+    if( runs.size() > 1 ) {
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "Only a single benchmark run is supported on this platform." << endl;
+        runs.resize( 1 );
+    }
+    runs[ 0 ].mSuccess = runModel( runs[ 0 ].mNumThreads );
+    FILE* results = tmpfile();
+    if( results ) {
+        writeTimings( results );
+        rewind( results );
+        readTimings( results, runs[ 0 ].mTimings );
+        fclose( results );
+    }
+#endif
+
+    ofstream out( outputArg.c_str() );
+    if( !out ) {
+        mainLog.setLevel( ILogger::ERROR );
+        mainLog << "Could not open benchmark output file " << outputArg << endl;
+        return 1;
+    }
+    if( formatArg == "json" ) {
+        writeJSON( out, runs, configurationArg );
+    }
+    else {
+        writeCSV( out, runs );
+    }
+
+    bool allSuccess = true;
+    for( const BenchRun& run : runs ) {
+        allSuccess = allSuccess && run.mSuccess;
+    }
+    mainLog.setLevel( allSuccess ? ILogger::NOTICE : ILogger::WARNING );
+    mainLog << "Wrote " << runs.size() << " benchmark runs to " << outputArg
+            << ( allSuccess ? "." : ", some of which failed." ) << endl;
+    return allSuccess ? 0 : 1;
+}
+
+/*!
+ * \brief Read the scenario, run it to the configured stop-period and write the
+ *        output as gcam.exe would while timing each of those steps.
+ * \param aNumThreads The number of threads the model may use, only used when
+ *                    GCAM_PARALLEL_ENABLED.
+ * \return Whether the scenario was set up and run successfully.
+ */
+bool runModel( const int aNumThreads ) {
+#if GCAM_PARALLEL_ENABLED
+    tbb::task_scheduler_init init( aNumThreads );
+#endif
+    Timer timer;
+    timer.start();
+
+    list<string> exclusionList;
+    auto_ptr<IScenarioRunner> runner = ScenarioRunnerFactory::createDefault( exclusionList );
+
+    Timer& parseTimer = TimerRegistry::getInstance().getTimer( "Read input files" );
+    parseTimer.start();
+    bool success = runner->setupScenarios( timer );
+    parseTimer.stop();
+    XMLHelper<void>::cleanupParser();
+    if( !success ) {
+        return false;
+    }
+
+    const Configuration* conf = Configuration::getInstance();
+    const int stopPeriod = conf->getInt( "stop-period", Scenario::RUN_ALL_PERIODS );
+    const bool printDebug = conf->shouldWriteFile( "xmlDebugFileName" );
+    Timer& runTimer = TimerRegistry::getInstance().getTimer( "Run scenario" );
+    runTimer.start();
+    success = runner->runScenarios( stopPeriod, printDebug, timer );
+    runTimer.stop();
+
+    // The XML database output is timed by the WRITE_DATA timer.
+    runner->printOutput( timer );
+    runner->cleanup();
+    timer.stop();
+    return success;
+}
+
+/*!
+ * \brief Write the time and calls of all predefined and named timers.
+ * \details Each timer is written on a line as the seconds, number of calls and
+ *          name separated by spaces.
+ * \param aFile The file to write to.
+ */
+void writeTimings( FILE* aFile ) {
+    TimerRegistry& registry = TimerRegistry::getInstance();
+    for( int timer = 0; timer < TimerRegistry::END; ++timer ) {
+        const TimerRegistry::PredefinedTimers timerName = static_cast<TimerRegistry::PredefinedTimers>( timer );
+        const Timer& currTimer = registry.getTimer( timerName );
+        fprintf( aFile, "%.9g %u %s\n", currTimer.getTotalTimeDifference(), currTimer.getNumCalls(),
+                 TimerRegistry::getTimerName( timerName ).c_str() );
+    }
+    for( const auto& namedTimer : registry.getNamedTimers() ) {
+        fprintf( aFile, "%.9g %u %s\n", namedTimer.second.getTotalTimeDifference(),
+                 namedTimer.second.getNumCalls(), namedTimer.first.c_str() );
+    }
+}
+
+/*!
+ * \brief Read back the timings written by writeTimings.
+ * \param aFile The file to read from.
+ * \param aTimings [out] The timings read.
+ * \return Whether any timings were read.
+ */
+bool readTimings( FILE* aFile, vector<BenchTiming>& aTimings ) {
+    BenchTiming timing;
+    char name[ 256 ];
+    while( fscanf( aFile, "%lf %u ", &timing.mSeconds, &timing.mNumCalls ) == 2
+           && fgets( name, sizeof( name ), aFile ) )
+    {
+        timing.mName = name;
+        if( !timing.mName.empty() && timing.mName[ timing.mName.size() - 1 ] == '\n' ) {
+            timing.mName.erase( timing.mName.size() - 1 );
+        }
+        aTimings.push_back( timing );
+    }
+    return !aTimings.empty();
+}
+
+/*!
+ * \brief Write the benchmark results as CSV with one row per run and timer.
+ * \param aOut The stream to write to.
+ * \param aRuns The benchmark runs.
+ */
+void writeCSV( ostream& aOut, const vector<BenchRun>& aRuns ) {
+    aOut << "threads,repeat,success,timer,seconds,calls" << endl;
+    aOut.precision( 9 );
+    for( const BenchRun& run : aRuns ) {
+        for( const BenchTiming& timing : run.mTimings ) {
+            aOut << run.mNumThreads << ',' << run.mRepeat << ',' << run.mSuccess << ",\""
+                 << timing.mName << "\"," << timing.mSeconds << ',' << timing.mNumCalls << endl;
+        }
+    }
+}
+
+/*!
+ * \brief Escape a string so that it can be written as a JSON string.
+ * \param aString The string to escape.
+ * \return The escaped string.
+ */
+string escapeJSON( const string& aString ) {
+    string escaped;
+    for( char c : aString ) {
+        if( c == '"' || c == '\\' ) {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+/*!
+ * \brief Write the benchmark results as JSON.
+ * \param aOut The stream to write to.
+ * \param aRuns The benchmark runs.
+ * \param aConfigurationFileName The configuration which was benchmarked.
+ */
+void writeJSON( ostream& aOut, const vector<BenchRun>& aRuns, const string& aConfigurationFileName ) {
+    aOut.precision( 9 );
+    aOut << "{" << endl;
+    aOut << "  \"version\": \"" << __REVISION_NUMBER__ << "\"," << endl;
+    aOut << "  \"parallel\": " << ( GCAM_PARALLEL_ENABLED ? "true" : "false" ) << "," << endl;
+    aOut << "  \"configuration\": \"" << escapeJSON( aConfigurationFileName ) << "\"," << endl;
+    aOut << "  \"runs\": [";
+    for( size_t i = 0; i < aRuns.size(); ++i ) {
+        const BenchRun& run = aRuns[ i ];
+        aOut << ( i == 0 ? "" : "," ) << endl;
+        aOut << "    { \"threads\": " << run.mNumThreads << ", \"repeat\": " << run.mRepeat
+             << ", \"success\": " << ( run.mSuccess ? "true" : "false" ) << ", \"timers\": [";
+        for( size_t j = 0; j < run.mTimings.size(); ++j ) {
+            const BenchTiming& timing = run.mTimings[ j ];
+            aOut << ( j == 0 ? "" : "," ) << endl;
+            aOut << "      { \"name\": \"" << escapeJSON( timing.mName ) << "\", \"seconds\": "
+                 << timing.mSeconds << ", \"calls\": " << timing.mNumCalls << " }";
+        }
+        aOut << " ] }";
+    }
+    aOut << " ]" << endl << "}" << endl;
+}
+
+/*!
+ * \brief Get the value of a command line flag which may either be attached to
+ *        the flag or be the following argument.
+ * \param argc Number of arguments.
+ * \param argv List of arguments.
+ * \param aFlag The flag to check for such as "-C".
+ * \param i [in,out] The index of the current argument which will be advanced
+ *          past the flag and value if matched.
+ * \param aValue [out] The value of the flag.
+ * \return Whether the current argument matched the flag.
+ */
+bool parseFlag( unsigned int argc, char* argv[], const string& aFlag, unsigned int& i, string& aValue ) {
+    string temp( argv[ i ] );
+    if( temp == aFlag ) {
+        if( ( i + 1 ) == argc ) {
+            cout << "Not enough arguments" << endl;
+            printUsageMessage( argc, argv );
+            abort();
+        }
+        aValue = string( argv[ i + 1 ] );
+        i += 2;
+        return true;
+    }
+    else if( temp.compare( 0, aFlag.length(), aFlag ) == 0 ) {
+        aValue = temp.substr( aFlag.length(), temp.length() );
+        ++i;
+        return true;
+    }
+    return false;
+}
+
+/*!
+* \brief Function to parse the command line arguments.
+* \param argc Number of arguments.
+* \param argv List of arguments.
+* \param confArg [out] Name of the configuration file.
+* \param logFacArg [out] Name of the log configuration file.
+* \param outputArg [out] Name of the file to write results to.
+* \param formatArg [out] The format to write results in, csv or json.
+* \param threadsArg [out] The number of threads to benchmark with.
+* \param repeatsArg [out] The number of times to repeat each run.
+*/
+void parseArgs( unsigned int argc, char* argv[], string& confArg, string& logFacArg,
+                string& outputArg, string& formatArg, vector<int>& threadsArg, int& repeatsArg )
+{
+    for( unsigned int i = 1; i < argc; ){
+        string value;
+        if( parseFlag( argc, argv, "-C", i, confArg ) || parseFlag( argc, argv, "-L", i, logFacArg )
+            || parseFlag( argc, argv, "-o", i, outputArg ) )
+        {
+            continue;
+        }
+        else if( parseFlag( argc, argv, "-f", i, formatArg ) ) {
+            if( formatArg != "csv" && formatArg != "json" ) {
+                cout << "Invalid format: " << formatArg << endl;
+                printUsageMessage( argc, argv );
+                abort();
+            }
+        }
+        else if( parseFlag( argc, argv, "-t", i, value ) ) {
+            size_t start = 0;
+            while( start < value.length() ) {
+                size_t end = value.find( ',', start );
+                if( end == string::npos ) {
+                    end = value.length();
+                }
+                const int threads = atoi( value.substr( start, end - start ).c_str() );
+                if( threads <= 0 ) {
+                    cout << "Invalid thread count in: " << value << endl;
+                    printUsageMessage( argc, argv );
+                    abort();
+                }
+                threadsArg.push_back( threads );
+                start = end + 1;
+            }
+        }
+        else if( parseFlag( argc, argv, "-r", i, value ) ) {
+            repeatsArg = atoi( value.c_str() );
+            if( repeatsArg <= 0 ) {
+                cout << "Invalid number of repeats: " << value << endl;
+                printUsageMessage( argc, argv );
+                abort();
+            }
+        }
+        else {
+            cout << "Invalid argument: " << argv[ i ] << endl;
+            printUsageMessage( argc, argv );
+            abort();
+        }
+    }
+}
+
+/*!
+ * \brief Print the command line usage message.
+ * \param argc Number of arguments.
+ * \param argv List of arguments.
+ */
+void printUsageMessage( unsigned int argc, char* argv[] ) {
+    cout << "Usage: " << argv[ 0 ] << " [-CconfigurationFileName ][ -LloggerFactoryFileName ]"
+         << "[ -ooutputFileName ][ -fcsv|json ][ -tthreads[,threads...] ][ -rrepeats ]" << endl;
+}
@@ -61,15 +61,20 @@ class Value;
  *          for which there would be a large number of instance of or contain many
  *          calls to the Marketplace.
  *
+ *          Calls for a period other than the one the market was located for
+ *          fall back to looking up the market through the Marketplace so the
+ *          handle is always safe to use, although only fast for that period.
+ *
  * \author Pralit Patel
  * \warning It is up to the user to ensure the cached market matches the intended
- *          market, i.e. the good name, region name, and period have not changed.
- *          To ensure this does not happen a user could run in debug mode to check
+ *          market, i.e. the good name and region name have not changed.  To
+ *          ensure this does not happen a user could run in debug mode to check
  *          asserts.
  */
 class CachedMarket
 {
 public:
+    CachedMarket();
     CachedMarket( const std::string& aGoodName, const std::string& aRegionName, const int aPeriod, Market* aLocatedMarket );
     ~CachedMarket();
 
@@ -99,14 +104,15 @@ public:
 private:
 #ifndef NDEBUG
     //! The good name used when this market was located.  Used for debugging.
-    const std::string mGoodName;
+    std::string mGoodName;
     
     //! The region name used when this market was located.  Used for debugging.
-    const std::string mRegionName;
-    
-    //! The period used when this market was located.  Used for debugging.
-    const int mPeriod;
+    std::string mRegionName;
 #endif
+    
+    //! The period used when this market was located or -1 if it has not been.
+    int mPeriod;
+    
     //! The actual market which is cached.
     Market* mCachedMarket;
 };
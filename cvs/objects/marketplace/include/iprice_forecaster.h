@@ -0,0 +1,103 @@
+#ifndef _IPRICE_FORECASTER_H_
+#define _IPRICE_FORECASTER_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file iprice_forecaster.h
+ * \ingroup Objects
+ * \brief The IPriceForecaster interface header file.
+ */
+
+#include <string>
+#include <vector>
+
+class MarketContainer;
+
+/*!
+ * \ingroup Objects
+ * \brief An interface to a source of initial guesses for market prices at the
+ *        start of a model period.
+ * \details The Marketplace asks each configured forecaster in turn for the price
+ *          of a market in Marketplace::init_to_last and uses the first forecast
+ *          given, falling back to MarketContainer::forecastPrice if there are none.
+ *          The forecasters are configured by the comma separated list of names in
+ *          the configuration string price-forecast, see Marketplace::Marketplace.
+ */
+class IPriceForecaster {
+public:
+    //! Virtual destructor so that derived classes may be deleted through this interface.
+    virtual ~IPriceForecaster() {}
+    
+    /*!
+     * \brief Get the name which identifies this forecaster in the configuration.
+     * \return The name of this forecaster.
+     */
+    virtual const std::string& getName() const = 0;
+    
+    /*!
+     * \brief Forecast the price of a market in a period before it is solved.
+     * \param aMarketNumber The index of the market in the Marketplace.
+     * \param aMarket The market to forecast.
+     * \param aPeriod The period which is about to be solved.
+     * \param aForecastPrice Set to the forecasted price if one could be made.
+     * \return Whether a forecast could be made.
+     */
+    virtual bool forecastPrice( const int aMarketNumber, const MarketContainer* aMarket,
+                                const int aPeriod, double& aForecastPrice ) const = 0;
+    
+    /*!
+     * \brief Whether a forecast should be compared to the price of the previous
+     *        period before it is used.
+     * \details Forecasts that are extrapolated may be wildly off and should be
+     *          rejected in favor of the last price if so.  Forecasts that are
+     *          solved prices of the same period can be used as is.
+     * \return Whether the forecast should be checked.
+     */
+    virtual bool shouldCheckForecast() const = 0;
+    
+    /*!
+     * \brief Record the solution of a period which has just been solved.
+     * \param aMarkets All of the markets in the Marketplace.
+     * \param aPeriod The period which was solved.
+     */
+    virtual void storeSolution( const std::vector<MarketContainer*>& aMarkets,
+                                const int aPeriod ) = 0;
+};
+
+#endif // _IPRICE_FORECASTER_H_
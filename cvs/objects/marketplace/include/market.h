@@ -55,7 +55,9 @@
 #include "util/base/include/value.h"
 #include "util/base/include/data_definition_util.h"
 
-#if GCAM_PARALLEL_ENABLED
+#if GCAM_DETERMINISTIC_SUMS
+#include "util/base/include/deterministic_sum.h"
+#elif GCAM_PARALLEL_ENABLED
 #include "tbb/spin_rw_mutex.h"
 #endif
 
@@ -115,6 +117,9 @@ class Market: public IYeared, public IVisitable, private boost::noncopyable
 {
     friend class XMLDBOutputter;
     friend class PriceMarket;
+#if GCAM_DETERMINISTIC_SUMS
+    friend class ManageStateVariables;
+#endif
 public:
     Market( const MarketContainer* aContainer );
     virtual ~Market();
@@ -212,7 +217,15 @@ protected:
         DEFINE_VARIABLE( SIMPLE, "year", mYear, int )
     )
     
-#if GCAM_PARALLEL_ENABLED
+#if GCAM_DETERMINISTIC_SUMS
+    //! The total demand when built with GCAM_DETERMINISTIC_SUMS in which case
+    //! it is used instead of mDemand and the demand must be read through the
+    //! accessors.
+    DeterministicSum mDemandSum;
+
+    //! The total supply when built with GCAM_DETERMINISTIC_SUMS, see mDemandSum.
+    DeterministicSum mSupplySum;
+#elif GCAM_PARALLEL_ENABLED
     typedef tbb::speculative_spin_rw_mutex Mutex;
     //! A fast lock to protect conccurent adds to demand.
     mutable Mutex mDemandMutex;
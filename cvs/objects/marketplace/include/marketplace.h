@@ -62,6 +62,7 @@ class IVisitor;
 class IInfo;
 class CachedMarket;
 class MarketDependencyFinder;
+class IPriceForecaster;
 class Value;
 namespace objects {
     template<typename T>
@@ -170,6 +171,9 @@ public:
         const int period ) const;
 
     void init_to_last( const int period );
+    void storeSolution( const int aPeriod );
+    bool forecastsFromPriorTrials() const;
+    void writeSolvedPrices( std::ostream& aOut, const std::vector<bool>& aIsValidPeriod ) const;
     int resetToPriceMarket( const int aMarketNumber );
     void setMarketToSolve( const std::string& goodName, const std::string& regionName,
         const int period );
@@ -182,8 +186,8 @@ public:
     IInfo* getMarketInfo( const std::string& aGoodName, const std::string& aRegionName,
                          const int aPeriod, const bool aMustExist );
     
-    std::auto_ptr<CachedMarket> locateMarket( const std::string& aGoodName, const std::string& aRegionName,
-                                               const int aPeriod ) const;
+    CachedMarket locateMarket( const std::string& aGoodName, const std::string& aRegionName,
+                               const int aPeriod ) const;
 
    void accept( IVisitor* aVisitor, const int aPeriod ) const;
 
@@ -198,6 +202,8 @@ public:
     
     MarketDependencyFinder* getDependencyFinder() const;
 
+    int getNumMarkets() const;
+
     // The methods from here down are diagnostics
     std::vector<double> fullstate( int period ) const; //!< Return all supplies and demands in all markets in a single vector
     bool checkstate(int period, const std::vector<double>&, std::ostream *log=0, unsigned tol=0) const;
@@ -223,8 +229,19 @@ protected:
     //! affected by changing the price of a single market.
     std::auto_ptr<MarketDependencyFinder> mDependencyFinder;
     
+    //! The sources of initial guesses for prices in the order they are tried,
+    //! see init_to_last.
+    std::vector<IPriceForecaster*> mForecasters;
+    
     //! Flag indicating whether the next call to world->calc() will be part of a partial derivative calculation 
     static bool mIsDerivativeCalc;
+
+    //! Flag indicating whether the partial derivative calculations will also use
+    //! the flow graph and so may add to the same market concurrently
+    static bool mIsParallelDerivativeCalc;
+    
+    bool forecastPrice( const int aMarketNumber, const int aPeriod, double& aForecastPrice,
+                        bool& aShouldCheckForecast ) const;
 };
 
 #endif
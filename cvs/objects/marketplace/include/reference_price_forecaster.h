@@ -0,0 +1,85 @@
+#ifndef _REFERENCE_PRICE_FORECASTER_H_
+#define _REFERENCE_PRICE_FORECASTER_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file reference_price_forecaster.h
+ * \ingroup Objects
+ * \brief The ReferencePriceForecaster class header file.
+ */
+
+#include <map>
+#include <iosfwd>
+#include "marketplace/include/iprice_forecaster.h"
+
+/*!
+ * \ingroup Objects
+ * \brief Forecasts prices as the solved prices of a reference scenario which
+ *        were saved to disk.
+ * \details The prices are read from the file given by the configuration file
+ *          reference-prices which is a solved-prices file written by a previous
+ *          run, see writeSolvedPrices.  Markets are matched by their region and
+ *          good so the reference scenario does not need to have the same markets.
+ */
+class ReferencePriceForecaster : public IPriceForecaster {
+public:
+    ReferencePriceForecaster();
+    
+    static const std::string& getXMLNameStatic();
+    
+    static void writeSolvedPrices( const std::vector<MarketContainer*>& aMarkets,
+                                   const std::vector<bool>& aIsValidPeriod,
+                                   std::ostream& aOut );
+    
+    // IPriceForecaster methods
+    virtual const std::string& getName() const;
+    
+    virtual bool forecastPrice( const int aMarketNumber, const MarketContainer* aMarket,
+                                const int aPeriod, double& aForecastPrice ) const;
+    
+    virtual bool shouldCheckForecast() const;
+    
+    virtual void storeSolution( const std::vector<MarketContainer*>& aMarkets,
+                                const int aPeriod );
+private:
+    //! The reference prices by year by market name.
+    std::map<std::string, std::map<int, double> > mPrices;
+};
+
+#endif // _REFERENCE_PRICE_FORECASTER_H_
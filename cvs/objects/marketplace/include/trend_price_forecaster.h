@@ -0,0 +1,81 @@
+#ifndef _TREND_PRICE_FORECASTER_H_
+#define _TREND_PRICE_FORECASTER_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file trend_price_forecaster.h
+ * \ingroup Objects
+ * \brief The TrendPriceForecaster class header file.
+ */
+
+#include "marketplace/include/iprice_forecaster.h"
+
+/*!
+ * \ingroup Objects
+ * \brief Forecasts prices from a least squares linear fit of the prices of the
+ *        last several periods.
+ * \details Unlike MarketContainer::extrapolate, which fits the last three
+ *          periods exactly, the trend is fit over the number of periods given by
+ *          the configuration value price-forecast-trend-periods which smooths
+ *          out a price that oscillates from one period to the next.  No forecast
+ *          is made for markets with a price that is not positive in any of those
+ *          periods.
+ */
+class TrendPriceForecaster : public IPriceForecaster {
+public:
+    TrendPriceForecaster();
+    
+    static const std::string& getXMLNameStatic();
+    
+    // IPriceForecaster methods
+    virtual const std::string& getName() const;
+    
+    virtual bool forecastPrice( const int aMarketNumber, const MarketContainer* aMarket,
+                                const int aPeriod, double& aForecastPrice ) const;
+    
+    virtual bool shouldCheckForecast() const;
+    
+    virtual void storeSolution( const std::vector<MarketContainer*>& aMarkets,
+                                const int aPeriod );
+private:
+    //! The number of previous periods to fit the trend to.
+    int mNumPeriods;
+};
+
+#endif // _TREND_PRICE_FORECASTER_H_
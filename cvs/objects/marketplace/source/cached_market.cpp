@@ -55,7 +55,7 @@ extern Scenario* scenario;
  * \brief Constructor which takes the parameters used to locate the given market.
  * \param aGoodName The good name used to locate aLocatedMarket.  Stored for debugging.
  * \param aGoodName The region name used to locate aLocatedMarket.  Stored for debugging.
- * \param aGoodName The period used to locate aLocatedMarket.  Stored for debugging.
+ * \param aGoodName The period used to locate aLocatedMarket.
  * \param aLocatedMarket A pointer to the actual market which was located.  Note that this
  *                       parameter can be null which indicates the market was not found.
  */
@@ -65,12 +65,23 @@ CachedMarket::CachedMarket( const string& aGoodName, const string& aRegionName,
 #ifndef NDEBUG
 mGoodName( aGoodName ),
 mRegionName( aRegionName ),
-mPeriod( aPeriod ),
 #endif
+mPeriod( aPeriod ),
 mCachedMarket( aLocatedMarket )
 {
 }
 
+/*!
+ * \brief Default constructor for a market which has not been located yet.
+ * \details All calls will be passed through to the Marketplace until a located
+ *          market is assigned to this one.
+ */
+CachedMarket::CachedMarket():
+mPeriod( -1 ),
+mCachedMarket( 0 )
+{
+}
+
 /*!
  * \brief Destructor
  */
@@ -90,6 +101,13 @@ CachedMarket::~CachedMarket() {
 void CachedMarket::setPrice( const string& aGoodName, const string& aRegionName, const double aValue,
                              const int aPeriod, bool aMustExist )
 {
+    // Any other period than the one this market was located for is passed
+    // through to the marketplace.
+    if( aPeriod != mPeriod ) {
+        scenario->getMarketplace()->setPrice( aGoodName, aRegionName, aValue, aPeriod, aMustExist );
+        return;
+    }
+    
     /*!
      * \invariant The given good name matches the one that was used when locating this market.
      */
@@ -100,11 +118,6 @@ void CachedMarket::setPrice( const string& aGoodName, const string& aRegionName,
      */
     assert( aRegionName == mRegionName );
     
-    /*!
-     * \invariant The given period matches the one that was used when locating this market.
-     */
-    assert( aPeriod == mPeriod );
-    
     // Print a warning message if the new price is not a finite number.
     if ( !util::isValidNumber( aValue ) ) {
         ILogger& mainLog = ILogger::getLogger( "main_log" );
@@ -137,6 +150,13 @@ void CachedMarket::setPrice( const string& aGoodName, const string& aRegionName,
 void CachedMarket::addToSupply( const string& aGoodName, const string& aRegionName, const Value& aValue,
                                 const int aPeriod, bool aMustExist )
 {
+    // Any other period than the one this market was located for is passed
+    // through to the marketplace.
+    if( aPeriod != mPeriod ) {
+        scenario->getMarketplace()->addToSupply( aGoodName, aRegionName, aValue, aPeriod, aMustExist );
+        return;
+    }
+    
     /*!
      * \invariant The given good name matches the one that was used when locating this market.
      */
@@ -147,11 +167,6 @@ void CachedMarket::addToSupply( const string& aGoodName, const string& aRegionNa
      */
     assert( aRegionName == mRegionName );
     
-    /*!
-     * \invariant The given period matches the one that was used when locating this market.
-     */
-    assert( aPeriod == mPeriod );
-    
     // Print a warning message when adding infinity values to the supply.
     if ( !util::isValidNumber( aValue ) ) {
         ILogger& mainLog = ILogger::getLogger( "main_log" );
@@ -185,6 +200,13 @@ void CachedMarket::addToSupply( const string& aGoodName, const string& aRegionNa
 void CachedMarket::addToDemand( const string& aGoodName, const string& aRegionName, const Value& aValue,
                                 const int aPeriod, bool aMustExist )
 {
+    // Any other period than the one this market was located for is passed
+    // through to the marketplace.
+    if( aPeriod != mPeriod ) {
+        scenario->getMarketplace()->addToDemand( aGoodName, aRegionName, aValue, aPeriod, aMustExist );
+        return;
+    }
+    
     /*!
      * \invariant The given good name matches the one that was used when locating this market.
      */
@@ -195,11 +217,6 @@ void CachedMarket::addToDemand( const string& aGoodName, const string& aRegionNa
      */
     assert( aRegionName == mRegionName );
     
-    /*!
-     * \invariant The given period matches the one that was used when locating this market.
-     */
-    assert( aPeriod == mPeriod );
-    
     // Print a warning message when adding infinity values to the demand
     if ( !util::isValidNumber( aValue ) ) {
         ILogger& mainLog = ILogger::getLogger( "main_log" );
@@ -232,6 +249,12 @@ void CachedMarket::addToDemand( const string& aGoodName, const string& aRegionNa
  */  
 double CachedMarket::getPrice( const string& aGoodName, const string& aRegionName, const int aPeriod,
                                bool aMustExist ) const {
+    // Any other period than the one this market was located for is passed
+    // through to the marketplace.
+    if( aPeriod != mPeriod ) {
+        return scenario->getMarketplace()->getPrice( aGoodName, aRegionName, aPeriod, aMustExist );
+    }
+    
     /*!
      * \invariant The given good name matches the one that was used when locating this market.
      */
@@ -242,11 +265,6 @@ double CachedMarket::getPrice( const string& aGoodName, const string& aRegionNam
      */
     assert( aRegionName == mRegionName );
     
-    /*!
-     * \invariant The given period matches the one that was used when locating this market.
-     */
-    assert( aPeriod == mPeriod );
-    
     if( mCachedMarket ) {
         return mCachedMarket->getPrice();
     }
@@ -271,6 +289,12 @@ double CachedMarket::getPrice( const string& aGoodName, const string& aRegionNam
  * \see Marketplace::getSupply
  */
 double CachedMarket::getSupply( const string& aGoodName, const string& aRegionName, const int aPeriod ) const {
+    // Any other period than the one this market was located for is passed
+    // through to the marketplace.
+    if( aPeriod != mPeriod ) {
+        return scenario->getMarketplace()->getSupply( aGoodName, aRegionName, aPeriod );
+    }
+    
     /*!
      * \invariant The given good name matches the one that was used when locating this market.
      */
@@ -281,11 +305,6 @@ double CachedMarket::getSupply( const string& aGoodName, const string& aRegionNa
      */
     assert( aRegionName == mRegionName );
     
-    /*!
-     * \invariant The given period matches the one that was used when locating this market.
-     */
-    assert( aPeriod == mPeriod );
-    
     if ( mCachedMarket ) {
         return mCachedMarket->getSupply();
     }
@@ -307,6 +326,12 @@ double CachedMarket::getSupply( const string& aGoodName, const string& aRegionNa
  * \see Marketplace::getDemand
  */
 double CachedMarket::getDemand(  const string& aGoodName, const string& aRegionName, const int aPeriod ) const {
+    // Any other period than the one this market was located for is passed
+    // through to the marketplace.
+    if( aPeriod != mPeriod ) {
+        return scenario->getMarketplace()->getDemand( aGoodName, aRegionName, aPeriod );
+    }
+    
     /*!
      * \invariant The given good name matches the one that was used when locating this market.
      */
@@ -317,11 +342,6 @@ double CachedMarket::getDemand(  const string& aGoodName, const string& aRegionN
      */
     assert( aRegionName == mRegionName );
     
-    /*!
-     * \invariant The given period matches the one that was used when locating this market.
-     */
-    assert( aPeriod == mPeriod );
-    
     if ( mCachedMarket ) {
         return mCachedMarket->getDemand();
     }
@@ -350,6 +370,12 @@ double CachedMarket::getDemand(  const string& aGoodName, const string& aRegionN
 const IInfo* CachedMarket::getMarketInfo( const string& aGoodName, const string& aRegionName,
                                           const int aPeriod, const bool aMustExist ) const 
 {
+    // Any other period than the one this market was located for is passed
+    // through to the marketplace.
+    if( aPeriod != mPeriod ) {
+        return static_cast<const Marketplace*>( scenario->getMarketplace() )->getMarketInfo( aGoodName, aRegionName, aPeriod, aMustExist );
+    }
+    
     /*!
      * \invariant The given good name matches the one that was used when locating this market.
      */
@@ -359,11 +385,6 @@ const IInfo* CachedMarket::getMarketInfo( const string& aGoodName, const string&
      * \invariant The given region name matches the one that was used when locating this market.
      */
     assert( aRegionName == mRegionName );
-    
-    /*!
-     * \invariant The given period matches the one that was used when locating this market.
-     */
-    assert( aPeriod == mPeriod );
 
     const IInfo* info = 0;
     if ( mCachedMarket ) {
@@ -402,6 +423,12 @@ const IInfo* CachedMarket::getMarketInfo( const string& aGoodName, const string&
 IInfo* CachedMarket::getMarketInfo( const string& aGoodName, const string& aRegionName,
                                     const int aPeriod, const bool aMustExist )
 {
+    // Any other period than the one this market was located for is passed
+    // through to the marketplace.
+    if( aPeriod != mPeriod ) {
+        return scenario->getMarketplace()->getMarketInfo( aGoodName, aRegionName, aPeriod, aMustExist );
+    }
+    
     /*!
      * \invariant The given good name matches the one that was used when locating this market.
      */
@@ -412,11 +439,6 @@ IInfo* CachedMarket::getMarketInfo( const string& aGoodName, const string& aRegi
      */
     assert( aRegionName == mRegionName );
     
-    /*!
-     * \invariant The given period matches the one that was used when locating this market.
-     */
-    assert( aPeriod == mPeriod );
-    
     IInfo* info = 0;
     if ( mCachedMarket ) {
         info = mCachedMarket->getMarketInfo();
@@ -99,6 +99,10 @@ void Market::copy( const Market& aMarket ) {
     mPrice = aMarket.mPrice;
     mSupply = aMarket.mSupply;
     mDemand = aMarket.mDemand;
+#if GCAM_DETERMINISTIC_SUMS
+    mSupplySum = aMarket.mSupplySum;
+    mDemandSum = aMarket.mDemandSum;
+#endif
     mForecastPrice = aMarket.mForecastPrice;
     mForecastDemand = aMarket.mForecastDemand;
     mOriginal_price = aMarket.mOriginal_price;
@@ -317,6 +321,9 @@ double Market::getRawPrice() const {
 */
 void Market::nullDemand() {
     mDemand = 0;
+#if GCAM_DETERMINISTIC_SUMS
+    mDemandSum.reset();
+#endif
 }
 
 /*! \brief Add to the the Market an amount of demand in a method based on the
@@ -326,8 +333,12 @@ void Market::nullDemand() {
 * \sa setRawDemand
 */
 void Market::addToDemand( const double demandIn ) {
-#if GCAM_PARALLEL_ENABLED
-    if( !Marketplace::mIsDerivativeCalc ) {
+#if GCAM_DETERMINISTIC_SUMS
+    mDemandSum.add( demandIn );
+#elif GCAM_PARALLEL_ENABLED
+    // Partial derivatives only need to be protected when the flow graph is
+    // used within each partial as otherwise each has its own scratch state.
+    if( !Marketplace::mIsDerivativeCalc || Marketplace::mIsParallelDerivativeCalc ) {
         Mutex::scoped_lock writeLock( mDemandMutex, true );
         mDemand += demandIn;
     }
@@ -347,7 +358,9 @@ void Market::addToDemand( const double demandIn ) {
 * \sa getDemand
 */
 double Market::getRawDemand() const {
-#if GCAM_PARALLEL_ENABLED
+#if GCAM_DETERMINISTIC_SUMS
+    return mDemandSum.get();
+#elif GCAM_PARALLEL_ENABLED
     if( !Marketplace::mIsDerivativeCalc ) {
         Mutex::scoped_lock readLock( mDemandMutex, false );
         return mDemand;
@@ -368,7 +381,9 @@ double Market::getRawDemand() const {
  * \sa getRawDemand
  */
 double Market::getSolverDemand() const {
-#if GCAM_PARALLEL_ENABLED
+#if GCAM_DETERMINISTIC_SUMS
+    return mDemandSum.get();
+#elif GCAM_PARALLEL_ENABLED
     if( !Marketplace::mIsDerivativeCalc ) {
         Mutex::scoped_lock readLock( mDemandMutex, false );
         return mDemand;
@@ -386,7 +401,9 @@ double Market::getSolverDemand() const {
 * \return Market demand.
 */
 double Market::getDemand() const {
-#if GCAM_PARALLEL_ENABLED
+#if GCAM_DETERMINISTIC_SUMS
+    return mDemandSum.get();
+#elif GCAM_PARALLEL_ENABLED
     if( !Marketplace::mIsDerivativeCalc ) {
         Mutex::scoped_lock readLock( mDemandMutex, false );
         return mDemand;
@@ -404,6 +421,9 @@ double Market::getDemand() const {
 */
 void Market::nullSupply() {
     mSupply = 0;
+#if GCAM_DETERMINISTIC_SUMS
+    mSupplySum.reset();
+#endif
 }
 
 /*! \brief Get the raw supply.
@@ -414,7 +434,9 @@ void Market::nullSupply() {
 * \sa getSupply
 */
 double Market::getRawSupply() const {
-#if GCAM_PARALLEL_ENABLED
+#if GCAM_DETERMINISTIC_SUMS
+    return mSupplySum.get();
+#elif GCAM_PARALLEL_ENABLED
     if( !Marketplace::mIsDerivativeCalc ) {
         Mutex::scoped_lock readLock( mSupplyMutex, false );
         return mSupply;
@@ -436,7 +458,9 @@ double Market::getRawSupply() const {
 * \sa getRawSupply
 */
 double Market::getSolverSupply() const {
-#if GCAM_PARALLEL_ENABLED
+#if GCAM_DETERMINISTIC_SUMS
+    return mSupplySum.get();
+#elif GCAM_PARALLEL_ENABLED
     if( !Marketplace::mIsDerivativeCalc ) {
         Mutex::scoped_lock readLock( mSupplyMutex, false );
         return mSupply;
@@ -454,7 +478,9 @@ double Market::getSolverSupply() const {
 * \return Market supply
 */
 double Market::getSupply() const {
-#if GCAM_PARALLEL_ENABLED
+#if GCAM_DETERMINISTIC_SUMS
+    return mSupplySum.get();
+#elif GCAM_PARALLEL_ENABLED
     if( !Marketplace::mIsDerivativeCalc ) {
         Mutex::scoped_lock readLock( mSupplyMutex, false );
         return mSupply;
@@ -474,8 +500,12 @@ double Market::getSupply() const {
 * \sa setRawSupply
 */
 void Market::addToSupply( const double supplyIn ) {
-#if GCAM_PARALLEL_ENABLED
-    if( !Marketplace::mIsDerivativeCalc ) {
+#if GCAM_DETERMINISTIC_SUMS
+    mSupplySum.add( supplyIn );
+#elif GCAM_PARALLEL_ENABLED
+    // Partial derivatives only need to be protected when the flow graph is
+    // used within each partial as otherwise each has its own scratch state.
+    if( !Marketplace::mIsDerivativeCalc || Marketplace::mIsParallelDerivativeCalc ) {
         Mutex::scoped_lock writeLock( mSupplyMutex, true );
         mSupply += supplyIn;
     }
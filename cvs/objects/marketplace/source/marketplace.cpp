@@ -42,6 +42,7 @@
 
 #include <vector>
 #include <iomanip>
+#include <boost/algorithm/string.hpp>
 
 #if GCAM_PARALLEL_ENABLED
 #include <tbb/parallel_for.h>
@@ -63,6 +64,9 @@
 #include "containers/include/iinfo.h"
 #include "marketplace/include/cached_market.h"
 #include "containers/include/market_dependency_finder.h"
+#include "marketplace/include/prior_trial_price_forecaster.h"
+#include "marketplace/include/reference_price_forecaster.h"
+#include "marketplace/include/trend_price_forecaster.h"
 #include "solution/util/include/ublas-helpers.hpp"
 
 using namespace std;
@@ -70,6 +74,7 @@ using namespace std;
 extern Scenario* scenario;
 const double Marketplace::NO_MARKET_PRICE = util::getLargeNumber();
 bool Marketplace::mIsDerivativeCalc = false;
+bool Marketplace::mIsParallelDerivativeCalc = false;
 
 /*! \brief Default constructor 
 *
@@ -82,6 +87,29 @@ Marketplace::Marketplace():
 mMarketLocator( new MarketLocator() ),
 mDependencyFinder( new MarketDependencyFinder( this ) )
 {
+    // Create the price forecasters listed in order of preference.
+    const string forecasterNames = Configuration::getInstance()->getString( "price-forecast", "", false );
+    vector<string> names;
+    if( !forecasterNames.empty() ) {
+        boost::split( names, forecasterNames, boost::is_any_of( "," ) );
+    }
+    for( auto name : names ) {
+        boost::trim( name );
+        if( name == PriorTrialPriceForecaster::getXMLNameStatic() ) {
+            mForecasters.push_back( new PriorTrialPriceForecaster() );
+        }
+        else if( name == ReferencePriceForecaster::getXMLNameStatic() ) {
+            mForecasters.push_back( new ReferencePriceForecaster() );
+        }
+        else if( name == TrendPriceForecaster::getXMLNameStatic() ) {
+            mForecasters.push_back( new TrendPriceForecaster() );
+        }
+        else {
+            ILogger& mainLog = ILogger::getLogger( "main_log" );
+            mainLog.setLevel( ILogger::WARNING );
+            mainLog << "Unknown price forecast: " << name << endl;
+        }
+    }
 }
 
 /*! \brief Destructor
@@ -94,6 +122,9 @@ Marketplace::~Marketplace() {
         delete marketContainer;
     }
     mMarkets.clear();
+    for( auto forecaster : mForecasters ) {
+        delete forecaster;
+    }
 }
 
 /*! \brief Get the XML node name in static form for outputting XML.
@@ -683,7 +714,8 @@ vector<Market*> Marketplace::getMarketsToSolve( const int period ) const {
  *          are calibrated prices and should not be reset. After calibration we
  *          attempt to use the trend in prices to forecast prices ( and demands )
  *          to come up with a good guess that would be closer to the solution.
- *          This only occurs for periods greater than 0.
+ *          This only occurs for periods greater than 0.  Any configured price
+ *          forecasters, see IPriceForecaster, are tried before the trend.
  * \author Sonny Kim
  * \param period Period for which to initialize prices.
  */
@@ -707,11 +739,19 @@ void Marketplace::init_to_last( const int period ) {
     }
     else {
         for ( unsigned int i = 0; i < mMarkets.size(); i++ ) {
-            double forecastedPrice = mMarkets[ i ]->forecastPrice( period );
+            double forecastedPrice;
+            bool shouldCheckForecast = true;
+            if( forecastPrice( i, period, forecastedPrice, shouldCheckForecast ) ) {
+                mMarkets[ i ]->getMarket( period )->setForecastPrice( forecastedPrice );
+            }
+            else {
+                forecastedPrice = mMarkets[ i ]->forecastPrice( period );
+            }
             double lastPeriodPrice = mMarkets[ i ]->getMarket( period - 1 )->getPrice();
             // Only use the forecast price if it is reliable.
-            if( (forecastedPrice < 0.0 && lastPeriodPrice > 0.0) ||
-                abs( forecastedPrice ) > 5.0 * abs( lastPeriodPrice ) )
+            if( shouldCheckForecast &&
+                ( (forecastedPrice < 0.0 && lastPeriodPrice > 0.0) ||
+                  abs( forecastedPrice ) > 5.0 * abs( lastPeriodPrice ) ) )
             {
                 mMarkets[ i ]->getMarket( period )->set_price_to_last( lastPeriodPrice );
             }
@@ -725,6 +765,65 @@ void Marketplace::init_to_last( const int period ) {
     }
 }
 
+/*!
+ * \brief Ask each of the configured price forecasters in turn for a forecast of
+ *        the price of a market.
+ * \param aMarketNumber The market to forecast.
+ * \param aPeriod The period to forecast.
+ * \param aForecastPrice Set to the first forecast given.
+ * \param aShouldCheckForecast Set to whether the forecast given should be checked
+ *                             against the previous period's price.
+ * \return Whether any forecaster gave a forecast.
+ */
+bool Marketplace::forecastPrice( const int aMarketNumber, const int aPeriod, double& aForecastPrice,
+                                 bool& aShouldCheckForecast ) const
+{
+    for( auto forecaster : mForecasters ) {
+        if( forecaster->forecastPrice( aMarketNumber, mMarkets[ aMarketNumber ], aPeriod, aForecastPrice ) ) {
+            aShouldCheckForecast = forecaster->shouldCheckForecast();
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * \brief Whether prices are forecast from the solutions of earlier runs in
+ *        this process.
+ * \details If so the result of a run may depend on the runs which came before
+ *          it.
+ * \return True if the prior-trial forecaster is in use.
+ */
+bool Marketplace::forecastsFromPriorTrials() const {
+    for( auto forecaster : mForecasters ) {
+        if( forecaster->getName() == PriorTrialPriceForecaster::getXMLNameStatic() ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * \brief Let the price forecasters record the solution of a period.
+ * \param aPeriod The period which was just solved.
+ */
+void Marketplace::storeSolution( const int aPeriod ) {
+    for( auto forecaster : mForecasters ) {
+        forecaster->storeSolution( mMarkets, aPeriod );
+    }
+}
+
+/*!
+ * \brief Write the prices of the solved markets so that they may be used to
+ *        forecast the prices of another scenario.
+ * \param aOut The stream to write to.
+ * \param aIsValidPeriod Which periods have been solved.
+ * \sa ReferencePriceForecaster
+ */
+void Marketplace::writeSolvedPrices( ostream& aOut, const vector<bool>& aIsValidPeriod ) const {
+    ReferencePriceForecaster::writeSolvedPrices( mMarkets, aIsValidPeriod, aOut );
+}
+
 /*! \brief Store market prices for policy cost caluclation.
 *
 *
@@ -853,14 +952,13 @@ IInfo* Marketplace::getMarketInfo( const string& aGoodName, const string& aRegio
  *         be a valid object regardless of if the market was not found.
  * \see CachedMarket
  */
-auto_ptr<CachedMarket> Marketplace::locateMarket( const string& aGoodName, const string& aRegionName,
-                                                  const int aPeriod ) const
+CachedMarket Marketplace::locateMarket( const string& aGoodName, const string& aRegionName,
+                                       const int aPeriod ) const
 {
     const int marketNumber = mMarketLocator->getMarketNumber( aRegionName, aGoodName );
-    auto_ptr<CachedMarket> locatedMarket( new CachedMarket( aGoodName, aRegionName, aPeriod,
-                                                            marketNumber != MarketLocator::MARKET_NOT_FOUND ?
-                                                            mMarkets[ marketNumber ]->getMarket( aPeriod ) : 0 ) );
-    return locatedMarket;
+    return CachedMarket( aGoodName, aRegionName, aPeriod,
+                         marketNumber != MarketLocator::MARKET_NOT_FOUND ?
+                         mMarkets[ marketNumber ]->getMarket( aPeriod ) : 0 );
 }
 
 /*! \brief Update an output container for the Marketplace.
@@ -897,6 +995,14 @@ MarketDependencyFinder* Marketplace::getDependencyFinder() const {
     return mDependencyFinder.get();
 }
 
+/*!
+ * \brief Get the number of markets that have been created.
+ * \return The number of markets.
+ */
+int Marketplace::getNumMarkets() const {
+    return static_cast<int>( mMarkets.size() );
+}
+
 /*!
  * \brief Get the full state of the marketplace.
  * \param period The model period.
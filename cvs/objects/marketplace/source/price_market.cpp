@@ -90,6 +90,9 @@ void PriceMarket::initPrice() {
 */
 void PriceMarket::setPrice( const double priceIn ) {
     mDemand = priceIn;
+#if GCAM_DETERMINISTIC_SUMS
+    mDemandSum.set( priceIn );
+#endif
 }
 
 void PriceMarket::set_price_to_last_if_default( const double lastPrice ) {
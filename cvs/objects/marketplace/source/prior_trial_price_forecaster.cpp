@@ -0,0 +1,87 @@
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+/*!
+ * \file prior_trial_price_forecaster.cpp
+ * \ingroup Objects
+ * \brief PriorTrialPriceForecaster class source file.
+ */
+
+#include "util/base/include/definitions.h"
+#include <cmath>
+#include <limits>
+#include "marketplace/include/prior_trial_price_forecaster.h"
+#include "marketplace/include/market_container.h"
+#include "marketplace/include/market.h"
+
+using namespace std;
+
+const string& PriorTrialPriceForecaster::getXMLNameStatic() {
+    const static string XML_NAME = "prior-trial";
+    return XML_NAME;
+}
+
+const string& PriorTrialPriceForecaster::getName() const {
+    return getXMLNameStatic();
+}
+
+bool PriorTrialPriceForecaster::forecastPrice( const int aMarketNumber, const MarketContainer* aMarket,
+                                               const int aPeriod, double& aForecastPrice ) const
+{
+    auto periodIter = mSolvedPrices.find( aPeriod );
+    // Markets created since the period was solved will not have a price.
+    if( periodIter == mSolvedPrices.end() || aMarketNumber >= (*periodIter).second.size() ||
+        std::isnan( (*periodIter).second[ aMarketNumber ] ) )
+    {
+        return false;
+    }
+    aForecastPrice = (*periodIter).second[ aMarketNumber ];
+    return true;
+}
+
+bool PriorTrialPriceForecaster::shouldCheckForecast() const {
+    return false;
+}
+
+void PriorTrialPriceForecaster::storeSolution( const vector<MarketContainer*>& aMarkets,
+                                               const int aPeriod )
+{
+    vector<double>& solvedPrices = mSolvedPrices[ aPeriod ];
+    solvedPrices.assign( aMarkets.size(), numeric_limits<double>::quiet_NaN() );
+    for( size_t marketInd = 0; marketInd < aMarkets.size(); ++marketInd ) {
+        const Market* market = aMarkets[ marketInd ]->getMarket( aPeriod );
+        if( market->isSolvable() ) {
+            solvedPrices[ marketInd ] = market->getRawPrice();
+        }
+    }
+}
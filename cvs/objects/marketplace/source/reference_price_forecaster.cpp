@@ -0,0 +1,149 @@
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+/*!
+ * \file reference_price_forecaster.cpp
+ * \ingroup Objects
+ * \brief ReferencePriceForecaster class source file.
+ */
+
+#include "util/base/include/definitions.h"
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <cstdlib>
+#include "marketplace/include/reference_price_forecaster.h"
+#include "marketplace/include/market_container.h"
+#include "marketplace/include/market.h"
+#include "util/base/include/model_time.h"
+#include "util/base/include/configuration.h"
+#include "util/logger/include/ilogger.h"
+
+using namespace std;
+
+/*!
+ * \brief Constructor which reads the reference prices.
+ * \details Each line of the file after the header is the region, good, year and
+ *          price of a market separated by commas.  The good is taken as everything
+ *          between the first and the second to last comma.
+ */
+ReferencePriceForecaster::ReferencePriceForecaster() {
+    const string fileName = Configuration::getInstance()->getFile( "reference-prices", "", false );
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    ifstream inFile( fileName.c_str() );
+    if( !inFile.is_open() ) {
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "Could not open reference prices: " << fileName << endl;
+        return;
+    }
+    
+    string line;
+    // skip the header
+    getline( inFile, line );
+    int numPrices = 0;
+    while( getline( inFile, line ) ) {
+        const size_t goodStart = line.find( ',' );
+        const size_t priceStart = line.rfind( ',' );
+        const size_t yearStart = priceStart == string::npos || priceStart == 0 ?
+            string::npos : line.rfind( ',', priceStart - 1 );
+        if( goodStart == string::npos || yearStart == string::npos || yearStart <= goodStart ) {
+            continue;
+        }
+        const string marketName = line.substr( 0, goodStart ) + line.substr( goodStart + 1, yearStart - goodStart - 1 );
+        const int year = atoi( line.c_str() + yearStart + 1 );
+        mPrices[ marketName ][ year ] = atof( line.c_str() + priceStart + 1 );
+        ++numPrices;
+    }
+    mainLog.setLevel( ILogger::NOTICE );
+    mainLog << "Read " << numPrices << " reference prices for " << mPrices.size()
+            << " markets from " << fileName << endl;
+}
+
+const string& ReferencePriceForecaster::getXMLNameStatic() {
+    const static string XML_NAME = "reference";
+    return XML_NAME;
+}
+
+/*!
+ * \brief Write the prices of all solved markets in a format which can be read
+ *        back as reference prices.
+ * \param aMarkets All of the markets in the Marketplace.
+ * \param aIsValidPeriod Which periods have been solved.
+ * \param aOut The stream to write to.
+ */
+void ReferencePriceForecaster::writeSolvedPrices( const vector<MarketContainer*>& aMarkets,
+                                                  const vector<bool>& aIsValidPeriod,
+                                                  ostream& aOut )
+{
+    const Modeltime* modeltime = Modeltime::getInstance();
+    aOut << "region,good,year,price" << endl;
+    aOut << setprecision( numeric_limits<double>::max_digits10 );
+    for( auto marketContainer : aMarkets ) {
+        for( int period = 0; period < aIsValidPeriod.size(); ++period ) {
+            const Market* market = marketContainer->getMarket( period );
+            if( aIsValidPeriod[ period ] && market->isSolvable() ) {
+                aOut << marketContainer->getRegionName() << ',' << marketContainer->getGoodName() << ','
+                     << modeltime->getper_to_yr( period ) << ',' << market->getRawPrice() << '\n';
+            }
+        }
+    }
+}
+
+const string& ReferencePriceForecaster::getName() const {
+    return getXMLNameStatic();
+}
+
+bool ReferencePriceForecaster::forecastPrice( const int aMarketNumber, const MarketContainer* aMarket,
+                                              const int aPeriod, double& aForecastPrice ) const
+{
+    auto marketIter = mPrices.find( aMarket->getName() );
+    if( marketIter == mPrices.end() ) {
+        return false;
+    }
+    auto yearIter = (*marketIter).second.find( Modeltime::getInstance()->getper_to_yr( aPeriod ) );
+    if( yearIter == (*marketIter).second.end() ) {
+        return false;
+    }
+    aForecastPrice = (*yearIter).second;
+    return true;
+}
+
+bool ReferencePriceForecaster::shouldCheckForecast() const {
+    return false;
+}
+
+void ReferencePriceForecaster::storeSolution( const vector<MarketContainer*>& aMarkets,
+                                              const int aPeriod )
+{
+    // The reference prices do not change.
+}
@@ -0,0 +1,113 @@
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+/*!
+ * \file trend_price_forecaster.cpp
+ * \ingroup Objects
+ * \brief TrendPriceForecaster class source file.
+ */
+
+#include "util/base/include/definitions.h"
+#include "marketplace/include/trend_price_forecaster.h"
+#include "marketplace/include/market_container.h"
+#include "marketplace/include/market.h"
+#include "util/base/include/model_time.h"
+#include "util/base/include/configuration.h"
+#include "util/base/include/util.h"
+
+using namespace std;
+
+//! Constructor
+TrendPriceForecaster::TrendPriceForecaster():
+mNumPeriods( max( Configuration::getInstance()->getInt( "price-forecast-trend-periods", 4, false ), 2 ) )
+{
+}
+
+const string& TrendPriceForecaster::getXMLNameStatic() {
+    const static string XML_NAME = "trend";
+    return XML_NAME;
+}
+
+const string& TrendPriceForecaster::getName() const {
+    return getXMLNameStatic();
+}
+
+bool TrendPriceForecaster::forecastPrice( const int aMarketNumber, const MarketContainer* aMarket,
+                                          const int aPeriod, double& aForecastPrice ) const
+{
+    // Need at least two periods of history to fit a trend.
+    const int firstPeriod = max( aPeriod - mNumPeriods, 0 );
+    if( aPeriod - firstPeriod < 2 ) {
+        return false;
+    }
+    
+    // Least squares fit of price against year centered on the mean year to
+    // keep the sums well conditioned.
+    const Modeltime* modeltime = Modeltime::getInstance();
+    double meanYear = 0.0;
+    double meanPrice = 0.0;
+    for( int period = firstPeriod; period < aPeriod; ++period ) {
+        const double price = aMarket->getMarket( period )->getRawPrice();
+        if( price < util::getTinyNumber() ) {
+            // The market has only recently come into use, leave it to the
+            // default forecast.
+            return false;
+        }
+        meanYear += modeltime->getper_to_yr( period );
+        meanPrice += price;
+    }
+    const int numPoints = aPeriod - firstPeriod;
+    meanYear /= numPoints;
+    meanPrice /= numPoints;
+    
+    double sumXY = 0.0;
+    double sumXX = 0.0;
+    for( int period = firstPeriod; period < aPeriod; ++period ) {
+        const double x = modeltime->getper_to_yr( period ) - meanYear;
+        sumXY += x * ( aMarket->getMarket( period )->getRawPrice() - meanPrice );
+        sumXX += x * x;
+    }
+    const double slope = sumXY / sumXX;
+    aForecastPrice = meanPrice + slope * ( modeltime->getper_to_yr( aPeriod ) - meanYear );
+    return true;
+}
+
+bool TrendPriceForecaster::shouldCheckForecast() const {
+    return true;
+}
+
+void TrendPriceForecaster::storeSolution( const vector<MarketContainer*>& aMarkets,
+                                          const int aPeriod )
+{
+    // The trend only uses the prices held in the markets.
+}
@@ -277,6 +277,17 @@ public:
       return true;
   }
 
+  //! Test whether this set has any members in common with another set
+  //! \details Equivalent to !setintersection(A,B).empty(), but
+  //!          without making a copy of either set.
+  //! \warning As always, we don't check for length compatibility
+  bool intersects(const bitvector &bv) const {
+    for(unsigned i=0; i<dsize; ++i)
+      if(data[i] & bv.data[i])
+        return true;
+    return false;
+  }
+
   //! Equality comparison
   bool operator==(const bitvector &bv) const {
     for(unsigned i=0; i<dsize; ++i)
@@ -37,6 +37,7 @@
 
 /* standard headers */
 #include <list>
+#include <string>
 #include <set>
 
 /* graph analysis headers */
@@ -59,7 +60,7 @@ class GcamFlowGraph {
     friend class MarketDependencyFinder;
 private:
     //! Private constructor to only allow select classes to create flow graphs.
-    GcamFlowGraph() : mTBBFlowGraph(), mHead( mTBBFlowGraph ), mPeriod( 0 ), mCalcList( 0 ) {}
+    GcamFlowGraph() : mTBBFlowGraph(), mHead( mTBBFlowGraph ), mPeriod( 0 ), mCalcList( 0 ), mStateData( 0 ) {}
     
     //! The TBB calculation flow graph.
     tbb::flow::graph mTBBFlowGraph;
@@ -75,6 +76,11 @@ private:
     //! not be calculated for sub-graphs.  Note when null it implies all activities
     //! will be calculated.
     const std::vector<IActivity*>* mCalcList;
+    
+    //! The state the thread which started the calculation was bound to, which
+    //! each node binds before calculating its activities.  Null implies the
+    //! "base" state.
+    double* mStateData;
 };
 
 /*!
@@ -144,6 +150,10 @@ protected:
         
         //! A reference to the TBB flow graph to which this node belongs.
         const GcamFlowGraph& mGraph;
+        
+        //! A description of this grain, matching the parallel-grain-log, to
+        //! label it in traces.
+        std::string mDescription;
     };
     
     /* data members */
@@ -32,6 +32,7 @@
 
 #if GCAM_PARALLEL_ENABLED
 #include <map>
+#include <sstream>
 /* gcam headers */
 #include "parallel/include/gcam_parallel.hpp"
 #include "util/base/include/configuration.h"
@@ -40,7 +41,9 @@
 #include "containers/include/market_dependency_finder.h"
 #include "util/logger/include/ilogger.h"
 #include "util/base/include/timer.h"
+#include "util/base/include/trace_recorder.h"
 #include "util/base/include/auto_file.h"
+#include "util/base/include/manage_state_variables.hpp"
 /* more graph analysis headers */
 #include "parallel/include/clanid.hpp"
 #include "parallel/include/graph-parse.hpp"
@@ -319,15 +322,24 @@ void GcamParallel::makeTBBFlowGraph( const FlowGraph& aGrainGraph, const FlowGra
 
 void GcamParallel::TBBFlowGraphBody::operator()( tbb::flow::continue_msg aMessage )
 {
+    // Calculate in the same state as the thread which started the graph.  Note
+    // we restore the previous binding in case TBB is running this node while the
+    // thread is waiting on some other task.
+    double* prevState = ManageStateVariables::getThreadState();
+    ManageStateVariables::setThreadState( mGraph.mStateData );
+    const bool isTracing = TraceRecorder::isEnabled();
+    TraceScope grainScope( "grain", mDescription );
     for( list<FlowGraphNodeType>::const_iterator nodeIt = mNodes.begin();
          nodeIt != mNodes.end(); ++nodeIt )
     {
         if( !mGraph.mCalcList ||
             find( mGraph.mCalcList->begin(), mGraph.mCalcList->end(), *nodeIt ) != mGraph.mCalcList->end() )
         {
+            TraceScope activityScope( "activity", isTracing ? (*nodeIt)->getDescription() : string() );
             (*nodeIt)->calc( mGraph.mPeriod );
         }
     }
+    ManageStateVariables::setThreadState( prevState );
 }
 
 GcamParallel::TBBFlowGraphBody::TBBFlowGraphBody( const std::set<FlowGraphNodeType>& aNodes,
@@ -351,6 +363,9 @@ GcamParallel::TBBFlowGraphBody::TBBFlowGraphBody( const std::set<FlowGraphNodeTy
     // structure (this allows us to see what is in the grains, but not
     // the relationships between grains)
     pgLog << "\nGrain id: " << this << "   size:  " << mNodes.size() << "  Contents:";
+    ostringstream description;
+    description << "grain " << this << " size " << mNodes.size();
+    mDescription = description.str();
     int i = 0;
     for( list<FlowGraphNodeType>::const_iterator it = mNodes.begin(); it != mNodes.end(); ++it ) {
         if( i % 3 == 0 ) {
@@ -63,6 +63,8 @@ public:
 
     void writeDidScenarioSolve( bool aDidSolve );
 
+    void setIsFirstScenario( const bool aIsFirstScenario );
+
     //! IVisitor methods
     void startVisitScenario( const Scenario* aScenario, const int aPeriod );
 
@@ -0,0 +1,199 @@
+#ifndef _COLUMNAR_OUTPUTTER_H_
+#define _COLUMNAR_OUTPUTTER_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file columnar_outputter.h
+ * \ingroup Objects
+ * \brief The ColumnarOutputter class header file.
+ */
+
+#include <string>
+#include <vector>
+#include <map>
+#include <iosfwd>
+#include <stdint.h>
+
+#include "util/base/include/default_visitor.h"
+
+class Modeltime;
+
+/*!
+ * \ingroup Objects
+ * \brief A visitor which collects model results into typed columns which can
+ *        be written as a compact binary table or as CSV.
+ * \details Each row is a single value identified by the scenario, region,
+ *          sector, subsector, technology, technology vintage, variable, item
+ *          (an input, output, gas, market good or land leaf name), and year.
+ *          Columns which do not apply to a row are left empty or zero.  String
+ *          columns are dictionary encoded so the repetitive identifiers cost
+ *          little more than a four byte index per row.  Unlike the
+ *          XMLDBOutputter no Java virtual machine is required which makes this
+ *          outputter suitable for large batches of scenarios.  Output is
+ *          enabled by the Files configuration values columnar-output and
+ *          columnar-csv-output.
+ */
+class ColumnarOutputter : public DefaultVisitor {
+public:
+    ColumnarOutputter();
+
+    ~ColumnarOutputter();
+
+    static bool isEnabled();
+
+    void finish() const;
+
+    void writeBinary( std::ostream& aOut, const bool aCompress ) const;
+
+    void writeCSV( std::ostream& aOut ) const;
+
+    size_t getNumRows() const;
+
+    // DefaultVisitor methods.
+    virtual void startVisitScenario( const Scenario* aScenario, const int aPeriod );
+
+    virtual void startVisitRegion( const Region* aRegion, const int aPeriod );
+
+    virtual void endVisitRegion( const Region* aRegion, const int aPeriod );
+
+    virtual void startVisitResource( const AResource* aResource, const int aPeriod );
+
+    virtual void endVisitResource( const AResource* aResource, const int aPeriod );
+
+    virtual void startVisitSector( const Sector* aSector, const int aPeriod );
+
+    virtual void endVisitSector( const Sector* aSector, const int aPeriod );
+
+    virtual void startVisitSubsector( const Subsector* aSubsector, const int aPeriod );
+
+    virtual void endVisitSubsector( const Subsector* aSubsector, const int aPeriod );
+
+    virtual void startVisitTechnology( const Technology* aTechnology, const int aPeriod );
+
+    virtual void endVisitTechnology( const Technology* aTechnology, const int aPeriod );
+
+    virtual void startVisitInput( const IInput* aInput, const int aPeriod );
+
+    virtual void startVisitOutput( const IOutput* aOutput, const int aPeriod );
+
+    virtual void startVisitGHG( const AGHG* aGHG, const int aPeriod );
+
+    virtual void startVisitMarket( const Market* aMarket, const int aPeriod );
+
+    virtual void startVisitClimateModel( const IClimateModel* aClimateModel, const int aPeriod );
+
+    virtual void startVisitPopulation( const Population* aPopulation, const int aPeriod );
+
+    virtual void startVisitGDP( const GDP* aGDP, const int aPeriod );
+
+    virtual void startVisitLandLeaf( const LandLeaf* aLandLeaf, const int aPeriod );
+
+private:
+    /*!
+     * \brief A dictionary encoded string column.
+     * \details Each distinct string is stored once in the dictionary and each
+     *          row stores the index of its string in the dictionary.
+     */
+    struct StringColumn {
+        //! The distinct strings in the order they were first added.
+        std::vector<std::string> mDictionary;
+
+        //! Map from a string to its index in the dictionary.
+        std::map<std::string, uint32_t> mLookup;
+
+        //! The dictionary index of each row.
+        std::vector<uint32_t> mIndices;
+
+        void add( const std::string& aValue );
+    };
+
+    //! The type codes of the columns as written to the binary file.
+    enum ColumnType {
+        STRING_COLUMN = 0,
+        INT_COLUMN = 1,
+        DOUBLE_COLUMN = 2
+    };
+
+    //! The modeltime of the scenario being written.
+    const Modeltime* mModeltime;
+
+    //! The technology currently being visited or null outside of a technology.
+    const Technology* mCurrentTechnology;
+
+    //! The name of the current scenario.
+    std::string mCurrentScenario;
+
+    //! The name of the current region.
+    std::string mCurrentRegion;
+
+    //! The name of the current sector or resource.
+    std::string mCurrentSector;
+
+    //! The name of the current subsector.
+    std::string mCurrentSubsector;
+
+    //! The name of the current technology.
+    std::string mCurrentTechnologyName;
+
+    //! The vintage year of the current technology or zero if not in a technology.
+    int mCurrentVintage;
+
+    StringColumn mScenarioColumn;
+    StringColumn mRegionColumn;
+    StringColumn mSectorColumn;
+    StringColumn mSubsectorColumn;
+    StringColumn mTechnologyColumn;
+    std::vector<int32_t> mVintageColumn;
+    StringColumn mVariableColumn;
+    StringColumn mItemColumn;
+    std::vector<int32_t> mYearColumn;
+    std::vector<double> mValueColumn;
+
+    void addRow( const std::string& aVariable, const std::string& aItem,
+                 const int aYear, const double aValue );
+
+    int getLastPeriod( const int aPeriod ) const;
+
+    bool isTechnologyOperating( const int aPeriod ) const;
+
+    static std::string getOutputFileName( const std::string& aConfVariableName,
+                                          const std::string& aDefaultName );
+};
+
+#endif // _COLUMNAR_OUTPUTTER_H_
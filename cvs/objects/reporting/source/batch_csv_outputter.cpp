@@ -178,3 +178,14 @@ void BatchCSVOutputter::startVisitClimateModel( const IClimateModel* aClimateMod
 void BatchCSVOutputter::writeDidScenarioSolve( bool aDidSolve ) {
     mFile << aDidSolve << endl;
 }
+
+/*!
+ * \brief Set whether the next scenario visited is the first to be written and
+ *        so must write the header.
+ * \details Used when scenarios are written from separate processes which each
+ *          hold a copy of this outputter.
+ * \param aIsFirstScenario Whether the header should be written.
+ */
+void BatchCSVOutputter::setIsFirstScenario( const bool aIsFirstScenario ) {
+    mIsFirstScenario = aIsFirstScenario;
+}
@@ -0,0 +1,517 @@
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file columnar_outputter.cpp
+ * \ingroup Objects
+ * \brief The ColumnarOutputter class source file.
+ */
+
+#include "util/base/include/definitions.h"
+
+#include <cstring>
+#include <ostream>
+#if USE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "reporting/include/columnar_outputter.h"
+#include "containers/include/scenario.h"
+#include "containers/include/region.h"
+#include "containers/include/gdp.h"
+#include "resources/include/aresource.h"
+#include "sectors/include/sector.h"
+#include "sectors/include/subsector.h"
+#include "technologies/include/technology.h"
+#include "technologies/include/ioutput.h"
+#include "functions/include/iinput.h"
+#include "emissions/include/aghg.h"
+#include "marketplace/include/market.h"
+#include "climate/include/iclimate_model.h"
+#include "demographics/include/population.h"
+#include "land_allocator/include/land_leaf.h"
+#include "util/base/include/model_time.h"
+#include "util/base/include/configuration.h"
+#include "util/base/include/auto_file.h"
+#include "util/base/include/util.h"
+#include "util/logger/include/ilogger.h"
+
+using namespace std;
+
+namespace {
+    //! The magic bytes which start a columnar output file, including the format version.
+    const char COLUMNAR_MAGIC[ 8 ] = { 'G', 'C', 'A', 'M', 'C', 'O', 'L', '1' };
+
+    //! Column block flag indicating the column data is compressed with zlib.
+    const uint32_t COLUMN_COMPRESSED = 1;
+
+    //! The region name used for results which are not specific to a region.
+    const string GLOBAL_REGION = "global";
+
+    /*!
+     * \brief Append the raw bytes of a value to a buffer.
+     * \param aBuffer The buffer to append to.
+     * \param aData The start of the bytes to append.
+     * \param aSize The number of bytes to append.
+     */
+    void appendBytes( vector<char>& aBuffer, const void* aData, const size_t aSize ) {
+        const char* data = static_cast<const char*>( aData );
+        aBuffer.insert( aBuffer.end(), data, data + aSize );
+    }
+
+    /*!
+     * \brief Write a column header and its data, compressing the data if requested.
+     * \details The header is the length of the column name, the name, the
+     *          column type, the block flags, the uncompressed size of the data
+     *          and the size of the data as stored.  If compression fails or
+     *          does not reduce the size the data is stored uncompressed.
+     * \param aOut The stream to write to.
+     * \param aName The column name.
+     * \param aType The column type code.
+     * \param aData The uncompressed column data.
+     * \param aCompress Whether to attempt to compress the column data.
+     */
+    void writeColumn( ostream& aOut, const string& aName, const uint32_t aType,
+                      const vector<char>& aData, const bool aCompress )
+    {
+        uint32_t flags = 0;
+        const uint64_t rawSize = aData.size();
+        const char* storedData = aData.data();
+        uint64_t storedSize = rawSize;
+#if USE_ZLIB
+        vector<char> compressedData;
+        if( aCompress && rawSize > 0 ) {
+            uLongf compressedSize = compressBound( rawSize );
+            compressedData.resize( compressedSize );
+            if( compress2( reinterpret_cast<Bytef*>( compressedData.data() ), &compressedSize,
+                           reinterpret_cast<const Bytef*>( aData.data() ), rawSize, Z_BEST_SPEED ) == Z_OK
+                && compressedSize < rawSize )
+            {
+                flags |= COLUMN_COMPRESSED;
+                storedData = compressedData.data();
+                storedSize = compressedSize;
+            }
+        }
+#endif
+        const uint32_t nameLength = aName.size();
+        aOut.write( reinterpret_cast<const char*>( &nameLength ), sizeof( uint32_t ) );
+        aOut.write( aName.data(), nameLength );
+        aOut.write( reinterpret_cast<const char*>( &aType ), sizeof( uint32_t ) );
+        aOut.write( reinterpret_cast<const char*>( &flags ), sizeof( uint32_t ) );
+        aOut.write( reinterpret_cast<const char*>( &rawSize ), sizeof( uint64_t ) );
+        aOut.write( reinterpret_cast<const char*>( &storedSize ), sizeof( uint64_t ) );
+        aOut.write( storedData, storedSize );
+    }
+
+    /*!
+     * \brief Write a string to a CSV file, quoting it if it contains a
+     *        separator or quote.
+     * \param aOut The stream to write to.
+     * \param aValue The string to write.
+     */
+    void writeCSVString( ostream& aOut, const string& aValue ) {
+        if( aValue.find_first_of( ",\"\n" ) == string::npos ) {
+            aOut << aValue;
+            return;
+        }
+        aOut << '"';
+        for( string::const_iterator it = aValue.begin(); it != aValue.end(); ++it ) {
+            if( *it == '"' ) {
+                aOut << '"';
+            }
+            aOut << *it;
+        }
+        aOut << '"';
+    }
+}
+
+/*! \brief Constructor */
+ColumnarOutputter::ColumnarOutputter():
+mModeltime( 0 ),
+mCurrentTechnology( 0 ),
+mCurrentVintage( 0 )
+{
+}
+
+/*! \brief Destructor */
+ColumnarOutputter::~ColumnarOutputter(){
+}
+
+/*!
+ * \brief Whether the configuration requests any columnar output.
+ * \details Unlike most output files the columnar files are only written when
+ *          explicitly requested.
+ * \return True if either the binary or CSV columnar output should be written.
+ */
+bool ColumnarOutputter::isEnabled() {
+    const Configuration* conf = Configuration::getInstance();
+    return conf->shouldWriteFile( "columnar-output", false, false )
+        || conf->shouldWriteFile( "columnar-csv-output", false, false );
+}
+
+/*!
+ * \brief Write the collected results to the files requested by the configuration.
+ * \details The binary table is written to the Files value columnar-output and
+ *          is compressed unless the configuration value columnar-output-compress
+ *          is false.  The CSV table is written to the Files value
+ *          columnar-csv-output.
+ */
+void ColumnarOutputter::finish() const {
+    const Configuration* conf = Configuration::getInstance();
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    if( conf->shouldWriteFile( "columnar-output", false, false ) ) {
+        bool shouldCompress = conf->getBool( "columnar-output-compress", true, false );
+#if !USE_ZLIB
+        // Only warn if compression was explicitly requested.
+        if( conf->getBool( "columnar-output-compress", false, false ) ) {
+            mainLog.setLevel( ILogger::WARNING );
+            mainLog << "columnar-output-compress requires building with USE_ZLIB, writing uncompressed." << endl;
+        }
+        shouldCompress = false;
+#endif
+        AutoOutputFile binaryFile( getOutputFileName( "columnar-output", "columnar-output.gcol" ),
+                                   ios_base::out | ios_base::binary );
+        writeBinary( *binaryFile, shouldCompress );
+    }
+    if( conf->shouldWriteFile( "columnar-csv-output", false, false ) ) {
+        AutoOutputFile csvFile( getOutputFileName( "columnar-csv-output", "columnar-output.csv" ) );
+        writeCSV( *csvFile );
+    }
+    mainLog.setLevel( ILogger::NOTICE );
+    mainLog << "Wrote " << getNumRows() << " rows of columnar output." << endl;
+}
+
+/*!
+ * \brief Write the collected results as a binary column table.
+ * \details The file starts with the eight bytes GCAMCOL1, the number of columns
+ *          as a uint32 and the number of rows as a uint64.  Each column follows
+ *          as a block described by writeColumn.  String column data is the
+ *          dictionary size as a uint32, each dictionary entry as a uint32
+ *          length followed by its characters, and then a uint32 dictionary
+ *          index for each row.  Integer columns are an int32 per row and value
+ *          columns are a double per row.  As with restart files all numbers
+ *          use the byte order of the machine which wrote them.
+ * \param aOut The stream to write to, which must be opened in binary mode.
+ * \param aCompress Whether to compress the column data with zlib.
+ */
+void ColumnarOutputter::writeBinary( ostream& aOut, const bool aCompress ) const {
+    const StringColumn* stringColumns[] = { &mScenarioColumn, &mRegionColumn, &mSectorColumn,
+        &mSubsectorColumn, &mTechnologyColumn, &mVariableColumn, &mItemColumn };
+    const char* stringColumnNames[] = { "scenario", "region", "sector", "subsector",
+        "technology", "variable", "item" };
+    const size_t numStringColumns = sizeof( stringColumns ) / sizeof( stringColumns[ 0 ] );
+
+    const uint32_t numColumns = numStringColumns + 3;
+    const uint64_t numRows = getNumRows();
+    aOut.write( COLUMNAR_MAGIC, sizeof( COLUMNAR_MAGIC ) );
+    aOut.write( reinterpret_cast<const char*>( &numColumns ), sizeof( uint32_t ) );
+    aOut.write( reinterpret_cast<const char*>( &numRows ), sizeof( uint64_t ) );
+
+    vector<char> data;
+    for( size_t i = 0; i < numStringColumns; ++i ) {
+        const StringColumn* column = stringColumns[ i ];
+        data.clear();
+        const uint32_t dictionarySize = column->mDictionary.size();
+        appendBytes( data, &dictionarySize, sizeof( uint32_t ) );
+        for( vector<string>::const_iterator it = column->mDictionary.begin(); it != column->mDictionary.end(); ++it ) {
+            const uint32_t length = it->size();
+            appendBytes( data, &length, sizeof( uint32_t ) );
+            appendBytes( data, it->data(), length );
+        }
+        appendBytes( data, column->mIndices.data(), sizeof( uint32_t ) * column->mIndices.size() );
+        writeColumn( aOut, stringColumnNames[ i ], STRING_COLUMN, data, aCompress );
+    }
+
+    data.clear();
+    appendBytes( data, mVintageColumn.data(), sizeof( int32_t ) * mVintageColumn.size() );
+    writeColumn( aOut, "vintage", INT_COLUMN, data, aCompress );
+
+    data.clear();
+    appendBytes( data, mYearColumn.data(), sizeof( int32_t ) * mYearColumn.size() );
+    writeColumn( aOut, "year", INT_COLUMN, data, aCompress );
+
+    data.clear();
+    appendBytes( data, mValueColumn.data(), sizeof( double ) * mValueColumn.size() );
+    writeColumn( aOut, "value", DOUBLE_COLUMN, data, aCompress );
+}
+
+/*!
+ * \brief Write the collected results as a CSV table with a header row.
+ * \details A vintage of zero is written as an empty field.
+ * \param aOut The stream to write to.
+ */
+void ColumnarOutputter::writeCSV( ostream& aOut ) const {
+    aOut << "scenario,region,sector,subsector,technology,vintage,variable,item,year,value" << endl;
+    const streamsize oldPrecision = aOut.precision( 17 );
+    for( size_t row = 0; row < getNumRows(); ++row ) {
+        writeCSVString( aOut, mScenarioColumn.mDictionary[ mScenarioColumn.mIndices[ row ] ] );
+        aOut << ',';
+        writeCSVString( aOut, mRegionColumn.mDictionary[ mRegionColumn.mIndices[ row ] ] );
+        aOut << ',';
+        writeCSVString( aOut, mSectorColumn.mDictionary[ mSectorColumn.mIndices[ row ] ] );
+        aOut << ',';
+        writeCSVString( aOut, mSubsectorColumn.mDictionary[ mSubsectorColumn.mIndices[ row ] ] );
+        aOut << ',';
+        writeCSVString( aOut, mTechnologyColumn.mDictionary[ mTechnologyColumn.mIndices[ row ] ] );
+        aOut << ',';
+        if( mVintageColumn[ row ] != 0 ) {
+            aOut << mVintageColumn[ row ];
+        }
+        aOut << ',';
+        writeCSVString( aOut, mVariableColumn.mDictionary[ mVariableColumn.mIndices[ row ] ] );
+        aOut << ',';
+        writeCSVString( aOut, mItemColumn.mDictionary[ mItemColumn.mIndices[ row ] ] );
+        aOut << ',' << mYearColumn[ row ] << ',' << mValueColumn[ row ] << '\n';
+    }
+    aOut.precision( oldPrecision );
+    aOut.flush();
+}
+
+/*!
+ * \brief Get the number of rows collected.
+ * \return The number of rows.
+ */
+size_t ColumnarOutputter::getNumRows() const {
+    return mValueColumn.size();
+}
+
+void ColumnarOutputter::startVisitScenario( const Scenario* aScenario, const int aPeriod ) {
+    mModeltime = aScenario->getModeltime();
+    mCurrentScenario = aScenario->getName();
+}
+
+void ColumnarOutputter::startVisitRegion( const Region* aRegion, const int aPeriod ) {
+    mCurrentRegion = aRegion->getName();
+}
+
+void ColumnarOutputter::endVisitRegion( const Region* aRegion, const int aPeriod ) {
+    mCurrentRegion.clear();
+}
+
+void ColumnarOutputter::startVisitResource( const AResource* aResource, const int aPeriod ) {
+    mCurrentSector = aResource->getName();
+    for( int per = 0; per < mModeltime->getmaxper(); ++per ) {
+        addRow( "production", "", mModeltime->getper_to_yr( per ),
+                aResource->getAnnualProd( mCurrentRegion, per ) );
+    }
+}
+
+void ColumnarOutputter::endVisitResource( const AResource* aResource, const int aPeriod ) {
+    mCurrentSector.clear();
+}
+
+void ColumnarOutputter::startVisitSector( const Sector* aSector, const int aPeriod ) {
+    mCurrentSector = aSector->getName();
+}
+
+void ColumnarOutputter::endVisitSector( const Sector* aSector, const int aPeriod ) {
+    mCurrentSector.clear();
+}
+
+void ColumnarOutputter::startVisitSubsector( const Subsector* aSubsector, const int aPeriod ) {
+    mCurrentSubsector = aSubsector->getName();
+}
+
+void ColumnarOutputter::endVisitSubsector( const Subsector* aSubsector, const int aPeriod ) {
+    mCurrentSubsector.clear();
+}
+
+void ColumnarOutputter::startVisitTechnology( const Technology* aTechnology, const int aPeriod ) {
+    mCurrentTechnology = aTechnology;
+    mCurrentTechnologyName = aTechnology->getName();
+    mCurrentVintage = aTechnology->getYear();
+}
+
+void ColumnarOutputter::endVisitTechnology( const Technology* aTechnology, const int aPeriod ) {
+    mCurrentTechnology = 0;
+    mCurrentTechnologyName.clear();
+    mCurrentVintage = 0;
+}
+
+void ColumnarOutputter::startVisitInput( const IInput* aInput, const int aPeriod ) {
+    // Only technology inputs have a per period physical demand.
+    if( !mCurrentTechnology ) {
+        return;
+    }
+    for( int per = 0; per <= getLastPeriod( aPeriod ); ++per ) {
+        if( !isTechnologyOperating( per ) ) {
+            continue;
+        }
+        // Avoid writing zeros to save space.
+        const double demand = aInput->getPhysicalDemand( per );
+        if( !objects::isEqual<double>( demand, 0.0 ) ) {
+            addRow( "input", aInput->getName(), mModeltime->getper_to_yr( per ), demand );
+        }
+    }
+}
+
+void ColumnarOutputter::startVisitOutput( const IOutput* aOutput, const int aPeriod ) {
+    if( !mCurrentTechnology ) {
+        return;
+    }
+    for( int per = 0; per <= getLastPeriod( aPeriod ); ++per ) {
+        if( !isTechnologyOperating( per ) ) {
+            continue;
+        }
+        const double output = aOutput->getPhysicalOutput( per );
+        if( !objects::isEqual<double>( output, 0.0 ) ) {
+            addRow( "output", aOutput->getName(), mModeltime->getper_to_yr( per ), output );
+        }
+    }
+}
+
+void ColumnarOutputter::startVisitGHG( const AGHG* aGHG, const int aPeriod ) {
+    for( int per = 0; per <= getLastPeriod( aPeriod ); ++per ) {
+        if( !isTechnologyOperating( per ) ) {
+            continue;
+        }
+        const double emissions = aGHG->getEmission( per );
+        if( !objects::isEqual<double>( emissions, 0.0 ) ) {
+            addRow( "emissions", aGHG->getName(), mModeltime->getper_to_yr( per ), emissions );
+        }
+    }
+}
+
+void ColumnarOutputter::startVisitMarket( const Market* aMarket, const int aPeriod ) {
+    // Markets are visited outside of any region so use the market region
+    // instead.
+    const string currRegion = mCurrentRegion;
+    mCurrentRegion = aMarket->getRegionName();
+    addRow( "price", aMarket->getGoodName(), aMarket->getYear(), aMarket->getPrice() );
+    addRow( "demand", aMarket->getGoodName(), aMarket->getYear(), aMarket->getRawDemand() );
+    addRow( "supply", aMarket->getGoodName(), aMarket->getYear(), aMarket->getRawSupply() );
+    mCurrentRegion = currRegion;
+}
+
+void ColumnarOutputter::startVisitClimateModel( const IClimateModel* aClimateModel, const int aPeriod ) {
+    const string currRegion = mCurrentRegion;
+    mCurrentRegion = GLOBAL_REGION;
+    for( int per = 0; per < mModeltime->getmaxper(); ++per ) {
+        const int year = mModeltime->getper_to_yr( per );
+        addRow( "concentration", "CO2", year, aClimateModel->getConcentration( "CO2", year ) );
+        addRow( "total-forcing", "", year, aClimateModel->getTotalForcing( year ) );
+        addRow( "global-mean-temperature", "", year, aClimateModel->getTemperature( year ) );
+    }
+    mCurrentRegion = currRegion;
+}
+
+void ColumnarOutputter::startVisitPopulation( const Population* aPopulation, const int aPeriod ) {
+    addRow( "population", "", aPopulation->getYear(), aPopulation->getTotal() );
+}
+
+void ColumnarOutputter::startVisitGDP( const GDP* aGDP, const int aPeriod ) {
+    for( int per = 0; per < mModeltime->getmaxper(); ++per ) {
+        addRow( "gdp-mer", "", mModeltime->getper_to_yr( per ), aGDP->getGDP( per ) );
+    }
+}
+
+void ColumnarOutputter::startVisitLandLeaf( const LandLeaf* aLandLeaf, const int aPeriod ) {
+    for( int per = 0; per < mModeltime->getmaxper(); ++per ) {
+        addRow( "land-allocation", aLandLeaf->getName(), mModeltime->getper_to_yr( per ),
+                aLandLeaf->getLandAllocation( aLandLeaf->getName(), per ) );
+    }
+}
+
+/*!
+ * \brief Add a row using the current scenario, region, sector, subsector and
+ *        technology.
+ * \param aVariable The name of the variable.
+ * \param aItem The input, output, gas, good, or land leaf the value is for.
+ * \param aYear The year of the value.
+ * \param aValue The value.
+ */
+void ColumnarOutputter::addRow( const string& aVariable, const string& aItem,
+                                const int aYear, const double aValue )
+{
+    mScenarioColumn.add( mCurrentScenario );
+    mRegionColumn.add( mCurrentRegion );
+    mSectorColumn.add( mCurrentSector );
+    mSubsectorColumn.add( mCurrentSubsector );
+    mTechnologyColumn.add( mCurrentTechnologyName );
+    mVintageColumn.push_back( mCurrentVintage );
+    mVariableColumn.add( aVariable );
+    mItemColumn.add( aItem );
+    mYearColumn.push_back( aYear );
+    mValueColumn.push_back( aValue );
+}
+
+/*!
+ * \brief Get the last period to write for a visit.
+ * \param aPeriod The period the visit was made for, -1 indicates all periods.
+ * \return The last period to write.
+ */
+int ColumnarOutputter::getLastPeriod( const int aPeriod ) const {
+    return aPeriod == -1 ? mModeltime->getmaxper() - 1 : aPeriod;
+}
+
+/*!
+ * \brief Whether the current technology operates in a period.
+ * \details Values which are not within a technology are always written.
+ * \param aPeriod The period to check.
+ * \return True if there is no current technology or it is operating.
+ */
+bool ColumnarOutputter::isTechnologyOperating( const int aPeriod ) const {
+    return !mCurrentTechnology || mCurrentTechnology->isOperating( aPeriod );
+}
+
+/*!
+ * \brief Get the name of an output file from the configuration, appending the
+ *        scenario name if requested as is done by AutoOutputFile.
+ * \param aConfVariableName The Files configuration value with the file name.
+ * \param aDefaultName The file name to use if the value is not set.
+ * \return The name of the file to write.
+ */
+string ColumnarOutputter::getOutputFileName( const string& aConfVariableName,
+                                             const string& aDefaultName )
+{
+    const Configuration* conf = Configuration::getInstance();
+    string fileName = conf->getFile( aConfVariableName, aDefaultName, false );
+    if( conf->shouldAppendScnToFile( aConfVariableName ) ) {
+        fileName = util::appendScenarioToFileName( fileName );
+    }
+    return fileName;
+}
+
+/*!
+ * \brief Add a row to the column.
+ * \param aValue The string value of the row.
+ */
+void ColumnarOutputter::StringColumn::add( const string& aValue ) {
+    map<string, uint32_t>::const_iterator it = mLookup.find( aValue );
+    if( it == mLookup.end() ) {
+        it = mLookup.insert( make_pair( aValue, static_cast<uint32_t>( mDictionary.size() ) ) ).first;
+        mDictionary.push_back( aValue );
+    }
+    mIndices.push_back( it->second );
+}
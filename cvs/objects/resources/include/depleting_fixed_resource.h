@@ -47,6 +47,7 @@
 #include <vector>
 #include "resources/include/aresource.h"
 #include "util/base/include/value.h"
+#include "marketplace/include/cached_market.h"
 
 /*! 
  * \ingroup Objects
@@ -135,6 +136,10 @@ protected:
         DEFINE_VARIABLE( SIMPLE, "price", mInitialPrice, Value )
     )
 
+    //! A pre-located market which has been cached from the marketplace for the
+    //! resource.
+    CachedMarket mCachedMarket;
+
     void setMarket( const std::string& aRegionName );
 };
 
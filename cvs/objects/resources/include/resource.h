@@ -51,6 +51,7 @@
 #include "util/base/include/object_meta_info.h"
 #include "util/base/include/value.h"
 #include "util/base/include/time_vector.h"
+#include "marketplace/include/cached_market.h"
 
 // Forward declaration.
 class SubResource;
@@ -116,6 +117,10 @@ protected:
     //! Pointer to the resource's information store.
     std::auto_ptr<IInfo> mResourceInfo;
 
+    //! A pre-located market which has been cached from the marketplace for the
+    //! resource.
+    CachedMarket mCachedMarket;
+
     //! Vector of object meta info to pass to the market
     object_meta_info_vector_type mObjectMetaInfo;
 
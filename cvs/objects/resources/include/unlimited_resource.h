@@ -47,6 +47,7 @@
 #include "resources/include/aresource.h"
 #include "util/base/include/value.h"
 #include "util/base/include/time_vector.h"
+#include "marketplace/include/cached_market.h"
 
 /*! 
  * \ingroup Objects
@@ -130,6 +131,10 @@ protected:
         DEFINE_VARIABLE( SIMPLE | STATE, "supply-wedge", mSupplyWedge, Value)
     )
 
+    //! A pre-located market which has been cached from the marketplace for the
+    //! resource.
+    CachedMarket mCachedMarket;
+
     void setMarket( const std::string& aRegionName );
 };
 
@@ -170,6 +170,7 @@ void DepletingFixedResource::initCalc( const string& aRegionName,
                                   const int aPeriod )
 {
     Marketplace* marketplace = scenario->getMarketplace();
+    mCachedMarket = marketplace->locateMarket( mName, aRegionName, aPeriod );
     IInfo* marketInfo = marketplace->getMarketInfo( mName,
                                                           aRegionName,
                                                           aPeriod,
@@ -235,10 +236,8 @@ void DepletingFixedResource::calcSupply( const string& aRegionName,
                                     const GDP* aGDP,
                                     const int aPeriod )
 {
-    Marketplace* marketplace = scenario->getMarketplace();
-
     // the supply is just the fixed amount that is left.
-    marketplace->addToSupply( mName, aRegionName, mFixedResource, aPeriod );
+    mCachedMarket.addToSupply( mName, aRegionName, mFixedResource, aPeriod );
 }
 
 double DepletingFixedResource::getAnnualProd( const string& aRegionName,
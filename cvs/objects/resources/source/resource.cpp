@@ -305,6 +305,8 @@ void Resource::completeInit( const string& aRegionName, const IInfo* aRegionInfo
 * \param aPeriod Model period
 */
 void Resource::initCalc( const string& aRegionName, const int aPeriod ) {
+    mCachedMarket = scenario->getMarketplace()->locateMarket( mName, aRegionName, aPeriod );
+
     // call subResource initializations
     for ( unsigned int i = 0; i < mSubResource.size(); i++ ){
         mSubResource[i]->initCalc( aRegionName, mName, aPeriod );
@@ -402,7 +404,7 @@ void Resource::calcSupply( const string& aRegionName, const GDP* aGDP, const int
     // This code is moved down from Region
     Marketplace* marketplace = scenario->getMarketplace();
 
-    double price = marketplace->getPrice( mName, aRegionName, aPeriod );
+    double price = mCachedMarket.getPrice( mName, aRegionName, aPeriod );
     double lastPeriodPrice;
 
     if ( aPeriod == 0 ) {
@@ -177,6 +177,8 @@ void UnlimitedResource::initCalc( const string& aRegionName,
                                   const int aPeriod )
 {
     Marketplace* marketplace = scenario->getMarketplace();
+    mCachedMarket = marketplace->locateMarket( mName, aRegionName, aPeriod );
+
     // Set the capacity factor and variance.
     IInfo* marketInfo = marketplace->getMarketInfo( mName, aRegionName, aPeriod, true );
     assert( marketInfo );
@@ -205,14 +207,12 @@ void UnlimitedResource::calcSupply( const string& aRegionName,
                                     const GDP* aGDP,
                                     const int aPeriod )
 {
-    Marketplace* marketplace = scenario->getMarketplace();
-
     // Get the current demand and add the difference between current supply and
     // demand to the market.
-    double currDemand = marketplace->getDemand( mName, aRegionName, aPeriod );
-    double currSupply = marketplace->getSupply( mName, aRegionName, aPeriod );
+    double currDemand = mCachedMarket.getDemand( mName, aRegionName, aPeriod );
+    double currSupply = mCachedMarket.getSupply( mName, aRegionName, aPeriod );
     mSupplyWedge = currDemand - currSupply;
-    marketplace->addToSupply( mName, aRegionName, mSupplyWedge, aPeriod );
+    mCachedMarket.addToSupply( mName, aRegionName, mSupplyWedge, aPeriod );
 }
 
 double UnlimitedResource::getAnnualProd( const string& aRegionName,
@@ -49,6 +49,7 @@
 #include "sectors/include/afinal_demand.h"
 #include "util/base/include/value.h"
 #include "util/base/include/time_vector.h"
+#include "marketplace/include/cached_market.h"
 
 // Forward declarations
 class GDP;
@@ -159,6 +160,9 @@ protected:
 
         double getCalibratedFinalEnergy( const int aPeriod ) const;
 
+        void initCalc( const std::string& aRegionName,
+                       const int aPeriod );
+
         void updateAEEI( const std::string& aRegionName,
                          const int aPeriod );
 
@@ -171,6 +175,10 @@ protected:
         //! Name of the TFE market.
         std::string mTFEMarketName;
 
+        //! A pre-located market which has been cached from the marketplace for
+        //! the TFE market.
+        CachedMarket mCachedTFEMarket;
+
         //! Autonomous end-use energy intensity parameter.
         objects::PeriodVector<Value> mAEEI;
 
@@ -207,6 +215,14 @@ protected:
 
     //! Object responsible for consuming final energy.
     std::auto_ptr<FinalEnergyConsumer> mFinalEnergyConsumer;
+
+    //! A pre-located market which has been cached from the marketplace for the
+    //! service demanded.
+    CachedMarket mCachedMarket;
+
+    //! A pre-located market which has been cached from the marketplace for the
+    //! service demanded in the base period of the price ratio.
+    CachedMarket mCachedBaseMarket;
     
     virtual double calcFinalDemand( const std::string& aRegionName,
                                     const Demographic* aDemographics,
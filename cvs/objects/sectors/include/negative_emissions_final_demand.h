@@ -49,6 +49,7 @@
 #include "sectors/include/afinal_demand.h"
 #include "util/base/include/value.h"
 #include "util/base/include/time_vector.h"
+#include "marketplace/include/cached_market.h"
 
 // Forward declarations
 class GDP;
@@ -112,6 +113,14 @@ protected:
         //! State value necessary to use Marketplace::addToDemand
         DEFINE_VARIABLE( SIMPLE | STATE, "curr-negative-emiss-value", mCurrNegEmissValue, Value )
     )
+
+    //! A pre-located market which has been cached from the marketplace for the
+    //! gas being tracked.
+    CachedMarket mCachedMarket;
+
+    //! A pre-located market which has been cached from the marketplace for the
+    //! policy to which negative emissions value is added.
+    CachedMarket mCachedPolicyMarket;
     
     virtual const std::string& getXMLName() const;
 };
@@ -45,6 +45,7 @@
 #include <string>
 #include "sectors/include/supply_sector.h"
 #include "containers/include/iactivity.h"
+#include "marketplace/include/cached_market.h"
 
 /*!
  * \ingroup Objects
@@ -92,6 +93,17 @@ protected:
         DEFINE_VARIABLE( SIMPLE | STATE, "last-calac-fixed-output", mLastCalcFixedOutput, Value )
     )
 
+    //! The name of the trial market used to pass the fixed output downstream.
+    std::string mFixedOutputMarketName;
+
+    //! A pre-located market which has been cached from the marketplace for the
+    //! marginal revenue sector.
+    CachedMarket mCachedMarginalRevenueMarket;
+
+    //! A pre-located market which has been cached from the marketplace for the
+    //! fixed output trial market.
+    CachedMarket mCachedFixedOutputMarket;
+
 private:
     void setFixedDemandsToMarket( const int aPeriod ) const;
 };
@@ -113,6 +125,8 @@ public:
 
     virtual std::string getDescription() const;
 
+    virtual const void* getStateOwner() const;
+
 private:
     //! A weak reference to the sector that will do the work
     const PassThroughSector* mSector;
@@ -58,6 +58,7 @@
 #include "util/base/include/time_vector.h"
 #include "util/base/include/value.h"
 #include "util/base/include/data_definition_util.h"
+#include "marketplace/include/cached_market.h"
 
 // Forward declarations
 class Subsector;
@@ -143,6 +144,10 @@ protected:
     //! Pointer to the sector's information store.
     std::auto_ptr<IInfo> mSectorInfo;
 
+    //! A pre-located market which has been cached from the marketplace for the
+    //! good this sector produces.
+    CachedMarket mCachedMarket;
+
     typedef ObjECTS::TObjectMetaInfo<> object_meta_info_type;
     typedef std::vector<object_meta_info_type> object_meta_info_vector_type;
     object_meta_info_vector_type mObjectMetaInfo; //!< Vector of object meta info to pass to mSectorInfo
@@ -52,6 +52,7 @@
 #include "util/base/include/time_vector.h"
 
 class IInfo;
+class CachedMarket;
 
 /*! 
  * \ingroup Objects
@@ -86,6 +87,13 @@ public:
                                   const int aBasePeriod,
                                   const int aCurrentPeriod );
 
+    static double calcPriceRatio( const std::string& aRegionName,
+                                  const std::string& aSectorName,
+                                  const CachedMarket& aBaseMarket,
+                                  const CachedMarket& aCurrentMarket,
+                                  const int aBasePeriod,
+                                  const int aCurrentPeriod );
+
     static double getDemandPriceThreshold();
 
     static double adjustDemandForNegativePrice( const double aDemandScalar,
@@ -255,6 +255,17 @@ void EnergyFinalDemand::initCalc( const string& aRegionName,
                                   const Demographic* aDemographics,
                                   const int aPeriod )
 {
+    Marketplace* marketplace = scenario->getMarketplace();
+    mCachedMarket = marketplace->locateMarket( mName, aRegionName, aPeriod );
+    // The price ratio is relative to the previous period but never before
+    // period 1.
+    if( aPeriod > 0 ) {
+        mCachedBaseMarket = marketplace->locateMarket( mName, aRegionName, max( aPeriod - 1, 1 ) );
+    }
+
+    if( mFinalEnergyConsumer.get() ){
+        mFinalEnergyConsumer->initCalc( aRegionName, aPeriod );
+    }
 }
 
 /*! \brief Set the final demand for service into the marketplace after 
@@ -276,8 +287,7 @@ void EnergyFinalDemand::setFinalDemand( const string& aRegionName,
 {
     calcFinalDemand( aRegionName, aDemographics, aGDP, aPeriod );
     // Set the service demand into the marketplace.
-    Marketplace* marketplace = scenario->getMarketplace();
-    marketplace->addToDemand( mName, aRegionName, mServiceDemands[ aPeriod ], aPeriod );
+    mCachedMarket.addToDemand( mName, aRegionName, mServiceDemands[ aPeriod ], aPeriod );
 }
 
 /*! \brief Set the final demand for service using the aggrgate sector energy service 
@@ -352,8 +362,8 @@ double EnergyFinalDemand::calcMacroScaler( const string& aRegionName,
         previousPeriod = aPeriod - 1;
     }
 
-    const double priceRatio = SectorUtils::calcPriceRatio( aRegionName, mName,
-                                                     previousPeriod, aPeriod );
+    const double priceRatio = SectorUtils::calcPriceRatio( aRegionName, mName, mCachedBaseMarket,
+                                                           mCachedMarket, previousPeriod, aPeriod );
     const double cappedPriceRatio = max( priceRatio, SectorUtils::getDemandPriceThreshold() );
 
     double macroScaler = mDemandFunction->calcDemand( aDemographics,
@@ -377,16 +387,13 @@ double EnergyFinalDemand::getWeightedEnergyPrice( const string& aRegionName,
         return 0;
     }
 
-    const Marketplace* marketplace = scenario->getMarketplace();
-
     // Make sure the market exists. Note that this currently uses the energy
     // supplies from the previous period to avoid ordering issues.
-    assert( marketplace->getPrice( mName, aRegionName, aPeriod, true ) !=
-        Marketplace::NO_MARKET_PRICE );
+    const double price = mCachedMarket.getPrice( mName, aRegionName, aPeriod, true );
+    assert( price != Marketplace::NO_MARKET_PRICE );
 
     // TODO: Should this use the previous period, current period, etc?
-    return marketplace->getPrice( mName, aRegionName, aPeriod, true ) *
-        mServiceDemands[ 0 ];
+    return price * mServiceDemands[ 0 ];
 }
 
 // Documentation is inherited.
@@ -536,17 +543,27 @@ double EnergyFinalDemand::FinalEnergyConsumer::getCalibratedFinalEnergy( const i
         mCalFinalEnergy[ aPeriod ].get() : noCalibrationValue();
 }
 
+/*!
+ * \brief Locate the TFE market for the period.
+ * \param aRegionName Name of the region.
+ * \param aPeriod Model period.
+ */
+void EnergyFinalDemand::FinalEnergyConsumer::initCalc( const string& aRegionName,
+                                                       const int aPeriod )
+{
+    mCachedTFEMarket = scenario->getMarketplace()->locateMarket( mTFEMarketName, aRegionName, aPeriod );
+}
+
 void EnergyFinalDemand::FinalEnergyConsumer::updateAEEI( const string& aRegionName,
                                                          const int aPeriod )
 {
     // Do only if mCalFinalEnergy object exists.
     if( mCalFinalEnergy[ aPeriod ].get() ){
         const Modeltime* modeltime = scenario->getModeltime();
-        Marketplace* marketplace = scenario->getMarketplace();
 
         // Get the technical change parameter from the calibration market.
         if( aPeriod > modeltime->getFinalCalibrationPeriod() && mCalFinalEnergy[ aPeriod ].isInited() ){
-            double totalAEEI = marketplace->getPrice( mTFEMarketName, aRegionName,
+            double totalAEEI = mCachedTFEMarket.getPrice( mTFEMarketName, aRegionName,
                 aPeriod, true );
             if( totalAEEI > 0 ){
                 mAEEI[ aPeriod ] = pow( totalAEEI, 1.0 /
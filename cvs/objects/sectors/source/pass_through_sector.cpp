@@ -114,7 +114,8 @@ void PassThroughSector::completeInit( const IInfo* aRegionInfo,
 
     // Add dependencies for a calc item to gather up the fixed demands from this
     // pass through sector and make that available for the downstream sector
-    const string fixedDemandActivityName = mName + "-fixed-output";
+    mFixedOutputMarketName = mName + "-fixed-output";
+    const string& fixedDemandActivityName = mFixedOutputMarketName;
     MarketDependencyFinder* depFinder = scenario->getMarketplace()->getDependencyFinder();
 
     // Ensure we gather the fixed demands after we calculate prices / before we
@@ -153,10 +154,14 @@ void PassThroughSector::initCalc( NationalAccount* aNationalAccount,
                                   const int aPeriod )
 {
     SupplySector::initCalc( aNationalAccount, aDemographics, aPeriod );
+
+    Marketplace* marketplace = scenario->getMarketplace();
+    mCachedMarginalRevenueMarket = marketplace->locateMarket( mMarginalRevenueSector, mMarginalRevenueMarket, aPeriod );
+    mCachedFixedOutputMarket = marketplace->locateMarket( mFixedOutputMarketName, mRegionName, aPeriod );
 }
 
 double PassThroughSector::getFixedOutput( const int aPeriod ) const {
-    const double marginalRevenue = scenario->getMarketplace()->getPrice( mMarginalRevenueSector,
+    const double marginalRevenue = mCachedMarginalRevenueMarket.getPrice( mMarginalRevenueSector,
         mMarginalRevenueMarket, aPeriod );
     double totalfixedOutput = 0;
     for( CSubsectorIterator subSecIter = mSubsectors.begin(); subSecIter != mSubsectors.end(); subSecIter++ ) {
@@ -173,13 +178,12 @@ double PassThroughSector::getFixedOutput( const int aPeriod ) const {
 void PassThroughSector::setFixedDemandsToMarket( const int aPeriod ) const {
     const_cast<PassThroughSector*>( this )->mLastCalcFixedOutput = getFixedOutput( aPeriod );
 
-    const string fixedDemandActivityName = mName + "-fixed-output";
-    Marketplace* marketplace = scenario->getMarketplace();
+    CachedMarket& fixedOutputMarket = const_cast<PassThroughSector*>( this )->mCachedFixedOutputMarket;
     // set the fixed out to both sides of the equation (supply=price for trial markets)
     // so the solver doesn't complain it is "unsolved"
-    marketplace->addToDemand( fixedDemandActivityName, mRegionName,
-                              const_cast<PassThroughSector*>( this )->mLastCalcFixedOutput, aPeriod );
-    marketplace->setPrice( fixedDemandActivityName, mRegionName, mLastCalcFixedOutput, aPeriod );
+    fixedOutputMarket.addToDemand( mFixedOutputMarketName, mRegionName,
+                                   const_cast<PassThroughSector*>( this )->mLastCalcFixedOutput, aPeriod );
+    fixedOutputMarket.setPrice( mFixedOutputMarketName, mRegionName, mLastCalcFixedOutput, aPeriod );
 }
 
 CalcFixedOutputActivity::CalcFixedOutputActivity( const PassThroughSector* aSector ):
@@ -199,3 +203,8 @@ string CalcFixedOutputActivity::getDescription() const {
     return mSector->mRegionName + " " + mSector->getName() + "-fixed-output";
 }
 
+const void* CalcFixedOutputActivity::getStateOwner() const {
+    // state is collected as a Sector so we must be sure to return the same address
+    return static_cast<const Sector*>( mSector );
+}
+
@@ -314,6 +314,7 @@ void Sector::initCalc( NationalAccount* aNationalAccount,
                       const Demographic* aDemographics,
                       const int aPeriod )
 {
+    mCachedMarket = scenario->getMarketplace()->locateMarket( mName, mRegionName, aPeriod );
     mDiscreteChoiceModel->initCalc( mRegionName, mName, false, aPeriod );
     
     // do any sub-Sector initializations
@@ -484,7 +485,7 @@ bool Sector::outputsAllFixed( const int period ) const {
  * \return Total fixed output.
  */
 double Sector::getFixedOutput( const int aPeriod ) const {
-    const double sectorPrice = scenario->getMarketplace()->getPrice( mName, mRegionName, aPeriod );
+    const double sectorPrice = mCachedMarket.getPrice( mName, mRegionName, aPeriod );
     double totalfixedOutput = 0;
     for ( unsigned int i = 0; i < mSubsectors.size(); ++i ){
         totalfixedOutput += mSubsectors[ i ]->getFixedOutput( aPeriod, sectorPrice );
@@ -48,6 +48,7 @@
 #include "sectors/include/sector_utils.h"
 #include "containers/include/scenario.h"
 #include "marketplace/include/marketplace.h"
+#include "marketplace/include/cached_market.h"
 #include "util/base/include/model_time.h"
 #include "containers/include/iinfo.h"
 #include "util/base/include/util.h"
@@ -379,6 +380,33 @@ double SectorUtils::calcPriceRatio( const string& aRegionName,
                                     const string& aSectorName,
                                     const int aBasePeriod,
                                     const int aCurrentPeriod )
+{
+    // Default constructed markets look up the prices through the marketplace.
+    return calcPriceRatio( aRegionName, aSectorName, CachedMarket(), CachedMarket(),
+                           aBasePeriod, aCurrentPeriod );
+}
+
+/*!
+ * \brief Get the ratio of an sector's price in the current period to the base
+ *        period using markets which have already been located.
+ * \details Behaves the same as the version which locates the markets by name
+ *          but avoids the lookup when the markets were located for the periods
+ *          used.  Note that prices before 1990 are not valid so the base period
+ *          used is never before period 1.
+ * \param aRegionName Name of the region in which to find the ratio.
+ * \param aSectorName Sector for which to find the price ratio.
+ * \param aBaseMarket The sector market located for the base period.
+ * \param aCurrentMarket The sector market located for the current period.
+ * \param aBasePeriod Base period for the ratio.
+ * \param aCurrentPeriod Current period for the ratio.
+ * \return Price ratio for the sector.
+ */
+double SectorUtils::calcPriceRatio( const string& aRegionName,
+                                    const string& aSectorName,
+                                    const CachedMarket& aBaseMarket,
+                                    const CachedMarket& aCurrentMarket,
+                                    const int aBasePeriod,
+                                    const int aCurrentPeriod )
 {
     // The price ratio is always 1 in the base period.
     double priceRatio = 1;
@@ -389,9 +417,8 @@ double SectorUtils::calcPriceRatio( const string& aRegionName,
         internalBasePeriod = 1; 
     }
     if( aCurrentPeriod > internalBasePeriod ) {
-        const Marketplace* marketplace = scenario->getMarketplace();
-        double basePrice = marketplace->getPrice( aSectorName, aRegionName, internalBasePeriod );
-        double currentPrice = marketplace->getPrice( aSectorName, aRegionName, aCurrentPeriod );
+        double basePrice = aBaseMarket.getPrice( aSectorName, aRegionName, internalBasePeriod );
+        double currentPrice = aCurrentMarket.getPrice( aSectorName, aRegionName, aCurrentPeriod );
 
         priceRatio = currentPrice / basePrice;
         
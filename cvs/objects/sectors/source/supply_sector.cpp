@@ -246,11 +246,9 @@ void SupplySector::calcFinalSupplyPrice( const GDP* aGDP, const int aPeriod ){
     calcCosts( aPeriod );
 
     // Set the price into the market.
-    Marketplace* marketplace = scenario->getMarketplace();
-
     double avgMarginalPrice = getPrice( aGDP, aPeriod );
 
-    marketplace->setPrice( mName, mRegionName, avgMarginalPrice, aPeriod, true );
+    mCachedMarket.setPrice( mName, mRegionName, avgMarginalPrice, aPeriod, true );
 }
 
 /*! \brief Set supply Sector output
@@ -262,9 +260,8 @@ void SupplySector::calcFinalSupplyPrice( const GDP* aGDP, const int aPeriod ){
 * \param aPeriod Model period
 */
 void SupplySector::supply( const GDP* aGDP, const int aPeriod ) {
-	Marketplace* marketplace = scenario->getMarketplace();
 	// demand for the good produced by this Sector
-	double marketDemand = max( marketplace->getDemand( mName, mRegionName, aPeriod ), 0.0 );
+	double marketDemand = max( mCachedMarket.getDemand( mName, mRegionName, aPeriod ), 0.0 );
 
 	// Determine if fixed output must be scaled because fixed supply
 	// exceeded demand.
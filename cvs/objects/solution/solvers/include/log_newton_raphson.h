@@ -49,6 +49,7 @@
 #include <boost/numeric/ublas/matrix.hpp>
 // include lu for permutation_matrix
 #include <boost/numeric/ublas/lu.hpp>
+#include "solution/util/include/sparse_linear_solver.hpp"
 
 typedef boost::numeric::ublas::matrix<double> Matrix;
 typedef boost::numeric::ublas::permutation_matrix<std::size_t> PermutationMatrix;
@@ -98,6 +99,12 @@ protected:
     //! will work on.
     std::auto_ptr<ISolutionInfoFilter> mSolutionInfoFilter;
     
+    //! The linear solver used to calculate the Newton step, dense LU by default.
+    SparseLinearSolver::Method mLinearSolver;
+    
+    //! The factorized derivative when mLinearSolver is not DENSE.
+    SparseLinearSolver mSparseSolver;
+    
     virtual ReturnCode calculateDerivatives( SolutionInfoSet& aSolutionSet, Matrix& JF, PermutationMatrix& aPermMatrix, int aPeriod );
     
     virtual void resetDerivatives();
@@ -46,9 +46,12 @@
  */
 
 #include <string>
+#include <vector>
+#include <map>
 #include <boost/numeric/ublas/matrix.hpp>
 #include "solution/util/include/solvable_nr_solution_info_filter.h"
 #include "solution/util/include/edfun.hpp"
+#include "solution/util/include/sparse_linear_solver.hpp"
 
 #define UBLAS boost::numeric::ublas
 #if USE_LAPACK
@@ -83,7 +86,9 @@ public:
   LogBroyden(Marketplace *mktplc, World *world, CalcCounter *ccounter, int itmax=250,
              double ftol=1.0e-4) :
       SolverComponent(mktplc,world,ccounter), mMaxIter( itmax ), mFTOL( ftol ),
-      mLogPricep( true ) {}
+      mLogPricep( true ), mSparseJacobian( false ),
+      mLinearSolver( SparseLinearSolver::DENSE ), mMaxLowRankUpdates( 0 ),
+      mReuseJacobian( false ) {}
   virtual ~LogBroyden() {}
 
   // SolverComponent methods
@@ -93,6 +98,8 @@ public:
   }
   virtual ReturnCode solve( SolutionInfoSet& aSolutionSet, const int aPeriod );
   virtual const std::string& getXMLName() const {return SOLVER_NAME;}
+  //! Cached Jacobians carry over from one run of the scenario to the next.
+  virtual bool reusesPriorSolutions() const {return mReuseJacobian;}
   
   // IParsable methods
   virtual bool XMLParse( const xercesc::DOMNode* aNode );
@@ -102,7 +109,16 @@ public:
 protected:
   //! Perform the Broyden's method iterations.
   int bsolve(VecFVec<double,double> &F, UBLAS::vector<double> &x, UBLAS::vector<double> &fx,
-             UBMATRIX &B, int &neval);
+             UBMATRIX &B, int &neval, bool aIsReusedB=false);
+  //! Look up the Jacobian accepted for the same markets in this or the previous period.
+  bool loadJacobian(const LogEDFun &F, const std::vector<std::string> &aMarketNames, int aPeriod,
+                    UBMATRIX &J) const;
+  //! Keep the Jacobian accepted by a successful solution.
+  void saveJacobian(const LogEDFun &F, const std::vector<std::string> &aMarketNames, int aPeriod,
+                    const UBMATRIX &J);
+  //! Compute the Broyden step using one of the sparse linear solvers.
+  int sparseStep(VecFVec<double,double> &F, UBLAS::vector<double> &x, UBLAS::vector<double> &fx,
+                 UBMATRIX &B, UBLAS::vector<double> &dx, SparseLinearSolver &aSolver);
   //! Additional logging for visualizing solver progress.
   void reportVec(const std::string &aname, const UBLAS::vector<double> &av, const std::vector<int> &amktids,
                  const std::vector<bool> &aissolvable);
@@ -125,6 +141,25 @@ protected:
 
   bool mLogPricep;              //<! flag indicating whether we should work in price or log-price
 
+  bool mSparseJacobian;         //<! flag indicating whether fdjac should group structurally independent columns
+
+  SparseLinearSolver::Method mLinearSolver; //<! linear solver used to compute the step from B
+
+  unsigned int mMaxLowRankUpdates; //<! number of Broyden updates to apply to the last factorization before refactoring (0 = always refactor)
+
+  bool mReuseJacobian;          //<! flag indicating whether to start from the last accepted Jacobian instead of fdjac when possible
+
+  //! A Jacobian accepted at the end of a successful solution, unscaled
+  //! by the LogEDFun scale factors since those change with the forecasts.
+  struct CachedJacobian {
+    //! The names of the markets solved in the order of the rows and columns.
+    std::vector<std::string> mMarketNames;
+    UBMATRIX mJacobian;
+  };
+
+  //! The last accepted Jacobian by period.  Only kept if mReuseJacobian is set.
+  std::map<int, CachedJacobian> mJacobianCache;
+
   // These next two have to be class variables because we sometimes
   // have multiple logbroyden solvers operating.
   static int mLastPer;                 //<! used to detect when the period has changed, so we can reset mPerIter.
@@ -68,6 +68,13 @@ public:
     virtual void init() = 0;
     virtual bool solve( const int aPeriod, const SolutionInfoParamParser* aSolutionInfoParamParser ) = 0;
 
+    /*!
+     * \brief Whether this solver starts from information kept from earlier
+     *        solutions of the scenario.
+     * \return False by default.
+     */
+    virtual bool reusesPriorSolutions() const { return false; }
+
 protected:
     Marketplace* marketplace; //<! The marketplace to solve. 
     World* world; //!< The world to call calc on.
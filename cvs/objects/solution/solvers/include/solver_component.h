@@ -90,6 +90,8 @@ public:
 
    virtual const std::string& getXMLName() const = 0;
 
+   virtual bool reusesPriorSolutions() const;
+
 protected:
    Marketplace* marketplace; //<! The marketplace to solve. 
    World* world; //<! World to call calc on.
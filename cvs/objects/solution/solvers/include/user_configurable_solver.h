@@ -89,6 +89,7 @@ public:
     // Solver methods
     virtual void init();
     virtual bool solve( const int aPeriod, const SolutionInfoParamParser* aSolutionInfoParamParser );
+    virtual bool reusesPriorSolutions() const;
     
     // IParsable methods
     virtual bool XMLParse( const xercesc::DOMNode* aNode );
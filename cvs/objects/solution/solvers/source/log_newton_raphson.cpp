@@ -67,7 +67,8 @@ LogNewtonRaphson::LogNewtonRaphson( Marketplace* aMarketplace,
 SolverComponent( aMarketplace, aWorld, aCalcCounter ),
 mDefaultDeltaPrice( 1e-6 ),
 mMaxIterations( 4 ),
-mDefaultMaxPriceChange( 1.2 )
+mDefaultMaxPriceChange( 1.2 ),
+mLinearSolver( SparseLinearSolver::DENSE )
 {
 }
 
@@ -118,6 +119,9 @@ bool LogNewtonRaphson::XMLParse( const DOMNode* aNode ) {
         else if( nodeName == "max-price-change" ) {
             mDefaultMaxPriceChange = XMLHelper<double>::getValue( curr );
         }
+        else if( nodeName == "linear-solver" ) {
+            mLinearSolver = SparseLinearSolver::parseMethod( XMLHelper<string>::getValue( curr ) );
+        }
         else if( nodeName == "solution-info-filter" ) {
             mSolutionInfoFilter.reset(
                 SolutionInfoFilterFactory::createSolutionInfoFilterFromString( XMLHelper<string>::getValue( curr ) ) );
@@ -198,7 +202,8 @@ SolverComponent::ReturnCode LogNewtonRaphson::solve( SolutionInfoSet& aSolutionS
             return code;
         } 
         // Calculate new prices
-        if( SolverLibrary::calculateNewPricesLogNR( aSolutionSet, JF, permMatrix, mDefaultMaxPriceChange ) ){
+        if( SolverLibrary::calculateNewPricesLogNR( aSolutionSet, JF, permMatrix, mDefaultMaxPriceChange,
+                                                    mLinearSolver == SparseLinearSolver::DENSE ? 0 : &mSparseSolver ) ){
             // Call world.calc and update supplies and demands. 
             marketplace->nullSuppliesAndDemands( aPeriod );
             solverLog << "Supplies and demands calculated with new prices." << endl;
@@ -262,6 +267,8 @@ SolverComponent::ReturnCode LogNewtonRaphson::solve( SolutionInfoSet& aSolutionS
  *          actually be inverted rather it will use LU factorization which is computationally less
  *          intensive than calculating inverse.  Note that SolverLibrary::calculateNewPricesLogNR
  *          has also been modified to expect the factorized derivative rather than the inverse.
+ *          When a sparse linear solver has been selected the factorization is held in
+ *          mSparseSolver instead and JF is left unfactorized.
  * \param aSolutionSet The set of solutions infos which will be included in the derivative calculation.
  * \param JF The LU factorized derivative matrix or garbage if for some reason the calculation failed.
  * \param aPermMatrix A matrix to keep track of row operations done while factorizing the derivative
@@ -287,7 +294,17 @@ SolverComponent::ReturnCode LogNewtonRaphson::calculateDerivatives( SolutionInfo
     // Update the JF, JFDM, and JFSM matrices
     SolverLibrary::updateMatrices( aSolutionSet, JFSM, JFDM, JF );
     
-    if( SolverLibrary::luFactorizeMatrix( JF, aPermMatrix ) ) {
+    bool isSingular;
+    if( mLinearSolver == SparseLinearSolver::DENSE ) {
+        isSingular = SolverLibrary::luFactorizeMatrix( JF, aPermMatrix );
+    }
+    else {
+        isSingular = mSparseSolver.factorize( JF, mLinearSolver ) != 0;
+        solverLog.setLevel( ILogger::DEBUG );
+        solverLog << SparseLinearSolver::getMethodName( mLinearSolver ) << " density: "
+                  << mSparseSolver.getDensity() << ", factor nonzeros: " << mSparseSolver.getFactorSize() << endl;
+    }
+    if( isSingular ) {
         // print the derivative matrix to help the user understand why it was singular
         solverLog.setLevel( ILogger::ERROR );
         solverLog << "Matrix came back as singular, could not invert." << endl;
@@ -81,6 +81,7 @@
 #endif 
 
 #include "util/base/include/timer.h"
+#include "util/base/include/trace_recorder.h"
 
 using namespace xercesc;
 
@@ -123,6 +124,18 @@ namespace {
       }
     }
   } 
+
+  // check that scale factors can be divided out of a Jacobian and
+  // back in again
+  bool isValidScale(const UBVECTOR &scl)
+  {
+    for(size_t i=0; i<scl.size(); ++i) {
+      if(scl[i] == 0.0 || !util::isValidNumber(scl[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
 }
 
 int LogBroyden::mLastPer = 0;
@@ -159,6 +172,18 @@ bool LogBroyden::XMLParse( const DOMNode* aNode ) {
         else if(nodeName == "log-price") {
           mLogPricep = true;    // not strictly necessary, as this is the default.
         }
+        else if(nodeName == "sparse-jacobian") {
+          mSparseJacobian = XMLHelper<bool>::getValue( curr );
+        }
+        else if(nodeName == "max-low-rank-updates") {
+          mMaxLowRankUpdates = XMLHelper<unsigned int>::getValue( curr );
+        }
+        else if(nodeName == "reuse-jacobian") {
+          mReuseJacobian = XMLHelper<bool>::getValue( curr );
+        }
+        else if(nodeName == "linear-solver") {
+          mLinearSolver = SparseLinearSolver::parseMethod( XMLHelper<std::string>::getValue( curr ) );
+        }
         else if( SolutionInfoFilterFactory::hasSolutionInfoFilter( nodeName ) ) {
             mSolutionInfoFilter.reset( SolutionInfoFilterFactory::createAndParseSolutionInfoFilter( nodeName, curr ) );
         }
@@ -194,6 +219,13 @@ bool LogBroyden::XMLParse( const DOMNode* aNode ) {
  * difference approximations for the new column, and we'll zero the
  * off-diagonal terms of the new row.
  *
+ * If reuse-jacobian is set and the same markets were solved in this
+ * period, such as in the previous target finder trial, or the previous
+ * period, the Jacobian accepted then is used as the initial
+ * approximation instead.  The Broyden iterations already replace B
+ * with a finite difference Jacobian when the line search fails so a
+ * poor starting point costs little.
+ *
  * The solver can run in either log-log mode or linear-linear mode.
  *
  * \author Robert Link 
@@ -254,6 +286,7 @@ SolverComponent::ReturnCode LogBroyden::solve(SolutionInfoSet &solnset, int peri
 
     Timer& solverTimer = TimerRegistry::getInstance().getTimer( TimerRegistry::SOLVER );
     solverTimer.start();
+    TraceScope solverScope( "solver", "LogBroyden" );
     
     UBVECTOR x( nsolv ), fx( nsolv );
     int neval = 0;
@@ -270,6 +303,7 @@ SolverComponent::ReturnCode LogBroyden::solve(SolutionInfoSet &solnset, int peri
     
     // This is the closure that will evaluate the ED function
     LogEDFun F(solnset, world, marketplace, period, mLogPricep); 
+    F.setSparseJacobian( mSparseJacobian );
     // check the assumptions:  narg==nrtn==nsolv
     if(F.narg() != nsolv || F.nrtn() != nsolv) {
       solverLog.setLevel(ILogger::SEVERE);
@@ -293,7 +327,18 @@ SolverComponent::ReturnCode LogBroyden::solve(SolutionInfoSet &solnset, int peri
     // Precondition the x values to avoid singular columns in the Jacobian
     solverLog.setLevel(ILogger::DEBUG);
     UBMATRIX J(F.narg(), F.nrtn());
-    fdjac(F, x, fx, J, true);
+    std::vector<std::string> mktnames;
+    bool reusedJ = false;
+    if( mReuseJacobian ) {
+      mktnames.reserve( smkts.size() );
+      for(size_t i=0; i<smkts.size(); ++i) {
+        mktnames.push_back( smkts[i].getName() );
+      }
+      reusedJ = loadJacobian(F, mktnames, period, J);
+    }
+    if( !reusedJ ) {
+      fdjac(F, x, fx, J, true);
+    }
 
     solverLog << ">>>> Main loop jacobian called.\n";
     int pcfail = jacobian_precondition(x, fx, J, F, &solverLog, mLogPricep);
@@ -310,7 +355,14 @@ SolverComponent::ReturnCode LogBroyden::solve(SolutionInfoSet &solnset, int peri
     cSolInfo = &solnset;        // make available for log outputs
 
     // call the solver
-    int bstatus = bsolve(F, x, fx, J, neval);
+    Timer& bsolveTimer = TimerRegistry::getInstance().getTimer( TimerRegistry::BSOLVE );
+    bsolveTimer.start();
+    int bstatus;
+    {
+        TraceScope bsolveScope( "solver", "bsolve" );
+        bstatus = bsolve(F, x, fx, J, neval, reusedJ);
+    }
+    bsolveTimer.stop();
     mPerIter++;                 // increment the iteration count.  This should produce a visible gap in the trace plots.
 
     solverTimer.stop(); 
@@ -320,6 +372,9 @@ SolverComponent::ReturnCode LogBroyden::solve(SolutionInfoSet &solnset, int peri
     if(bstatus == 0) {
         solverLog << "Broyden solution success.\n";
         code = SUCCESS;
+        if( mReuseJacobian ) {
+          saveJacobian(F, mktnames, period, J);
+        }
     }
     else if(bstatus == -1) {
         code = FAILURE_ITER_MAX_REACHED;
@@ -366,8 +421,16 @@ SolverComponent::ReturnCode LogBroyden::solve(SolutionInfoSet &solnset, int peri
     return code;
 }
 
+/*!
+ * \brief Perform the Broyden's method iterations.
+ * \details On success B is left as the Jacobian approximation used for
+ *          the final step.
+ * \param aIsReusedB Whether B was reused from a previous solution rather
+ *                   than freshly calculated, in which case it is reset
+ *                   with fdjac instead of giving up when progress is poor.
+ */
 int LogBroyden::bsolve(VecFVec<double,double> &F, UBVECTOR &x, UBVECTOR &fx,
-                       UBMATRIX & B, int &neval)
+                       UBMATRIX & B, int &neval, bool aIsReusedB)
 {
 #if !USE_LAPACK
   using boost::numeric::ublas::permutation_matrix;
@@ -377,7 +440,7 @@ int LogBroyden::bsolve(VecFVec<double,double> &F, UBVECTOR &x, UBVECTOR &fx,
   using boost::numeric::ublas::axpy_prod;
   using boost::numeric::ublas::inner_prod;
   int nrow = B.size1(), ncol = B.size2();
-  int ageB = 0;   // number of iterations since the last reset on B
+  int ageB = aIsReusedB ? 1 : 0;   // number of iterations since the last reset on B
   // svd decomposition elements (note nrow == ncol)
 #if USE_LAPACK
   UBMATRIX Usv(nrow,ncol),VTsv(ncol,ncol);
@@ -387,6 +450,19 @@ int LogBroyden::bsolve(VecFVec<double,double> &F, UBVECTOR &x, UBVECTOR &fx,
 #endif
 
   UBMATRIX Btmp(nrow, ncol);
+  SparseLinearSolver sparseSolver; // used instead of the above when mLinearSolver is not DENSE
+
+  // When mMaxLowRankUpdates > 0 we keep the factorization of the last
+  // Jacobian we factored, B0, and apply the Broyden updates to its
+  // inverse with the Sherman-Morrison formula.  Each update has the
+  // form B+^-1 = (I + p s^T) B^-1, so
+  //   B^-1 = (I + p_k s_k^T) ... (I + p_0 s_0^T) B0^-1
+  // which costs O(k n) to apply instead of O(n^3) to refactor.
+  bool haveFactor = false;
+  std::vector<UBVECTOR> lrS, lrP;
+#if !USE_LAPACK
+  UBMATRIX Blu;                 // L-U factors of B0 (B itself gets restored after each step)
+#endif
   ILogger &solverLog = ILogger::getLogger("solver_log");
   ILogger& worstMarketLog = ILogger::getLogger( "worst_market_log" );
   worstMarketLog.setLevel( ILogger::DEBUG );
@@ -410,12 +486,34 @@ int LogBroyden::bsolve(VecFVec<double,double> &F, UBVECTOR &x, UBVECTOR &fx,
   }
   // working space for variables that will be printed for solvable and unsolvable markets
   UBVECTOR rptvec_all(mktids_all.size());
+
+  // apply the current approximation of B^-1 (see haveFactor above)
+  auto applyBinv = [&](UBVECTOR &v) {
+    if(mLinearSolver != SparseLinearSolver::DENSE) {
+      sparseSolver.solve(v);
+    }
+    else {
+#if USE_LAPACK
+      svdInvertSolve(Usv,Ssv,VTsv,v, solverLog);
+#else
+      try {
+        lu_substitute(Blu,p,v);
+      }
+      catch (const boost::numeric::ublas::internal_logic &err) {
+        // ill-conditioned; see the comment on the same catch below
+      }
+#endif
+    }
+    for(size_t k=0; k<lrS.size(); ++k) {
+      v += lrP[k] * inner_prod(lrS[k], v);
+    }
+  };
   
   F(x,fx);
 
   solverLog.setLevel(ILogger::DEBUG);
   
-  neval += 1 + x.size();        // initial function evaluation + jacobian calculations
+  neval += aIsReusedB ? 1 : 1 + x.size(); // initial function evaluation + jacobian calculations
 
   const double FTINY = mFTOL*mFTOL;
 
@@ -483,78 +581,105 @@ int LogBroyden::bsolve(VecFVec<double,double> &F, UBVECTOR &x, UBVECTOR &fx,
     }
 
     Btmp = B;                   // save the jacobian approximant
-#if USE_LAPACK /* Solve using SVD */
-    int ierr = boost::numeric::bindings::lapack::gesvd('O','A','A', // control parameters
-                                                       B,           // input matrix
-                                                       Ssv,Usv,VTsv); // outputs
-    if(ierr>0) {
-      // svd failed.  It's not even clear under what circumstances
-      // this can happen
-      solverLog.setLevel(ILogger::SEVERE);
-      solverLog << "****************SVD failed.  This shouldn't happen.  It can't mean anything good.\n";
-      return ierr;
+    if(haveFactor && ageB > 0) {
+      // B differs from the factored B0 only by Broyden updates
+      dx = -1.0*fx;
+      applyBinv(dx);
+      solverLog << "Low-rank step using " << lrS.size() << " updates since last factorization.\n"
+                << "dx: " << dx << "\n";
+    }
+    else if(mLinearSolver != SparseLinearSolver::DENSE) {
+      int sing = sparseStep(F, x, fx, B, dx, sparseSolver);
+      f0 = inner_prod(fx,fx);   // fx may have changed if the Jacobian was salvaged
+      if(sing) {
+        return sing;
+      }
     }
+    else {
+#if USE_LAPACK /* Solve using SVD */
+      int ierr = boost::numeric::bindings::lapack::gesvd('O','A','A', // control parameters
+                                                         B,           // input matrix
+                                                         Ssv,Usv,VTsv); // outputs
+      if(ierr>0) {
+        // svd failed.  It's not even clear under what circumstances
+        // this can happen
+        solverLog.setLevel(ILogger::SEVERE);
+        solverLog << "****************SVD failed.  This shouldn't happen.  It can't mean anything good.\n";
+        return ierr;
+      }
 
-    // At this point, U, S, and VT contain the SVD of the original Jacobian
-    solverLog.setLevel(ILogger::DEBUG);
-    dx = -1.0*fx; 
-    int nsing = svdInvertSolve(Usv,Ssv,VTsv,dx, solverLog);
+      // At this point, U, S, and VT contain the SVD of the original Jacobian
+      solverLog.setLevel(ILogger::DEBUG);
+      dx = -1.0*fx; 
+      int nsing = svdInvertSolve(Usv,Ssv,VTsv,dx, solverLog);
 
-    solverLog << "\nIteration " << iter << "\nf0= " << f0
-              << "\tnsing= " << nsing
-              << "\nx: " << x << "\nF( x ): " << fx << "\ndx: " << dx << "\n";
+      solverLog << "\nIteration " << iter << "\nf0= " << f0
+                << "\tnsing= " << nsing
+                << "\nx: " << x << "\nF( x ): " << fx << "\ndx: " << dx << "\n";
 
 #else /* No USE_LAPACK.  Solve using L-U decomposition */
-    int itrial = 0;
-    /* If the L-U decomposition fails the first time around, we will
-       invoke the jacobian preconditioner and try again.  If it fails
-       a second time, we bail out */
-    do {
-      for(size_t i=0; i<p.size(); ++i) {
-        p[i] = i;
-      }
-      int sing = lu_factorize(B,p);
-      if(sing>0) {
-        int fail=1;
-        B = Btmp;           // restore Jacobian
-        if(itrial == 0) {
-            solverLog << "Salvaging Jacobian.\n";
-            fail = jacobian_precondition(x, fx, B, F, &solverLog, mLogPricep);
-            f0 = inner_prod(fx,fx);
-
-            // log the diagonal of the new jacobian
-            for(int j=0; j<F.narg(); ++j) {
-                jdiag[j] = B(j,j); 
-            }
-            solverLog << "After jacobian salvage.  diag( B )=\n" << jdiag << "\n";
-
+      int itrial = 0;
+      /* If the L-U decomposition fails the first time around, we will
+         invoke the jacobian preconditioner and try again.  If it fails
+         a second time, we bail out */
+      do {
+        for(size_t i=0; i<p.size(); ++i) {
+          p[i] = i;
         }
+        int sing = lu_factorize(B,p);
+        if(sing>0) {
+          int fail=1;
+          B = Btmp;           // restore Jacobian
+          if(itrial == 0) {
+              solverLog << "Salvaging Jacobian.\n";
+              fail = jacobian_precondition(x, fx, B, F, &solverLog, mLogPricep);
+              f0 = inner_prod(fx,fx);
+
+              // log the diagonal of the new jacobian
+              for(int j=0; j<F.narg(); ++j) {
+                  jdiag[j] = B(j,j); 
+              }
+              solverLog << "After jacobian salvage.  diag( B )=\n" << jdiag << "\n";
+
+          }
         
-        if( fail ) {
-            solverLog.setLevel(ILogger::WARNING);
-            solverLog << "Singular Jacobian:\n" << B << "\n";
-            return sing;
+          if( fail ) {
+              solverLog.setLevel(ILogger::WARNING);
+              solverLog << "Singular Jacobian:\n" << B << "\n";
+              return sing;
+          }
         }
+        else {
+          // L-U decomp was successful.  Continue with the next phase of the algorithm.
+          break;
+        }
+      } while(++itrial < 2);
+    
+      // J now holds the L-U decomposition of the Jacobian.  Attempt backsubstitution
+      dx = -1.0*fx;
+      try {
+        lu_substitute(B,p,dx);    // solve dx = J^-1 F
       }
-      else {
-        // L-U decomp was successful.  Continue with the next phase of the algorithm.
-        break;
+      catch (const boost::numeric::ublas::internal_logic &err) {
+        // This error seems to be thrown when the Jacobian is
+        // ill-conditioned.  We let it go because often the solver will
+        // muddle through to a solution.  If not, then it will
+        // eventually stop with a genuinely singular matrix.
       }
-    } while(++itrial < 2);
-    
-    // J now holds the L-U decomposition of the Jacobian.  Attempt backsubstitution
-    dx = -1.0*fx;
-    try {
-      lu_substitute(B,p,dx);    // solve dx = J^-1 F
-    }
-    catch (const boost::numeric::ublas::internal_logic &err) {
-      // This error seems to be thrown when the Jacobian is
-      // ill-conditioned.  We let it go because often the solver will
-      // muddle through to a solution.  If not, then it will
-      // eventually stop with a genuinely singular matrix.
-    }
-    solverLog << "dx: " << dx << "\n"; 
+      solverLog << "dx: " << dx << "\n"; 
 #endif /* USE_LAPACK */
+    }
+    if(mMaxLowRankUpdates > 0 && (!haveFactor || ageB == 0)) {
+      // we just factored B; it becomes the new base for the low-rank updates
+      haveFactor = true;
+      lrS.clear();
+      lrP.clear();
+#if !USE_LAPACK
+      if(mLinearSolver == SparseLinearSolver::DENSE) {
+        Blu = B;
+      }
+#endif
+    }
 
     // log the proposal step
     solverLog << "Proposal step magnitude dxmag= " << sqrt(inner_prod(dx,dx)) << "\n\n";
@@ -598,6 +723,7 @@ int LogBroyden::bsolve(VecFVec<double,double> &F, UBVECTOR &x, UBVECTOR &fx,
       if(msf < mFTOL) {
         // basically, we're letting ourselves converge to the sqrt of
         // our intended tolerance.
+        B = Btmp;
         return 0;
       }
 
@@ -655,6 +781,7 @@ int LogBroyden::bsolve(VecFVec<double,double> &F, UBVECTOR &x, UBVECTOR &fx,
       solverLog << "Solution successful.\n";
       x = xnew;
       fx = fxnew;
+      B = Btmp;                 // B may have been overwritten by its factorization
       return 0;                 // SUCCESS 
     }
 
@@ -691,6 +818,27 @@ int LogBroyden::bsolve(VecFVec<double,double> &F, UBVECTOR &x, UBVECTOR &fx,
       fxstep /= dx2;
       B += outer_prod(fxstep, xstep);
       ageB++;                // increment the age of B
+
+      if(haveFactor) {
+        if(lrS.size() >= mMaxLowRankUpdates) {
+          haveFactor = false;   // refactor on the next iteration
+        }
+        else {
+          // fxstep is now the u in B+ = B + u s^T.  By Sherman-Morrison,
+          // B+^-1 = (I + p s^T) B^-1 with p = -B^-1 u / (1 + s^T B^-1 u)
+          UBVECTOR Binvu(fxstep);
+          applyBinv(Binvu);
+          double denom = 1.0 + inner_prod(xstep, Binvu);
+          if(fabs(denom) < util::getSmallNumber()) {
+            solverLog << "Broyden update is nearly singular.  Refactoring on next iteration.\n";
+            haveFactor = false;
+          }
+          else {
+            lrS.push_back(xstep);
+            lrP.push_back(-Binvu / denom);
+          }
+        }
+      }
     }
     else {
       // Progress using the Broyden formula is anemic.  This usually
@@ -742,6 +890,118 @@ int LogBroyden::bsolve(VecFVec<double,double> &F, UBVECTOR &x, UBVECTOR &fx,
   return -1;
 }
 
+/*!
+ * \brief Look up the Jacobian accepted the last time the same markets
+ *        were solved.
+ * \details The Jacobian from this period, such as from the previous
+ *          target finder trial, is preferred over the one from the
+ *          previous period.  The cached Jacobian is rescaled with the
+ *          current scale factors of F.
+ * \param F The excess demand function about to be solved.
+ * \param aMarketNames The names of the markets being solved.
+ * \param aPeriod The period being solved.
+ * \param J Set to the cached Jacobian if one was found.
+ * \return Whether a cached Jacobian was found.
+ */
+bool LogBroyden::loadJacobian(const LogEDFun &F, const std::vector<std::string> &aMarketNames,
+                              int aPeriod, UBMATRIX &J) const
+{
+  const CachedJacobian *cached = 0;
+  for(int period = aPeriod; period >= aPeriod - 1 && !cached; --period) {
+    std::map<int, CachedJacobian>::const_iterator iter = mJacobianCache.find(period);
+    if(iter != mJacobianCache.end() && (*iter).second.mMarketNames == aMarketNames) {
+      cached = &(*iter).second;
+    }
+  }
+  const UBVECTOR &xscl = F.getInputScale();
+  const UBVECTOR &fxscl = F.getOutputScale();
+  if(!cached || !isValidScale(xscl) || !isValidScale(fxscl)) {
+    return false;
+  }
+
+  for(size_t j=0; j<J.size2(); ++j) {
+    for(size_t i=0; i<J.size1(); ++i) {
+      J(i,j) = cached->mJacobian(i,j) * fxscl[i] * xscl[j];
+    }
+  }
+
+  ILogger &solverLog = ILogger::getLogger("solver_log");
+  solverLog.setLevel(ILogger::NOTICE);
+  solverLog << "Reusing the Jacobian accepted for these markets, skipping fdjac.\n";
+  return true;
+}
+
+/*!
+ * \brief Keep the Jacobian accepted by a successful solution so that it
+ *        may be used as the initial approximation for the same markets.
+ * \param F The excess demand function which was solved.
+ * \param aMarketNames The names of the markets which were solved.
+ * \param aPeriod The period which was solved.
+ * \param J The accepted Jacobian.
+ */
+void LogBroyden::saveJacobian(const LogEDFun &F, const std::vector<std::string> &aMarketNames,
+                              int aPeriod, const UBMATRIX &J)
+{
+  const UBVECTOR &xscl = F.getInputScale();
+  const UBVECTOR &fxscl = F.getOutputScale();
+  if(!isValidScale(xscl) || !isValidScale(fxscl)) {
+    mJacobianCache.erase(aPeriod);
+    return;
+  }
+  CachedJacobian &cached = mJacobianCache[aPeriod];
+  cached.mMarketNames = aMarketNames;
+  cached.mJacobian.resize(J.size1(), J.size2(), false);
+  for(size_t j=0; j<J.size2(); ++j) {
+    for(size_t i=0; i<J.size1(); ++i) {
+      cached.mJacobian(i,j) = J(i,j) / (fxscl[i] * xscl[j]);
+    }
+  }
+}
+
+/*! \brief Compute the Broyden step dx = -B^-1 F using a sparse linear solver
+ *
+ *  \details This is the counterpart of the dense L-U block in bsolve
+ *           for the sparse-lu and gmres linear solvers.  As with the
+ *           dense solver, if the factorization fails we salvage the
+ *           Jacobian with jacobian_precondition() and try once more.
+ *           Unlike the dense solver, B is left intact.
+ *  \return 0 on success, or the singular column reported by the
+ *          factorization if the Jacobian could not be salvaged.
+ */
+int LogBroyden::sparseStep(VecFVec<double,double> &F, UBVECTOR &x, UBVECTOR &fx,
+                           UBMATRIX &B, UBVECTOR &dx, SparseLinearSolver &aSolver)
+{
+  ILogger &solverLog = ILogger::getLogger("solver_log");
+  int sing = aSolver.factorize(B, mLinearSolver);
+  if(sing>0) {
+    solverLog << "Salvaging Jacobian.\n";
+    int fail = jacobian_precondition(x, fx, B, F, &solverLog, mLogPricep);
+    if(!fail) {
+      sing = aSolver.factorize(B, mLinearSolver);
+    }
+    if(fail || sing>0) {
+      solverLog.setLevel(ILogger::WARNING);
+      solverLog << "Singular Jacobian:\n" << B << "\n";
+      return sing;
+    }
+  }
+  solverLog << SparseLinearSolver::getMethodName(mLinearSolver) << ": density= " << aSolver.getDensity()
+            << "  factor nnz= " << aSolver.getFactorSize() << "\n";
+
+  dx = -1.0*fx;
+  if(aSolver.solve(dx) != 0) {
+    // As with the ill-conditioned case in the dense solver, we let
+    // this go and let the line search decide whether the step is
+    // usable.
+    solverLog << "GMRES did not converge in " << aSolver.getLastIterations() << " iterations.\n";
+  }
+  else if(mLinearSolver == SparseLinearSolver::GMRES) {
+    solverLog << "GMRES iterations= " << aSolver.getLastIterations() << "\n";
+  }
+  solverLog << "dx: " << dx << "\n";
+  return 0;
+}
+
 /*! \brief Write a vector into the solver data log
  *
  *  \details We write the solver data log in "long" format; i.e., with
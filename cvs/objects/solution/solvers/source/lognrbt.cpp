@@ -130,7 +130,10 @@ bool LogNRbt::XMLParse( const DOMNode* aNode ) {
         }
         else if(nodeName == "log-price") {
           mLogPricep = true;    // not strictly necessary, as this is the default.
-        } 
+        }
+        else if(nodeName == "sparse-jacobian") {
+          mSparseJacobian = XMLHelper<bool>::getValue( curr );
+        }
         else if( SolutionInfoFilterFactory::hasSolutionInfoFilter( nodeName ) ) {
             mSolutionInfoFilter.reset( SolutionInfoFilterFactory::createAndParseSolutionInfoFilter( nodeName, curr ) );
         }
@@ -213,6 +216,7 @@ SolverComponent::ReturnCode LogNRbt::solve( SolutionInfoSet& solnset, int period
 
     // This is the closure that will evaluate the ED function
     LogEDFun F(solnset, world, marketplace, period, mLogPricep); 
+    F.setSparseJacobian( mSparseJacobian );
 
     // scale the initial guess for use in F
     F.scaleInitInputs(x);
@@ -62,6 +62,18 @@ SolverComponent::SolverComponent( Marketplace* marketplaceIn, World* worldIn, Ca
 SolverComponent::~SolverComponent(){
 }
 
+/*!
+ * \brief Whether this component starts from information kept from earlier
+ *        solutions of the scenario.
+ * \details A component which does may find a different solution depending on
+ *          which runs of the scenario came before, so runs can not be made
+ *          independently of each other.
+ * \return False by default.
+ */
+bool SolverComponent::reusesPriorSolutions() const {
+    return false;
+}
+
 //! Struct constructor
 SolverComponent::IterationInfo::IterationInfo( const std::string& aName, const double aRED )
 :mName( aName ), mRED( aRED ){}
@@ -139,6 +139,20 @@ bool UserConfigurableSolver::XMLParse( const DOMNode* aNode ) {
     return true;
 }
 
+/*!
+ * \brief Whether any of the solver components start from information kept from
+ *        earlier solutions of the scenario.
+ * \return True if any solver component reuses prior solutions.
+ */
+bool UserConfigurableSolver::reusesPriorSolutions() const {
+    for( vector<SolverComponent*>::const_iterator it = mSolverComponents.begin(); it != mSolverComponents.end(); ++it ) {
+        if( (*it)->reusesPriorSolutions() ) {
+            return true;
+        }
+    }
+    return false;
+}
+
 //! Initialize the solver at the beginning of the model.
 void UserConfigurableSolver::init() {
     /*!
@@ -44,6 +44,7 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <memory>
 #include "marketplace/include/marketplace.h"
 #include "containers/include/world.h"
 #include "solution/util/include/solution_info_set.h"
@@ -51,6 +52,8 @@
 
 #define UBVECTOR boost::numeric::ublas::vector
 
+class JacobianColoring;
+
 /*!
  * \class LogEDFun "solution/util/include/edfun.hpp"
  * \brief Functor for computing the GCAM excess demand in log space
@@ -95,16 +98,33 @@ class LogEDFun : public VecFVec<double,double>
   int period;
   bool mLogPricep;               //!< Flag indicating whether inputs are prices or log-prices
 
+  //! Structural sparsity and column grouping of the Jacobian.  Only
+  //! set if the solver asked for sparse Jacobians.
+  std::auto_ptr<JacobianColoring> mColoring;
+
+  //! Flag indicating partial derivatives should run the flow graph
+  //! of the perturbed markets rather than calculate in serial.
+  bool mParallelPartial;
+
   // diagnostic variables
   std::vector<double> mstate;
+
+  void evaluate(const UBVECTOR<double> &x, UBVECTOR<double> &fx, const std::vector<int> &partjs);
 public:
   LogEDFun(SolutionInfoSet &sisin, World *w, Marketplace *m, int per, bool aLogPricep=true);
+  ~LogEDFun();
   
   // basic vector function interface
   virtual void operator()(const UBVECTOR<double> &x, UBVECTOR<double> &fx, const int partj=-1);
   virtual void partial(int ip);
   virtual double partialSize(int ip) const;
+  virtual void partialGroup(const UBVECTOR<double> &x, UBVECTOR<double> &fx, const std::vector<int> &cols);
+  virtual const JacobianColoring *getJacobianColoring() const;
   void scaleInitInputs(UBVECTOR<double> &ax);
+  const UBVECTOR<double> &getInputScale() const;
+  const UBVECTOR<double> &getOutputScale() const;
+  void setSparseJacobian(bool aSparse);
+  virtual void setParallelPartial(bool aParallel);
 
   // Constants to protect against overflow: 
   static const double PMAX;            //!< Greatest allowable price
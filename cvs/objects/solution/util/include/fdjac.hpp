@@ -57,11 +57,14 @@
 #if GCAM_PARALLEL_ENABLED
 #include <tbb/task_group.h>
 #include <tbb/parallel_for_each.h>
+#include <tbb/parallel_for.h>
 #endif
 
 #include "util/base/include/timer.h"
+#include "util/base/include/trace_recorder.h"
 #include "containers/include/scenario.h"
 #include "util/base/include/manage_state_variables.hpp"
+#include "solution/util/include/jacobian_coloring.hpp"
 
 extern Scenario* scenario;
 
@@ -104,6 +107,56 @@ inline void jacol(VecFVec<FTYPE,FTYPE> &F, const UBLAS::vector<FTYPE> &x,
 }
 
 
+/*!
+ * Compute all of the Jacobian columns in a single color group with
+ * one function evaluation.  The columns in a group are structurally
+ * orthogonal, so each row that changes can be attributed to exactly
+ * one of the perturbed columns; all other entries in those columns
+ * are structurally zero.
+ */
+template<class FTYPE,class MTRAIT>
+inline void jacgroup(VecFVec<FTYPE,FTYPE> &F, const UBLAS::vector<FTYPE> &x,
+                     const UBLAS::vector<FTYPE> &fx, const JacobianColoring &coloring,
+                     size_t g, UBLAS::matrix<FTYPE,MTRAIT> &J,
+                     std::ostream *diagnostic=NULL) {
+  const FTYPE heps = 1.0e-6;
+  const FTYPE TINY = 1.0e-6;
+  const std::vector<int> &cols = coloring.getGroup(g);
+  UBLAS::vector<FTYPE> xx(x); // temporary, so we can respect the const on x
+  UBLAS::vector<FTYPE> fxx(fx.size());        // hold the values of F(xx)
+  std::vector<FTYPE> hinv(cols.size());
+
+  for(size_t k=0; k<cols.size(); ++k) {
+    int j = cols[k];
+    FTYPE t = x[j];
+    FTYPE h = heps * (fabs(t)+TINY);
+    xx[j] = t+h;
+    h     = xx[j]-t; // reduce roundoff error
+    hinv[k] = 1.0/h;
+  }
+  if(diagnostic) {
+    (*diagnostic) << "group= " << g << "\tncol= " << cols.size() << "\nxx:\n" << xx << "\n";
+  }
+  F.partial(cols[0]);       // hint to the function that this is a partial derivative calculation
+  F.partialGroup(xx, fxx, cols);
+
+  if(diagnostic) {
+    (*diagnostic) << "fxx:\n" << fxx << "\n";
+  }
+
+  for(size_t k=0; k<cols.size(); ++k) {
+    int j = cols[k];
+    for(size_t i=0; i<fxx.size(); ++i) {
+      J(i,j) = 0.0;
+    }
+    const std::vector<int> &rows = coloring.getNonzeroRows(j);
+    for(size_t r=0; r<rows.size(); ++r) {
+      J(rows[r],j) = (fxx[rows[r]] - fx[rows[r]]) * hinv[k];
+    }
+  }
+}
+
+
 /*!
  * Compute the Jacobian of a vector function F at point x.
  * \param[in] F: The function to have its Jacobian calculated
@@ -135,7 +188,9 @@ void fdjac(VecFVec<FTYPE,FTYPE> &F, const UBLAS::vector<FTYPE> &x,
  * \param[out] J: The Jacobian of F
  * \param[in] usepartial: (optional) use partial model evaluation for partial derivatives
  * \param[in] diagnostic: (optional) ostream pointer to which to send additional diagnostics
- *
+ * \remark If F can supply a JacobianColoring and we are using partial
+ *         evaluations, the columns are computed a color group at a
+ *         time rather than one at a time.
  */
 template<class FTYPE, class MTRAIT>
 void fdjac(VecFVec<FTYPE,FTYPE> &F, const UBLAS::vector<FTYPE> &x,
@@ -149,23 +204,51 @@ void fdjac(VecFVec<FTYPE,FTYPE> &F, const UBLAS::vector<FTYPE> &x,
 
   Timer& jacTimer = TimerRegistry::getInstance().getTimer( TimerRegistry::JACOBIAN );
   jacTimer.start();
+  TraceScope jacScope( "solver", "fdjac" );
     if(usepartial) { scenario->getManageStateVariables()->setPartialDeriv(true); }
+    const JacobianColoring *coloring = usepartial ? F.getJacobianColoring() : 0;
   
 #if !GCAM_PARALLEL_ENABLED
-  for(size_t j=0; j<x.size(); ++j) {
-    jacol(F, x, fx, j, J, usepartial, diagnostic);
+  if(coloring) {
+    for(size_t g=0; g<coloring->getNumGroups(); ++g) {
+      jacgroup(F, x, fx, *coloring, g, J, diagnostic);
+    }
+  }
+  else {
+    for(size_t j=0; j<x.size(); ++j) {
+      jacol(F, x, fx, j, J, usepartial, diagnostic);
+    }
   }
 #else
-    tbb::task_arena& threadPool = scenario->getManageStateVariables()->mThreadPool;
+    ManageStateVariables* stateManager = scenario->getManageStateVariables();
+    tbb::task_arena& threadPool = stateManager->mThreadPool;
+    // Running the columns in parallel is the most efficient since each one is
+    // independent.  However when there are fewer columns than threads the rest
+    // would sit idle, so in that case also let each partial derivative calculate
+    // in parallel which TBB will nest within the column tasks.
+    const size_t ntask = coloring ? coloring->getNumGroups() : x.size();
+    const bool intraColumn = usepartial && ntask < size_t(threadPool.max_concurrency());
+    F.setParallelPartial(intraColumn);
     tbb::task_group tg;
     threadPool.execute([&](){
         tg.run([&](){
-            tbb::parallel_for_each( x, [&]( const FTYPE& j ) {
-                jacol(F, x, fx, (&j - &x[0]), J, usepartial, 0/*diagnostic*/);
-            });
+            // each task binds its own scratch state for the duration of the partial
+            if(coloring) {
+                tbb::parallel_for( size_t(0), coloring->getNumGroups(), [&]( size_t g ) {
+                    ManageStateVariables::StateHandle state( stateManager );
+                    jacgroup(F, x, fx, *coloring, g, J, 0/*diagnostic*/);
+                });
+            }
+            else {
+                tbb::parallel_for_each( x, [&]( const FTYPE& j ) {
+                    ManageStateVariables::StateHandle state( usepartial ? stateManager : 0 );
+                    jacol(F, x, fx, (&j - &x[0]), J, usepartial, 0/*diagnostic*/);
+                });
+            }
         });
     });
     threadPool.execute([&tg](){ tg.wait(); });
+    F.setParallelPartial(false);
 #endif
     if(usepartial) { F.partial(-1); }
 
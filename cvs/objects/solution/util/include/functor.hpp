@@ -45,10 +45,13 @@
  */
 
 #include <iostream>
+#include <vector>
 #include <boost/numeric/ublas/vector.hpp> 
 
 #define UBVECTOR boost::numeric::ublas::vector
 
+class JacobianColoring;
+
 /*!
  * @class VecFVec
  * @brief Base class template for vector function of a vector argument 
@@ -110,6 +113,44 @@ public:
    * derivative.
    */
   virtual double partialSize(int ip) const {return 1.0;}
+  /*!
+   * Evaluate the function for a group of simultaneous partial derivatives
+   *
+   * The elements of the input vector listed in cols have all been
+   * perturbed.  The caller warrants that the columns are structurally
+   * orthogonal (see getJacobianColoring()), so a function that knows
+   * its own sparsity can restrict the evaluation to the parts of the
+   * calculation affected by those elements.  As with partial(), the
+   * caller will have called partial(cols[0]) first.  The default
+   * implementation does a full evaluation.
+   * @param[in] arg: argument vector
+   * @param[out] rval: return value vector
+   * @param[in] cols: indices of the perturbed elements of arg
+   */
+  virtual void partialGroup(const UBVECTOR<Ta> &arg, UBVECTOR<Tr> &rval, const std::vector<int> &cols) {
+    operator()(arg, rval, -1);
+  }
+  /*!
+   * Returns the structural sparsity and column grouping of the
+   * Jacobian, if the function is able to provide one.  Subroutines
+   * like fdjac will use it to compute several columns with a single
+   * evaluation.  The default is NULL, meaning the Jacobian should be
+   * treated as dense.
+   */
+  virtual const JacobianColoring *getJacobianColoring() const {return 0;}
+  /*!
+   * Indicates whether subsequent partial derivative evaluations may
+   * themselves run in parallel
+   *
+   * Subroutines like fdjac normally run several partial derivatives
+   * at once, each evaluated serially.  When there are too few of them
+   * to keep every thread busy they may ask the function to parallelize
+   * within each evaluation instead.  Implementations must be able to
+   * evaluate different partial derivatives concurrently while this is
+   * set.  The default implementation ignores this hint.
+   * @param[in] aParallel: whether to parallelize within partial evaluations
+   */
+  virtual void setParallelPartial(bool aParallel) {}
   /*!
    * Turns on implementation-defined diagnostics (default is no-op)
    */
@@ -0,0 +1,102 @@
+#ifndef JACOBIAN_COLORING_HPP_
+#define JACOBIAN_COLORING_HPP_
+
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file jacobian_coloring.hpp
+ * \ingroup Solution
+ * \brief Structural sparsity pattern and column coloring for finite-difference Jacobians
+ */
+
+#include <vector>
+
+class SolutionInfo;
+
+/*!
+ * \class JacobianColoring
+ * \brief Groups the columns of the market Jacobian into sets that can be
+ *        evaluated with a single partial model calculation.
+ *
+ * \details The MarketDependencyFinder already tells us, for each
+ * solved market, the complete list of activities that must be
+ * recalculated when its price changes (SolutionInfo::getDependencies).
+ * Any activity that adds to the supply or demand of a market is
+ * itself dependent on that market's price (demanders pay it,
+ * suppliers are linked to it), so the supply and demand of market i
+ * can only change in response to a change in the price of market j
+ * if the dependency lists of i and j share at least one activity.
+ * That gives us a structural sparsity pattern for the Jacobian
+ * without evaluating the model.
+ *
+ * Two columns are structurally orthogonal if they have no nonzero
+ * rows in common.  Such columns may be perturbed at the same time:
+ * their dependency lists are necessarily disjoint (otherwise each
+ * would be a nonzero in the other's row), and each row that changes
+ * can be attributed unambiguously to the one column that could have
+ * changed it.  We group the columns using the greedy largest-first
+ * coloring of Curtis, Powell, and Reid.
+ *
+ * Because the dependency lists are closed under the "is downstream
+ * of" relation, activities in disjoint lists never depend on one
+ * another, so the union of the lists for a group can be calculated
+ * by simply concatenating them.
+ */
+class JacobianColoring
+{
+public:
+    JacobianColoring( const std::vector<SolutionInfo>& aMarkets );
+
+    //! Number of color groups (i.e., partial model evaluations per Jacobian)
+    size_t getNumGroups() const {return mGroups.size();}
+
+    //! Columns belonging to color group aGroup
+    const std::vector<int>& getGroup( const size_t aGroup ) const {return mGroups[aGroup];}
+
+    //! Rows in column aCol that are structurally nonzero
+    const std::vector<int>& getNonzeroRows( const int aCol ) const {return mColumnRows[aCol];}
+
+    //! Fraction of the dense Jacobian entries that are structurally nonzero
+    double getDensity() const;
+
+private:
+    //! The column indices in each color group
+    std::vector<std::vector<int> > mGroups;
+
+    //! The structurally nonzero row indices for each column
+    std::vector<std::vector<int> > mColumnRows;
+};
+
+#endif
@@ -77,7 +77,7 @@ class SolutionInfo {
     }
 public:
 #if GCAM_PARALLEL_ENABLED
-    SolutionInfo( Market* linkedMarket, const std::vector<IActivity*>& aDependenicies, GcamFlowGraph* aFlowGraph );
+    SolutionInfo( Market* linkedMarket, const std::vector<IActivity*>& aDependenicies, const int aMarketNumber );
 #else
     SolutionInfo( Market* linkedMarket, const std::vector<IActivity*>& aDependenicies );
 #endif
@@ -136,7 +136,8 @@ public:
     
     const IInfo* getMarketInfo() const;
 #if GCAM_PARALLEL_ENABLED
-    GcamFlowGraph* getFlowGraph() const;
+    GcamFlowGraph* acquireFlowGraph() const;
+    void releaseFlowGraph() const;
 #endif
     void printDerivatives( std::ostream& aOut ) const;
     /*!
@@ -169,9 +170,9 @@ private:
     std::vector<IActivity*> mDependencies;
 
 #if GCAM_PARALLEL_ENABLED
-    //! A pointer weak pointer to a flow graph which can be used recalculate if this
-    // solution info adjusts it's price.
-    GcamFlowGraph* mFlowGraph;
+    //! The index of the linked market in the marketplace which is used to look
+    //! up the flow graph to recalculate if this solution info adjusts it's price.
+    int mMarketNumber;
 #endif
     
     //! Market specific solution tolerance
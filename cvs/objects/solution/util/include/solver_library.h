@@ -61,6 +61,7 @@ class SolutionInfo;
 class SolutionInfoSet;
 class CalcCounter;
 class ISolutionInfoFilter;
+class SparseLinearSolver;
 namespace objects {
     class Atom;
 }
@@ -91,7 +92,8 @@ public:
    static void updateMatrices( SolutionInfoSet& sol, Matrix& JFSM, Matrix& JFDM, Matrix& JF );
 
    static bool calculateNewPricesLogNR( SolutionInfoSet& aSolutionSet, Matrix& JFLUFactorized,
-                                        PermutationMatrix& aPermMatrix, const double aDefaultMaxPriceJump ); 
+                                        PermutationMatrix& aPermMatrix, const double aDefaultMaxPriceJump,
+                                        const SparseLinearSolver* aSparseSolver = 0 ); 
 
    static bool bracket( Marketplace* aMarketplace, World* aWorld, const double aDefaultBracketInterval,
                         const unsigned int aMaxIterations, SolutionInfoSet& aSolSet, CalcCounter* aCalcCounter,
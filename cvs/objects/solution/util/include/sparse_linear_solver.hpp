@@ -0,0 +1,185 @@
+#ifndef SPARSE_LINEAR_SOLVER_HPP_
+#define SPARSE_LINEAR_SOLVER_HPP_
+
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file sparse_linear_solver.hpp
+ * \ingroup Solution
+ * \brief Sparse direct and iterative solvers for the Newton step J*dx = -F
+ */
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <boost/numeric/ublas/vector.hpp>
+
+/*!
+ * \class SparseLinearSolver
+ * \brief Solves the linear system for the Newton/Broyden step without
+ *        forming a dense factorization.
+ *
+ * \details The market Jacobian is block sparse: most markets are
+ * regional and interact only with the other markets in their region
+ * plus a handful of global markets.  The dense LU (or SVD) costs
+ * O(n^3) regardless, which comes to dominate the solver as the number
+ * of markets grows.  This class offers two alternatives:
+ *
+ * - SPARSE_LU: the matrix is symmetrically permuted with a minimum
+ *   degree ordering of the pattern of A+A^T to limit fill-in, then
+ *   factored with threshold partial pivoting (the diagonal is
+ *   preferred whenever it is within mPivotThreshold of the largest
+ *   candidate in its column, which keeps the fill-reducing order
+ *   mostly intact).
+ *
+ * - GMRES: restarted GMRES on the original matrix, right
+ *   preconditioned with an incomplete LU factorization having the
+ *   sparsity pattern of A (ILU(0)).  A zero pivot in the incomplete
+ *   factorization is reported the same way as a singular matrix, so
+ *   callers can fall back to jacobian_precondition() exactly as they
+ *   do for the dense LU.
+ *
+ * The matrix is passed in dense form (that is what fdjac and the
+ * Broyden update produce); entries that are exactly zero, which
+ * includes everything outside the structural pattern when the
+ * Jacobian coloring is in use, are dropped.
+ */
+class SparseLinearSolver
+{
+public:
+    //! The available linear solver backends.
+    enum Method {
+        DENSE,
+        SPARSE_LU,
+        GMRES
+    };
+
+    SparseLinearSolver();
+
+    static Method parseMethod( const std::string& aName );
+    static const std::string& getMethodName( const Method aMethod );
+
+    /*!
+     * \brief Factorize (or precondition) the matrix A.
+     * \param aA Any ublas matrix-like type; only element access is used.
+     * \param aMethod Which backend to use.  Must not be DENSE.
+     * \return 0 on success or the (1-based) step at which a zero pivot was
+     *         encountered, following the convention of ublas::lu_factorize.
+     */
+    template<class MatrixType>
+    int factorize( const MatrixType& aA, const Method aMethod ) {
+        const size_t n = aA.size1();
+        mRowStart.assign( 1, 0 );
+        mColIndex.clear();
+        mValue.clear();
+        for( size_t i = 0; i < n; ++i ) {
+            for( size_t j = 0; j < n; ++j ) {
+                double aij = aA( i, j );
+                if( aij != 0.0 ) {
+                    mColIndex.push_back( j );
+                    mValue.push_back( aij );
+                }
+            }
+            mRowStart.push_back( mColIndex.size() );
+        }
+        mMethod = aMethod;
+        return aMethod == GMRES ? factorizeILU() : factorizeLU();
+    }
+
+    int solve( boost::numeric::ublas::vector<double>& aB ) const;
+
+    //! Fraction of the dense matrix entries that were nonzero
+    double getDensity() const {
+        size_t n = mRowStart.size() - 1;
+        return n == 0 ? 0.0 : double( mValue.size() ) / ( double( n ) * double( n ) );
+    }
+
+    //! Number of nonzeros in the factors (sparse LU) or preconditioner (GMRES)
+    size_t getFactorSize() const;
+
+    //! Number of GMRES iterations used in the last solve
+    int getLastIterations() const {return mLastIter;}
+
+private:
+    int factorizeLU();
+    int factorizeILU();
+    void minimumDegreeOrder();
+    void multiply( const std::vector<double>& aX, std::vector<double>& aY ) const;
+    void applyILU( std::vector<double>& aX ) const;
+    int gmres( std::vector<double>& aB ) const;
+
+    //! The backend used for the last factorization
+    Method mMethod;
+
+    //! The input matrix in compressed sparse row form
+    std::vector<size_t> mRowStart;
+    std::vector<int> mColIndex;
+    std::vector<double> mValue;
+
+    //! Symmetric fill-reducing permutation: position k holds original index mPerm[k]
+    std::vector<int> mPerm;
+
+    //! Row (in permuted order) chosen as the pivot at each elimination step
+    std::vector<int> mPivotRow;
+
+    //! Multipliers from each elimination step: (row, multiplier) pairs
+    std::vector<std::vector<std::pair<int, double> > > mLCols;
+
+    //! Rows of U (in step order) as (column step, value) pairs; the diagonal is first
+    std::vector<std::vector<std::pair<int, double> > > mURows;
+
+    //! ILU(0) factors stored on the pattern of the input matrix
+    std::vector<double> mILU;
+
+    //! Position of the diagonal within each row of mILU
+    std::vector<size_t> mDiag;
+
+    //! Relative pivot threshold for the sparse LU
+    double mPivotThreshold;
+
+    //! GMRES relative residual tolerance
+    double mTol;
+
+    //! GMRES restart length
+    int mRestart;
+
+    //! GMRES maximum total iterations
+    int mMaxIter;
+
+    //! GMRES iterations used in the last solve
+    mutable int mLastIter;
+};
+
+#endif
@@ -42,8 +42,10 @@
 #include "util/logger/include/ilogger.h"
 #include "containers/include/scenario.h"
 #include "util/base/include/manage_state_variables.hpp"
+#include "solution/util/include/jacobian_coloring.hpp"
 
 #include "util/base/include/timer.h"
+#include "util/base/include/trace_recorder.h"
 
 #define UBVECTOR boost::numeric::ublas::vector 
 
@@ -59,7 +61,8 @@ LogEDFun::LogEDFun(SolutionInfoSet &sisin,
     mkts(sisin.getSolvableSet()),
     solnset(sisin),
     world(w), mktplc(m), period(per),
-    mLogPricep(aLogPricep)
+    mLogPricep(aLogPricep),
+    mParallelPartial(false)
 {
     na=nr=mkts.size();
     mdiagnostic=false;
@@ -106,6 +109,55 @@ LogEDFun::LogEDFun(SolutionInfoSet &sisin,
     } 
 }
 
+LogEDFun::~LogEDFun()
+{
+}
+
+/*!
+ * \brief Turn on structural sparsity information for fdjac
+ * \details When enabled we compute the sparsity pattern of the
+ *          Jacobian from the market dependencies and group
+ *          structurally orthogonal columns so that fdjac can
+ *          evaluate each group with a single partial model
+ *          calculation.
+ * \sa JacobianColoring
+ */
+void LogEDFun::setSparseJacobian(bool aSparse)
+{
+    if(!aSparse) {
+        mColoring.reset();
+        return;
+    }
+    mColoring.reset(new JacobianColoring(mkts));
+
+    ILogger &solverlog = ILogger::getLogger("solver_log");
+    solverlog.setLevel(ILogger::DEBUG);
+    solverlog << "Sparse Jacobian: " << mkts.size() << " columns in "
+              << mColoring->getNumGroups() << " groups, structural density= "
+              << mColoring->getDensity() << "\n";
+}
+
+const JacobianColoring *LogEDFun::getJacobianColoring() const
+{
+    return mColoring.get();
+}
+
+/*!
+ * \brief Calculate partial derivatives with each market's flow graph
+ * \details When enabled each partial derivative runs the flow graph
+ *          of the activities which depend on the perturbed market
+ *          rather than calculating those activities in serial.  Since
+ *          each market has its own graph several partial derivatives
+ *          can still be calculated at once.  The graphs are cached by
+ *          the MarketDependencyFinder.
+ */
+void LogEDFun::setParallelPartial(bool aParallel)
+{
+    mParallelPartial = aParallel;
+    // Markets must guard against concurrent additions within a partial.
+    Marketplace::mIsParallelDerivativeCalc = aParallel;
+}
+
 /*!
  * \brief scale a solver's initial inputs as necessary using the xscl vector 
  * \details When a solver sets up its initial-guess input vector, we
@@ -119,6 +171,24 @@ void LogEDFun::scaleInitInputs(UBVECTOR<double> &ax)
         ax[i] /= mxscl[i];
 }
 
+/*!
+ * \brief Get the factors the solver's inputs are multiplied by to get
+ *        the (log) prices.
+ */
+const UBVECTOR<double> &LogEDFun::getInputScale() const
+{
+    return mxscl;
+}
+
+/*!
+ * \brief Get the factors the excess demands are multiplied by to get
+ *        the solver's outputs.
+ */
+const UBVECTOR<double> &LogEDFun::getOutputScale() const
+{
+    return mfxscl;
+}
+
 
 void LogEDFun::partial(int ip)
 {
@@ -146,6 +216,32 @@ double LogEDFun::partialSize(int ip) const
 }
 
 void LogEDFun::operator()(const UBVECTOR<double> &ax, UBVECTOR<double> &fx, const int partj)
+{
+  evaluate(ax, fx, partj < 0 ? std::vector<int>() : std::vector<int>(1, partj));
+}
+
+/*!
+ * \brief Evaluate the excess demands for a group of partial derivatives
+ * \details All of the elements of ax listed in cols will have been
+ *          perturbed.  The columns must be structurally orthogonal
+ *          (as grouped by JacobianColoring), which guarantees their
+ *          dependency lists are disjoint and independent, so we can
+ *          recalculate them one after another in a single pass.
+ */
+void LogEDFun::partialGroup(const UBVECTOR<double> &ax, UBVECTOR<double> &fx, const std::vector<int> &cols)
+{
+  evaluate(ax, fx, cols);
+}
+
+/*!
+ * \brief Evaluate the excess demands
+ * \param ax The (scaled) input vector
+ * \param fx The output vector
+ * \param partjs The inputs that have been perturbed for a partial
+ *        derivative calculation.  If empty a full model evaluation
+ *        is done.
+ */
+void LogEDFun::evaluate(const UBVECTOR<double> &ax, UBVECTOR<double> &fx, const std::vector<int> &partjs)
 {
   assert(ax.size() == mkts.size());
   assert(fx.size() == mkts.size());
@@ -171,7 +267,7 @@ void LogEDFun::operator()(const UBVECTOR<double> &ax, UBVECTOR<double> &fx, cons
    **** point.
    ****/
   
-  if(partj < 0) {               // not a partial derivative calculation
+  if(partjs.empty()) {          // not a partial derivative calculation
     /****
      * 1A Set the model inputs using the solutionInfo objects (full eval version)
      ****/
@@ -206,6 +302,7 @@ void LogEDFun::operator()(const UBVECTOR<double> &ax, UBVECTOR<double> &fx, cons
      ****/ 
     Timer& evalFullTimer = TimerRegistry::getInstance().getTimer( TimerRegistry::EVAL_FULL );
     evalFullTimer.start();
+    TraceScope evalScope( "solver", "full evaluation" );
 #if GCAM_PARALLEL_ENABLED
     world->calc(period, world->getGlobalFlowGraph());
 #else
@@ -225,10 +322,13 @@ void LogEDFun::operator()(const UBVECTOR<double> &ax, UBVECTOR<double> &fx, cons
       ILogger &solverlog = ILogger::getLogger("solver_log");
       solverlog.setLevel(ILogger::DEBUG);
 
-      solverlog << "j= " << partj <<"\tprice  \tsupply \tdemand\tmarket"
-                << "old   \t" << mkts[partj].getPrice() << "\t" << mkts[partj].getSupply()
-                << "\t" << mkts[partj].getDemand()
-                << "\t" << mkts[partj].getName() << "\n";
+      for(size_t k=0; k<partjs.size(); ++k) {
+        const int partj = partjs[k];
+        solverlog << "j= " << partj <<"\tprice  \tsupply \tdemand\tmarket"
+                  << "old   \t" << mkts[partj].getPrice() << "\t" << mkts[partj].getSupply()
+                  << "\t" << mkts[partj].getDemand()
+                  << "\t" << mkts[partj].getName() << "\n";
+      }
     }
     
     // In theory the loop over markets is unnecessary, and we need
@@ -251,32 +351,64 @@ void LogEDFun::operator()(const UBVECTOR<double> &ax, UBVECTOR<double> &fx, cons
         // change and the rest were reset from stored values.  In theory
         // those reset prices are the same as in x however there may be some
         // slight differences due to roundoff error.
-        mkts[partj].setPrice(x[partj]);
+        for(size_t k=0; k<partjs.size(); ++k) {
+            mkts[partjs[k]].setPrice(x[partjs[k]]);
+        }
     }
 
     /****
      * 2B Evaluate the model (partial derivative version)
      ****/
-    const std::vector<IActivity*>& affectedNodes = mkts[partj].getDependencies();
+    std::vector<IActivity*> groupNodes;
+    if(partjs.size() > 1) {
+      // The dependency lists of a column group are disjoint and none of
+      // them depends on another so they can simply be calculated in turn.
+      for(size_t k=0; k<partjs.size(); ++k) {
+        const std::vector<IActivity*>& deps = mkts[partjs[k]].getDependencies();
+        groupNodes.insert(groupNodes.end(), deps.begin(), deps.end());
+      }
+    }
+    const std::vector<IActivity*>& affectedNodes = partjs.size() > 1 ? groupNodes :
+        mkts[partjs[0]].getDependencies();
     /* \invariant At least one node is affected */
     assert(!affectedNodes.empty());
     edfunMiscTimer.stop();
     edfunPreTimer.stop();
     Timer& evalPartTimer = TimerRegistry::getInstance().getTimer( TimerRegistry::EVAL_PART );
     evalPartTimer.start();
-    // Note even when running with GCAM_PARALLEL_ENABLED we still run in serial
-    // mode for partial derivatives.  This is because the loop over each partial
-    // derivative to run is a parallel_for.
+    TraceScope evalScope( "solver", "partial evaluation" );
+#if GCAM_PARALLEL_ENABLED
+    if(mParallelPartial) {
+      // The Jacobian has too few columns to keep all of the threads busy
+      // so run the flow graph for each perturbed market as well.  Each
+      // graph only contains the activities which depend on that market.
+      for(size_t k=0; k<partjs.size(); ++k) {
+        const SolutionInfo &mkt = mkts[partjs[k]];
+        world->calc(period, mkt.acquireFlowGraph(), &mkt.getDependencies());
+        mkt.releaseFlowGraph();
+      }
+    }
+    else {
+      // Otherwise we still run in serial mode for partial derivatives.  This
+      // is because the loop over each partial derivative to run is a
+      // parallel_for.
+      world->calc(period, affectedNodes);
+    }
+#else
     world->calc(period, affectedNodes);
+#endif
     evalPartTimer.stop();
 
     if(mdiagnostic) {
       ILogger &solverlog = ILogger::getLogger("solver_log");
       solverlog.setLevel(ILogger::DEBUG);
       
-      solverlog << "new   \t" << mkts[partj].getPrice() << "\t" << mkts[partj].getSupply()
-                << "\t" << mkts[partj].getDemand()
-                << "\t" << mkts[partj].getName() << "\n";
+      for(size_t k=0; k<partjs.size(); ++k) {
+        const int partj = partjs[k];
+        solverlog << "new   \t" << mkts[partj].getPrice() << "\t" << mkts[partj].getSupply()
+                  << "\t" << mkts[partj].getDemand()
+                  << "\t" << mkts[partj].getName() << "\n";
+      }
     }
   }
 
@@ -303,7 +435,7 @@ void LogEDFun::operator()(const UBVECTOR<double> &ax, UBVECTOR<double> &fx, cons
       double p  = x[i]>=ARGMAX ? PMAX : exp(x[i]);
       double c  = std::max(0.0, p0-p);
       double fxi = log(d/s);
-      if(c>0.0) {
+      if(c>0.0 && ILogger::isLevelCompiled(ILogger::DEBUG)) {
         ILogger &solverlog = ILogger::getLogger("solver_log");
         solverlog.setLevel(ILogger::DEBUG);
         solverlog << "\t\tAdding supply correction: i= " << i << "  p= " << p
@@ -328,7 +460,7 @@ void LogEDFun::operator()(const UBVECTOR<double> &ax, UBVECTOR<double> &fx, cons
         double c = s == 0 ? std::max(0.0, (p0-x[i])/mfxscl[i]/mxscl[i]) : 0;
         // give difference as a fraction of demand
         fx[i] = d - s + c;          // == d-(s-c); i.e., the correction subtracts from supply
-        if(c>0.0) {
+        if(c>0.0 && ILogger::isLevelCompiled(ILogger::DEBUG)) {
           ILogger &solverlog = ILogger::getLogger("solver_log");
           solverlog.setLevel(ILogger::DEBUG);
           solverlog << "\t\tAdding supply correction: i= " << i << "  p= " << x[i]
@@ -353,7 +485,7 @@ void LogEDFun::operator()(const UBVECTOR<double> &ax, UBVECTOR<double> &fx, cons
         double c = std::max(0.0, (p0-x[i])/mfxscl[i]/mxscl[i]);
         // give difference as a fraction of demand
         fx[i] = d - s + c;          // == d-(s-c); i.e., the correction subtracts from supply
-        if(c>0.0) {
+        if(c>0.0 && ILogger::isLevelCompiled(ILogger::DEBUG)) {
           ILogger &solverlog = ILogger::getLogger("solver_log");
           solverlog.setLevel(ILogger::DEBUG);
           solverlog << "\t\tAdding supply correction: i= " << i << "  p= " << x[i]
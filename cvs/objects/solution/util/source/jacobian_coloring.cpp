@@ -0,0 +1,147 @@
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+/*!
+ * \file jacobian_coloring.cpp
+ * \ingroup Solution
+ * \brief JacobianColoring class source file
+ */
+
+#include <map>
+#include <algorithm>
+#include "solution/util/include/jacobian_coloring.hpp"
+#include "solution/util/include/solution_info.h"
+#include "parallel/include/bitvector.hpp"
+
+using namespace std;
+
+namespace {
+    //! Helper for sorting columns by decreasing number of nonzero rows
+    struct ColumnDegreeGreater {
+        const vector<vector<int> >& mColumnRows;
+        ColumnDegreeGreater( const vector<vector<int> >& aColumnRows ):mColumnRows( aColumnRows ) {}
+        bool operator()( const int aLHS, const int aRHS ) const {
+            return mColumnRows[aLHS].size() != mColumnRows[aRHS].size() ?
+                mColumnRows[aLHS].size() > mColumnRows[aRHS].size() : aLHS < aRHS;
+        }
+    };
+}
+
+/*!
+ * \brief Constructor which computes the sparsity pattern and coloring.
+ * \param aMarkets The solvable markets in the order in which they appear in
+ *                 the solver's x and F(x) vectors.
+ */
+JacobianColoring::JacobianColoring( const vector<SolutionInfo>& aMarkets ):
+mColumnRows( aMarkets.size() )
+{
+    const unsigned int nmkt = aMarkets.size();
+    if( nmkt == 0 ) {
+        return;
+    }
+
+    // Assign a sequential index to every activity that appears in any of the
+    // dependency lists so that we can represent the lists as bit vectors.
+    map<const IActivity*, unsigned int> activityIndex;
+    for( unsigned int i = 0; i < nmkt; ++i ) {
+        const vector<IActivity*>& deps = aMarkets[ i ].getDependencies();
+        for( vector<IActivity*>::const_iterator it = deps.begin(); it != deps.end(); ++it ) {
+            activityIndex.insert( make_pair( *it, static_cast<unsigned int>( activityIndex.size() ) ) );
+        }
+    }
+    vector<bitvector> activitySets( nmkt, bitvector( max( static_cast<unsigned int>( activityIndex.size() ), 1u ) ) );
+    for( unsigned int i = 0; i < nmkt; ++i ) {
+        const vector<IActivity*>& deps = aMarkets[ i ].getDependencies();
+        for( vector<IActivity*>::const_iterator it = deps.begin(); it != deps.end(); ++it ) {
+            activitySets[ i ].set( activityIndex[ *it ] );
+        }
+    }
+
+    // The structural pattern is symmetric: J(i,j) may be nonzero iff the
+    // dependency lists of i and j intersect.  The diagonal is always included
+    // even for a market with no dependencies so that we never silently drop
+    // a column.
+    vector<bitvector> rowSets( nmkt, bitvector( nmkt ) );
+    for( unsigned int j = 0; j < nmkt; ++j ) {
+        rowSets[ j ].set( j );
+        for( unsigned int i = 0; i < j; ++i ) {
+            if( activitySets[ i ].intersects( activitySets[ j ] ) ) {
+                rowSets[ j ].set( i );
+                rowSets[ i ].set( j );
+            }
+        }
+    }
+    for( unsigned int j = 0; j < nmkt; ++j ) {
+        for( unsigned int i = 0; i < nmkt; ++i ) {
+            if( rowSets[ j ].get( i ) ) {
+                mColumnRows[ j ].push_back( i );
+            }
+        }
+    }
+
+    // Greedy largest-first coloring.  A column may join a group only if none
+    // of its nonzero rows are already claimed by a column in that group.
+    vector<int> order( nmkt );
+    for( unsigned int j = 0; j < nmkt; ++j ) {
+        order[ j ] = j;
+    }
+    sort( order.begin(), order.end(), ColumnDegreeGreater( mColumnRows ) );
+    vector<bitvector> groupRows;
+    for( vector<int>::const_iterator it = order.begin(); it != order.end(); ++it ) {
+        size_t group = 0;
+        while( group < groupRows.size() && groupRows[ group ].intersects( rowSets[ *it ] ) ) {
+            ++group;
+        }
+        if( group == groupRows.size() ) {
+            groupRows.push_back( bitvector( nmkt ) );
+            mGroups.push_back( vector<int>() );
+        }
+        groupRows[ group ].setunion( rowSets[ *it ] );
+        mGroups[ group ].push_back( *it );
+    }
+    // Keep the columns within each group in their natural order.
+    for( vector<vector<int> >::iterator it = mGroups.begin(); it != mGroups.end(); ++it ) {
+        sort( it->begin(), it->end() );
+    }
+}
+
+double JacobianColoring::getDensity() const {
+    if( mColumnRows.empty() ) {
+        return 0.0;
+    }
+    double nnz = 0.0;
+    for( vector<vector<int> >::const_iterator it = mColumnRows.begin(); it != mColumnRows.end(); ++it ) {
+        nnz += it->size();
+    }
+    return nnz / ( static_cast<double>( mColumnRows.size() ) * static_cast<double>( mColumnRows.size() ) );
+}
@@ -48,12 +48,19 @@
 #include "marketplace/include/market.h"
 #include "util/logger/include/ilogger.h"
 #include "containers/include/info.h"
+#if GCAM_PARALLEL_ENABLED
+#include "containers/include/scenario.h"
+#include "marketplace/include/marketplace.h"
+#include "containers/include/market_dependency_finder.h"
+
+extern Scenario* scenario;
+#endif
 
 using namespace std;
 
 //! Constructor
 #if GCAM_PARALLEL_ENABLED
-SolutionInfo::SolutionInfo( Market* aLinkedMarket, const vector<IActivity*>& aDependencies, GcamFlowGraph* aFlowGraph )
+SolutionInfo::SolutionInfo( Market* aLinkedMarket, const vector<IActivity*>& aDependencies, const int aMarketNumber )
 #else
 SolutionInfo::SolutionInfo( Market* aLinkedMarket, const vector<IActivity*>& aDependencies )
 #endif
@@ -67,7 +74,7 @@ EDL( 0 ),
 EDR( 0 ),
 mDependencies( const_cast<vector<IActivity*>&>( aDependencies ) ),
 #if GCAM_PARALLEL_ENABLED
-mFlowGraph( aFlowGraph ),
+mMarketNumber( aMarketNumber ),
 #endif
 mSolutionTolerance( 0 ),
 mSolutionFloor( 0 ),
@@ -580,10 +587,21 @@ const IInfo* SolutionInfo::getMarketInfo() const {
 /*
  * \brief Get a flow graph with the items which are affected by changing the price
  *        of this solution info.
+ * \details The graph is generated by the MarketDependencyFinder the first time it
+ *          is requested and cached from then on.  The caller must call
+ *          releaseFlowGraph when done with it so the cache may reclaim it.
  * \return A flow graph to recalculate when this solution info's price changes.
+ * \sa MarketDependencyFinder::acquireFlowGraph
+ */
+GcamFlowGraph* SolutionInfo::acquireFlowGraph() const {
+    return scenario->getMarketplace()->getDependencyFinder()->acquireFlowGraph( mMarketNumber );
+}
+
+/*
+ * \brief Indicate the flow graph from acquireFlowGraph is no longer in use.
  */
-GcamFlowGraph* SolutionInfo::getFlowGraph() const {
-    return mFlowGraph;
+void SolutionInfo::releaseFlowGraph() const {
+    scenario->getMarketplace()->getDependencyFinder()->releaseFlowGraph( mMarketNumber );
 }
 #endif
 
@@ -58,6 +58,7 @@
 #include "util/base/include/util.h"
 #include "solution/util/include/solution_info.h"
 #include "solution/util/include/solution_info_set.h"
+#include "solution/util/include/sparse_linear_solver.hpp"
 #include "solution/util/include/calc_counter.h"
 #include "util/logger/include/ilogger.h"
 #include "solution/util/include/ublas-helpers.hpp"
@@ -201,10 +202,13 @@ void SolverLibrary::updateMatrices( SolutionInfoSet& aSolutionSet, Matrix& JFSM,
  * \param JFLUFactorized LU factored JF matrix
  * \param aPermMatrix Permutation matrix used to factorize JF
  * \param aDefaultMaxPriceJump The default factor used to limit the price changes from this algorithm.
+ * \param aSparseSolver If not null, a sparse factorization of JF to use in place of
+ *                      JFLUFactorized and aPermMatrix.
  * \return Whether prices were set successfully.
  */
 bool SolverLibrary::calculateNewPricesLogNR( SolutionInfoSet& aSolutionSet, Matrix& JFLUFactorized,
-                                             PermutationMatrix& aPermMatrix, const double aDefaultMaxPriceJump )
+                                             PermutationMatrix& aPermMatrix, const double aDefaultMaxPriceJump,
+                                             const SparseLinearSolver* aSparseSolver )
 {
     using namespace boost::numeric::ublas;
     boost::numeric::ublas::vector<double> KDS( aSolutionSet.getNumSolvable() ); // k values demand - supply
@@ -229,7 +233,14 @@ bool SolverLibrary::calculateNewPricesLogNR( SolutionInfoSet& aSolutionSet, Matr
     // to solve JF(Xn) * ( Xn+1 - Xn ) = -F(Xn) we use lu substitution which
     // is favorable to calculating the inverse of JF.  lu_substitue will leave
     // us with ( Xn+1 - Xn ) stored in KDS
-    lu_substitute( JFLUFactorized, aPermMatrix, KDS );
+    if( aSparseSolver ) {
+        if( aSparseSolver->solve( KDS ) != 0 ) {
+            solverLog << "GMRES did not converge in " << aSparseSolver->getLastIterations() << " iterations.\n";
+        }
+    }
+    else {
+        lu_substitute( JFLUFactorized, aPermMatrix, KDS );
+    }
     solverLog << "dx: " << KDS << "\n";
     
     // To calculate the new price Xn+1 we do Xn+1 = Xn + KDS
@@ -0,0 +1,462 @@
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file sparse_linear_solver.cpp
+ * \ingroup Solution
+ * \brief SparseLinearSolver class source file
+ */
+
+#include <map>
+#include <set>
+#include <limits>
+#include <algorithm>
+#include "solution/util/include/sparse_linear_solver.hpp"
+#include "util/logger/include/ilogger.h"
+
+using namespace std;
+
+namespace {
+    double dot( const vector<double>& aX, const vector<double>& aY ) {
+        double sum = 0.0;
+        for( size_t i = 0; i < aX.size(); ++i ) {
+            sum += aX[ i ] * aY[ i ];
+        }
+        return sum;
+    }
+}
+
+SparseLinearSolver::SparseLinearSolver():
+mMethod( SPARSE_LU ),
+mRowStart( 1, 0 ),
+mPivotThreshold( 0.1 ),
+mTol( 1.0e-10 ),
+mRestart( 50 ),
+mMaxIter( 500 ),
+mLastIter( 0 )
+{
+}
+
+/*!
+ * \brief Convert the XML name of a linear solver to the enum.
+ * \details Unknown names produce a warning and select the dense solver.
+ * \param aName One of "dense", "sparse-lu", or "gmres".
+ * \return The corresponding Method.
+ */
+SparseLinearSolver::Method SparseLinearSolver::parseMethod( const string& aName ) {
+    if( aName == getMethodName( SPARSE_LU ) ) {
+        return SPARSE_LU;
+    }
+    else if( aName == getMethodName( GMRES ) ) {
+        return GMRES;
+    }
+    else if( aName != getMethodName( DENSE ) ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "Unrecognized linear solver: " << aName << ", using "
+                << getMethodName( DENSE ) << "." << endl;
+    }
+    return DENSE;
+}
+
+//! Get the XML name of a linear solver.
+const string& SparseLinearSolver::getMethodName( const Method aMethod ) {
+    static const string NAMES[] = { "dense", "sparse-lu", "gmres" };
+    return NAMES[ aMethod ];
+}
+
+size_t SparseLinearSolver::getFactorSize() const {
+    if( mMethod == GMRES ) {
+        return mILU.size();
+    }
+    size_t nnz = 0;
+    for( size_t k = 0; k < mURows.size(); ++k ) {
+        nnz += mLCols[ k ].size() + mURows[ k ].size();
+    }
+    return nnz;
+}
+
+/*!
+ * \brief Solve A*x = b using the current factorization.
+ * \param aB On input the right hand side b, on output the solution x.
+ * \return 0 on success.  For GMRES a nonzero value indicates that the
+ *         iteration did not reach its tolerance; aB then holds the best
+ *         approximation found, which is usually still a usable step.
+ */
+int SparseLinearSolver::solve( boost::numeric::ublas::vector<double>& aB ) const {
+    const int n = mRowStart.size() - 1;
+    vector<double> b( aB.begin(), aB.end() );
+    int status = 0;
+    if( mMethod == GMRES ) {
+        status = gmres( b );
+    }
+    else {
+        // permute the right hand side into the order used for the factorization
+        vector<double> c( n );
+        for( int i = 0; i < n; ++i ) {
+            c[ i ] = b[ mPerm[ i ] ];
+        }
+        // forward substitution, applying the row operations in the order
+        // they were performed during elimination
+        vector<double> z( n );
+        for( int k = 0; k < n; ++k ) {
+            double val = c[ mPivotRow[ k ] ];
+            const vector<pair<int, double> >& lcol = mLCols[ k ];
+            for( size_t p = 0; p < lcol.size(); ++p ) {
+                c[ lcol[ p ].first ] -= lcol[ p ].second * val;
+            }
+            z[ k ] = val;
+        }
+        // back substitution
+        for( int k = n - 1; k >= 0; --k ) {
+            const vector<pair<int, double> >& urow = mURows[ k ];
+            double val = z[ k ];
+            for( size_t p = 1; p < urow.size(); ++p ) {
+                val -= urow[ p ].second * z[ urow[ p ].first ];
+            }
+            z[ k ] = val / urow[ 0 ].second;
+        }
+        for( int k = 0; k < n; ++k ) {
+            b[ mPerm[ k ] ] = z[ k ];
+        }
+    }
+    copy( b.begin(), b.end(), aB.begin() );
+    return status;
+}
+
+/*!
+ * \brief Compute a minimum degree ordering of the pattern of A+A^T.
+ * \details This is the plain (non-approximate) algorithm working on the
+ *          explicit elimination graph.  It is quadratic in the number of
+ *          markets in the worst case, which is still negligible next to the
+ *          cost of a single model evaluation.
+ */
+void SparseLinearSolver::minimumDegreeOrder() {
+    const int n = mRowStart.size() - 1;
+    vector<set<int> > adj( n );
+    for( int i = 0; i < n; ++i ) {
+        for( size_t p = mRowStart[ i ]; p < mRowStart[ i + 1 ]; ++p ) {
+            int j = mColIndex[ p ];
+            if( j != i ) {
+                adj[ i ].insert( j );
+                adj[ j ].insert( i );
+            }
+        }
+    }
+
+    mPerm.clear();
+    vector<bool> eliminated( n, false );
+    for( int k = 0; k < n; ++k ) {
+        int v = -1;
+        for( int i = 0; i < n; ++i ) {
+            if( !eliminated[ i ] && ( v < 0 || adj[ i ].size() < adj[ v ].size() ) ) {
+                v = i;
+            }
+        }
+        // eliminating v makes its neighbors a clique
+        for( set<int>::const_iterator it = adj[ v ].begin(); it != adj[ v ].end(); ++it ) {
+            adj[ *it ].erase( v );
+            for( set<int>::const_iterator it2 = adj[ v ].begin(); it2 != adj[ v ].end(); ++it2 ) {
+                if( *it2 != *it ) {
+                    adj[ *it ].insert( *it2 );
+                }
+            }
+        }
+        adj[ v ].clear();
+        eliminated[ v ] = true;
+        mPerm.push_back( v );
+    }
+}
+
+/*!
+ * \brief Sparse LU factorization with threshold partial pivoting.
+ * \details Right-looking elimination on the symmetrically permuted matrix.
+ *          Rows are held in ordered maps, which is not the fastest possible
+ *          data structure but keeps the fill-in bookkeeping simple.
+ * \return 0 on success, k+1 if column k had no nonzero pivot candidate.
+ */
+int SparseLinearSolver::factorizeLU() {
+    const int n = mRowStart.size() - 1;
+    minimumDegreeOrder();
+    vector<int> iperm( n );
+    for( int k = 0; k < n; ++k ) {
+        iperm[ mPerm[ k ] ] = k;
+    }
+
+    vector<map<int, double> > rows( n );
+    vector<vector<int> > colRows( n );
+    for( int i = 0; i < n; ++i ) {
+        for( size_t p = mRowStart[ i ]; p < mRowStart[ i + 1 ]; ++p ) {
+            int pi = iperm[ i ], pj = iperm[ mColIndex[ p ] ];
+            rows[ pi ][ pj ] = mValue[ p ];
+            colRows[ pj ].push_back( pi );
+        }
+    }
+
+    mPivotRow.assign( n, -1 );
+    mLCols.assign( n, vector<pair<int, double> >() );
+    mURows.assign( n, vector<pair<int, double> >() );
+    vector<bool> done( n, false );
+    for( int k = 0; k < n; ++k ) {
+        // find the largest candidate pivot in column k
+        int maxRow = -1;
+        double maxAbs = 0.0;
+        const vector<int>& candidates = colRows[ k ];
+        for( size_t c = 0; c < candidates.size(); ++c ) {
+            int r = candidates[ c ];
+            double a = done[ r ] ? 0.0 : fabs( rows[ r ][ k ] );
+            if( a > maxAbs ) {
+                maxAbs = a;
+                maxRow = r;
+            }
+        }
+        if( maxRow < 0 ) {
+            return k + 1;
+        }
+        // keep the diagonal if it is good enough, to preserve the ordering
+        int pivRow = maxRow;
+        if( !done[ k ] ) {
+            map<int, double>::const_iterator diag = rows[ k ].find( k );
+            if( diag != rows[ k ].end() && fabs( diag->second ) >= mPivotThreshold * maxAbs ) {
+                pivRow = k;
+            }
+        }
+        done[ pivRow ] = true;
+        mPivotRow[ k ] = pivRow;
+
+        // all earlier columns have been eliminated from the pivot row, so
+        // its entries are exactly row k of U with the diagonal first.
+        const map<int, double>& prow = rows[ pivRow ];
+        mURows[ k ].assign( prow.begin(), prow.end() );
+        const double piv = mURows[ k ][ 0 ].second;
+
+        for( size_t c = 0; c < candidates.size(); ++c ) {
+            int r = candidates[ c ];
+            if( done[ r ] ) {
+                continue;
+            }
+            map<int, double>::iterator rk = rows[ r ].find( k );
+            double l = rk->second / piv;
+            rows[ r ].erase( rk );
+            if( l == 0.0 ) {
+                continue;
+            }
+            mLCols[ k ].push_back( make_pair( r, l ) );
+            for( size_t p = 1; p < mURows[ k ].size(); ++p ) {
+                pair<map<int, double>::iterator, bool> ins =
+                    rows[ r ].insert( make_pair( mURows[ k ][ p ].first, 0.0 ) );
+                if( ins.second ) {
+                    // fill-in
+                    colRows[ mURows[ k ][ p ].first ].push_back( r );
+                }
+                ins.first->second -= l * mURows[ k ][ p ].second;
+            }
+        }
+        rows[ pivRow ].clear();
+        vector<int>().swap( colRows[ k ] );
+    }
+    return 0;
+}
+
+/*!
+ * \brief Incomplete LU factorization on the sparsity pattern of A.
+ * \return 0 on success, i+1 if row i had a zero (or missing) diagonal.
+ */
+int SparseLinearSolver::factorizeILU() {
+    const int n = mRowStart.size() - 1;
+    mILU = mValue;
+    mDiag.assign( n, numeric_limits<size_t>::max() );
+    vector<size_t> iw( n, numeric_limits<size_t>::max() );
+    for( int i = 0; i < n; ++i ) {
+        for( size_t p = mRowStart[ i ]; p < mRowStart[ i + 1 ]; ++p ) {
+            iw[ mColIndex[ p ] ] = p;
+        }
+        // column indices within a row are sorted, so the lower triangle
+        // comes first and is processed in order
+        for( size_t p = mRowStart[ i ]; p < mRowStart[ i + 1 ] && mColIndex[ p ] < i; ++p ) {
+            int k = mColIndex[ p ];
+            mILU[ p ] /= mILU[ mDiag[ k ] ];
+            for( size_t q = mDiag[ k ] + 1; q < mRowStart[ k + 1 ]; ++q ) {
+                size_t pos = iw[ mColIndex[ q ] ];
+                if( pos != numeric_limits<size_t>::max() ) {
+                    mILU[ pos ] -= mILU[ p ] * mILU[ q ];
+                }
+            }
+        }
+        mDiag[ i ] = iw[ i ];
+        for( size_t p = mRowStart[ i ]; p < mRowStart[ i + 1 ]; ++p ) {
+            iw[ mColIndex[ p ] ] = numeric_limits<size_t>::max();
+        }
+        if( mDiag[ i ] == numeric_limits<size_t>::max() || mILU[ mDiag[ i ] ] == 0.0 ) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+//! Compute y = A*x using the stored matrix.
+void SparseLinearSolver::multiply( const vector<double>& aX, vector<double>& aY ) const {
+    const int n = mRowStart.size() - 1;
+    for( int i = 0; i < n; ++i ) {
+        double sum = 0.0;
+        for( size_t p = mRowStart[ i ]; p < mRowStart[ i + 1 ]; ++p ) {
+            sum += mValue[ p ] * aX[ mColIndex[ p ] ];
+        }
+        aY[ i ] = sum;
+    }
+}
+
+//! Apply the ILU(0) preconditioner in place: x <- (LU)^-1 x
+void SparseLinearSolver::applyILU( vector<double>& aX ) const {
+    const int n = mRowStart.size() - 1;
+    for( int i = 0; i < n; ++i ) {
+        for( size_t p = mRowStart[ i ]; p < mDiag[ i ]; ++p ) {
+            aX[ i ] -= mILU[ p ] * aX[ mColIndex[ p ] ];
+        }
+    }
+    for( int i = n - 1; i >= 0; --i ) {
+        for( size_t p = mDiag[ i ] + 1; p < mRowStart[ i + 1 ]; ++p ) {
+            aX[ i ] -= mILU[ p ] * aX[ mColIndex[ p ] ];
+        }
+        aX[ i ] /= mILU[ mDiag[ i ] ];
+    }
+}
+
+/*!
+ * \brief Restarted, right-preconditioned GMRES.
+ * \param aB On input the right hand side, on output the approximate solution.
+ * \return 0 if the relative residual tolerance was met, 1 otherwise.
+ */
+int SparseLinearSolver::gmres( vector<double>& aB ) const {
+    const int n = aB.size();
+    const double bnorm = sqrt( dot( aB, aB ) );
+    mLastIter = 0;
+    vector<double> x( n, 0.0 );
+    if( bnorm == 0.0 ) {
+        aB = x;
+        return 0;
+    }
+    const int m = min( mRestart, n );
+    vector<vector<double> > V( m + 1, vector<double>( n ) );
+    vector<vector<double> > H( m + 1, vector<double>( m, 0.0 ) );
+    vector<double> cs( m ), sn( m ), g( m + 1 ), w( n ), z( n );
+    bool converged = false;
+    while( !converged && mLastIter < mMaxIter ) {
+        // r = b - A*x
+        multiply( x, w );
+        for( int i = 0; i < n; ++i ) {
+            V[ 0 ][ i ] = aB[ i ] - w[ i ];
+        }
+        double beta = sqrt( dot( V[ 0 ], V[ 0 ] ) );
+        if( beta <= mTol * bnorm ) {
+            converged = true;
+            break;
+        }
+        for( int i = 0; i < n; ++i ) {
+            V[ 0 ][ i ] /= beta;
+        }
+        fill( g.begin(), g.end(), 0.0 );
+        g[ 0 ] = beta;
+
+        int jused = 0;
+        for( int j = 0; j < m && mLastIter < mMaxIter; ++j ) {
+            ++mLastIter;
+            jused = j + 1;
+            z = V[ j ];
+            applyILU( z );
+            multiply( z, w );
+            // modified Gram-Schmidt
+            for( int i = 0; i <= j; ++i ) {
+                H[ i ][ j ] = dot( w, V[ i ] );
+                for( int l = 0; l < n; ++l ) {
+                    w[ l ] -= H[ i ][ j ] * V[ i ][ l ];
+                }
+            }
+            H[ j + 1 ][ j ] = sqrt( dot( w, w ) );
+            if( H[ j + 1 ][ j ] != 0.0 ) {
+                for( int l = 0; l < n; ++l ) {
+                    V[ j + 1 ][ l ] = w[ l ] / H[ j + 1 ][ j ];
+                }
+            }
+            // apply the previous Givens rotations to the new column, then
+            // compute the rotation that eliminates H(j+1,j)
+            for( int i = 0; i < j; ++i ) {
+                double tmp = cs[ i ] * H[ i ][ j ] + sn[ i ] * H[ i + 1 ][ j ];
+                H[ i + 1 ][ j ] = -sn[ i ] * H[ i ][ j ] + cs[ i ] * H[ i + 1 ][ j ];
+                H[ i ][ j ] = tmp;
+            }
+            double r = sqrt( H[ j ][ j ] * H[ j ][ j ] + H[ j + 1 ][ j ] * H[ j + 1 ][ j ] );
+            if( r == 0.0 ) {
+                // breakdown; nothing more can be gained from this cycle
+                jused = j;
+                break;
+            }
+            cs[ j ] = H[ j ][ j ] / r;
+            sn[ j ] = H[ j + 1 ][ j ] / r;
+            H[ j ][ j ] = r;
+            H[ j + 1 ][ j ] = 0.0;
+            g[ j + 1 ] = -sn[ j ] * g[ j ];
+            g[ j ] *= cs[ j ];
+            if( fabs( g[ j + 1 ] ) <= mTol * bnorm ) {
+                converged = true;
+                break;
+            }
+        }
+        if( jused == 0 ) {
+            break;
+        }
+
+        // solve the upper triangular system H*y = g and update x += M^-1 * V*y
+        vector<double> y( jused );
+        for( int i = jused - 1; i >= 0; --i ) {
+            double val = g[ i ];
+            for( int l = i + 1; l < jused; ++l ) {
+                val -= H[ i ][ l ] * y[ l ];
+            }
+            y[ i ] = val / H[ i ][ i ];
+        }
+        fill( z.begin(), z.end(), 0.0 );
+        for( int i = 0; i < jused; ++i ) {
+            for( int l = 0; l < n; ++l ) {
+                z[ l ] += y[ i ] * V[ i ][ l ];
+            }
+        }
+        applyILU( z );
+        for( int l = 0; l < n; ++l ) {
+            x[ l ] += z[ l ];
+        }
+    }
+    aB = x;
+    return converged ? 0 : 1;
+}
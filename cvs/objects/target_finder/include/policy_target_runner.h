@@ -202,6 +202,10 @@ private:
     //! solve.
     double mMaxTax;
 
+    //! The taxes used by the last trial run, or empty if the periods in the
+    //! model were not calculated with known taxes.
+    std::vector<double> mLastTrialTaxes;
+
     void
         calculateHotellingPath( const double aIntialTax,
                                 const double aHotellingRate,
@@ -211,6 +215,10 @@ private:
                                 std::vector<double>& aTaxes );
 
     void setTrialTaxes( const std::vector<double> aTaxes );
+
+    bool runTrial( const std::vector<double>& aTaxes,
+                   const int aLastPeriod,
+                   Timer& aTimer );
     
     bool solveInitialTarget( std::vector<double>& aTaxes,
                              const ITarget* aPolicyTarget,
@@ -264,6 +264,9 @@ bool PolicyTargetRunner::runScenarios( const int aSinglePeriod,
     logRunID();
     bool success = mSingleScenario->runScenarios( Scenario::RUN_ALL_PERIODS,
                                                   true, aTimer );
+    // The taxes which will be set below may differ from those used in the
+    // baseline so the first trial must calculate every period.
+    mLastTrialTaxes.clear();
     
     // Allow the use of an existing tax, note that taxes after mFirstTaxYear will
     // be overridden.
@@ -404,12 +407,11 @@ bool PolicyTargetRunner::solveInitialTarget( vector<double>& aTaxes,
     const double initialTax = aTaxes[ firstTaxPeriod ];
     
     const int finalModelYear = getInternalScenario()->getModeltime()->getEndYear();
+    const int finalPeriod = getInternalScenario()->getModeltime()->getmaxper() - 1;
 
     // Run the model without a tax target once to get a baseline for the
     // solver and to calculate the initial non-tax periods.
-    logRunID();
-    bool success = mSingleScenario->runScenarios( Scenario::RUN_ALL_PERIODS,
-                                                  false, aTimer );
+    bool success = runTrial( aTaxes, finalPeriod, aTimer );
     
     // If we are already below the target at a zero tax then we won't be able to
     // get to the target.
@@ -462,12 +464,10 @@ bool PolicyTargetRunner::solveInitialTarget( vector<double>& aTaxes,
                                          finalModelYear,
                                          aTaxes );
 
-        setTrialTaxes( aTaxes );
-
-        // Run the scenario at the trial tax.
+        // Run the scenario at the trial tax.  Periods before the first tax
+        // period are unchanged and will not be solved again.
         // TODO: If the run failed to solve then the target status may be unreliable.
-        logRunID();
-        success = mSingleScenario->runScenarios( Scenario::RUN_ALL_PERIODS, false, aTimer );
+        success = runTrial( aTaxes, finalPeriod, aTimer );
 
         targetLog << "Scenario run complete.  Return status = " << success << endl;
     }
@@ -536,9 +536,7 @@ bool PolicyTargetRunner::solveFutureTarget( vector<double>& aTaxes,
     // period which is likely closer to than that which was rising on the hotelling
     // path.
     aTaxes[ aPeriod ] = aTaxes[ aPeriod - 1 ];
-    setTrialTaxes( aTaxes );
-    logRunID();
-    bool success = mSingleScenario->runScenarios( aPeriod, false, aTimer );
+    bool success = runTrial( aTaxes, aPeriod, aTimer );
 
     // Construct a solver which has an initial trial equal to the current tax.
     const Modeltime* modeltime = getInternalScenario()->getModeltime();
@@ -573,13 +571,9 @@ bool PolicyTargetRunner::solveFutureTarget( vector<double>& aTaxes,
         assert( static_cast<unsigned int>( aPeriod ) < aTaxes.size() );
         aTaxes[ aPeriod ] = trial.first;
 
-        // Set the trial taxes.
-        setTrialTaxes( aTaxes );
-
-        // Run the base scenario.
+        // Run the base scenario at the trial taxes.
         // TODO: If the run failed to solve then the target status may be unreliable.
-        logRunID();
-        success = mSingleScenario->runScenarios( aPeriod, false, aTimer );
+        success = runTrial( aTaxes, aPeriod, aTimer );
     }
 
     if( solver->getIterations() >= aLimitIterations ){
@@ -652,11 +646,8 @@ bool PolicyTargetRunner::skipFuturePeriod( vector<double>& aTaxes,
         aTaxes[ period ] = util::linearInterpolateY( year, lastTaxYear, currYear,
                                                      aTaxes[ aFirstSkippedPeriod - 1 ],
                                                      aTaxes[ aPeriod ] );
-        getInternalScenario()->invalidatePeriod( period );
     }
-    setTrialTaxes( aTaxes );
-    logRunID();
-    bool success = mSingleScenario->runScenarios( lastPeriodToCalc, false, aTimer );
+    bool success = runTrial( aTaxes, lastPeriodToCalc, aTimer );
     
     // Construct a solver which has an initial trial equal to the current tax.
     auto_ptr<ITargetSolver> solver;
@@ -699,16 +690,11 @@ bool PolicyTargetRunner::skipFuturePeriod( vector<double>& aTaxes,
             aTaxes[ period ] = util::linearInterpolateY( year, lastTaxYear, currYear,
                                                          aTaxes[ aFirstSkippedPeriod - 1 ],
                                                          aTaxes[ aPeriod ] );
-            getInternalScenario()->invalidatePeriod( period );
         }
         
-        // Set the trial taxes.
-        setTrialTaxes( aTaxes );
-        
-        // Run the base scenario.
+        // Run the base scenario at the trial taxes.
         // TODO: If the run failed to solve then the target status may be unreliable.
-        logRunID();
-        success = mSingleScenario->runScenarios( lastPeriodToCalc, false, aTimer );
+        success = runTrial( aTaxes, lastPeriodToCalc, aTimer );
     }
     
     if( solver->getIterations() >= aLimitIterations ){
@@ -819,6 +805,51 @@ void PolicyTargetRunner::setTrialTaxes( const vector<double> aTaxes ) {
     mSingleScenario->getInternalScenario()->setTax( &tax );
 }
 
+/*!
+ * \brief Run the scenario at a trial tax path resuming from the first period
+ *        whose tax changed since the last trial.
+ * \details The model objects keep the results of every period they have
+ *          calculated, so periods before the first changed tax were already
+ *          calculated by the previous trial with the same inputs and remain
+ *          valid.  Those periods are not solved again, the remaining periods
+ *          are invalidated and recalculated up to aLastPeriod.
+ * \param aTaxes Vector of trial taxes, one value for each model period.
+ * \param aLastPeriod The last period to calculate.
+ * \param aTimer The timer used to print out the amount of time spent performing
+ *        operations.
+ * \return Whether all the periods calculated solved successfully.
+ */
+bool PolicyTargetRunner::runTrial( const vector<double>& aTaxes,
+                                   const int aLastPeriod,
+                                   Timer& aTimer )
+{
+    Scenario* internalScenario = getInternalScenario();
+    const int maxPeriod = internalScenario->getModeltime()->getmaxper();
+
+    // Find the first period which was not calculated with the same tax.
+    int firstChangedPeriod = 0;
+    if( mLastTrialTaxes.size() == aTaxes.size() ) {
+        while( firstChangedPeriod < maxPeriod &&
+               mLastTrialTaxes[ firstChangedPeriod ] == aTaxes[ firstChangedPeriod ] )
+        {
+            ++firstChangedPeriod;
+        }
+    }
+    for( int period = firstChangedPeriod; period < maxPeriod; ++period ) {
+        internalScenario->invalidatePeriod( period );
+    }
+
+    ILogger& targetLog = ILogger::getLogger( "target_finder_log" );
+    targetLog.setLevel( ILogger::DEBUG );
+    targetLog << "Resuming trial from period " << firstChangedPeriod
+              << " through period " << aLastPeriod << "." << endl;
+
+    setTrialTaxes( aTaxes );
+    mLastTrialTaxes = aTaxes;
+    logRunID();
+    return mSingleScenario->runScenarios( aLastPeriod, false, aTimer );
+}
+
 /*!
  * \brief Write a unique identifier into each of several log files
  */
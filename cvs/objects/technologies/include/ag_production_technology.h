@@ -52,6 +52,7 @@
 
 #include <xercesc/dom/DOMNode.hpp>
 #include "technologies/include/technology.h"
+#include "marketplace/include/cached_market.h"
 
 // Forward declaration
 class Tabs;
@@ -137,6 +138,16 @@ protected:
     //! Weak pointer to the land leaf which corresponds to this technology
     //! used to save time finding it over and over
     ALandAllocatorItem* mProductLeaf;
+
+    //! A pre-located market which has been cached from the marketplace for the
+    //! product.
+    CachedMarket mCachedMarket;
+
+    //! The regional subsidy for the product in the period it was cached for.
+    double mCachedSubsidy;
+
+    //! The period mCachedSubsidy was read for or -1 if it has not been.
+    int mCachedSubsidyPeriod;
     
     void copy( const AgProductionTechnology& aOther );
 
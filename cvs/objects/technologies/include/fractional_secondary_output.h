@@ -52,7 +52,9 @@ class Tabs;
 #include "technologies/include/ioutput.h"
 #include "util/base/include/value.h"
 #include "util/base/include/time_vector.h"
+#include "marketplace/include/cached_market.h"
 #include "util/curves/include/cost_curve.h"
+#include "util/curves/include/piecewise_linear_table.h"
 
 /*! 
  * \ingroup Objects
@@ -203,6 +205,13 @@ protected:
         //! the current region is assumed.
         DEFINE_VARIABLE( SIMPLE, "market-name", mMarketName, std::string )
     )
+    
+    //! A pre-located market which has been cached from the marketplace for the
+    //! secondary good.
+    CachedMarket mCachedMarket;
+    
+    //! A copy of mCostCurve which is quick to evaluate during calc, set in completeInit.
+    PiecewiseLinearTable mCostTable;
 };
 
 #endif // _FRACTIONAL_SECONDARY_OUTPUT_H_
@@ -48,6 +48,7 @@
 #include <string>
 #include "technologies/include/technology.h"
 #include "util/base/include/value.h"
+#include "marketplace/include/cached_market.h"
 #include "sectors/include/ibackup_calculator.h"
 
 class IInfo;
@@ -178,6 +179,10 @@ protected:
     //! Info object used to pass parameter information into backup calculators.
     std::auto_ptr<IInfo> mIntermittTechInfo;
     
+    //! A pre-located market which has been cached from the marketplace for the
+    //! electricity sector this technology is a part of.
+    CachedMarket mCachedElectricSectorMarket;
+    
     void copy( const IntermittentTechnology& aOther );
 
     void setCoefficients( const std::string& aRegionName,
@@ -47,6 +47,7 @@
 
 #include <xercesc/dom/DOMNode.hpp>
 #include "technologies/include/technology.h"
+#include "marketplace/include/cached_market.h"
 
 class GDP;
 
@@ -150,6 +151,14 @@ protected:
         //! State value for blanket fuel market necessary to use Marketplace::addToDemand
         DEFINE_VARIABLE( SIMPLE | STATE, "blanket-fuel-state", mLastBlanketValue, Value )
     )
+
+    //! A pre-located market which has been cached from the marketplace for the
+    //! fertile fuel.
+    CachedMarket mCachedFertileMarket;
+
+    //! A pre-located market which has been cached from the marketplace for the
+    //! blanket fuel.
+    CachedMarket mCachedBlanketMarket;
     
     void copy( const NukeFuelTechnology& aOther );
 
@@ -49,6 +49,7 @@
 #include <xercesc/dom/DOMNode.hpp>
 #include "technologies/include/icapture_component.h"
 #include "util/base/include/value.h"
+#include "marketplace/include/cached_market.h"
 #include "util/base/include/time_vector.h"
 
 /*! 
@@ -189,6 +190,14 @@ protected:
         //! Non-energy cost penalty.
         DEFINE_VARIABLE( SIMPLE, "non-energy-penalty", mNonEnergyCostPenalty, double )
     )
+    
+    //! A pre-located market which has been cached from the marketplace for the
+    //! carbon storage.
+    CachedMarket mCachedStorageMarket;
+    
+    //! A pre-located market which has been cached from the marketplace for the
+    //! price of the target gas.
+    CachedMarket mCachedTargetGasMarket;
 };
 
 #endif // _POWER_PLANT_CAPTURE_COMPONENT_H_
@@ -48,10 +48,10 @@
 #include <xercesc/dom/DOMNode.hpp>
 
 class Tabs;
-class CachedMarket;
 
 #include "technologies/include/ioutput.h"
 #include "util/base/include/value.h"
+#include "marketplace/include/cached_market.h"
 #include "util/base/include/time_vector.h"
 
 /*! 
@@ -171,7 +171,7 @@ protected:
     )
     
     //! A pre-located market which has been cached from the marketplace to add supply to.
-    std::auto_ptr<CachedMarket> mCachedMarket;
+    CachedMarket mCachedMarket;
     
     void copy( const PrimaryOutput& aOther );
 };
@@ -37,7 +37,9 @@
 #include "technologies/include/ioutput.h"
 #include "util/base/include/value.h"
 #include "util/curves/include/cost_curve.h"
+#include "util/curves/include/piecewise_linear_table.h"
 #include "util/base/include/time_vector.h"
+#include "marketplace/include/cached_market.h"
 
 class Curve;
 class ALandAllocatorItem;
@@ -192,6 +194,13 @@ protected :
     //! used to save time finding it over and over
     ALandAllocatorItem* mProductLeaf;
     
+    //! A pre-located market which has been cached from the marketplace for the
+    //! residue.
+    CachedMarket mCachedMarket;
+    
+    //! A copy of mCostCurve which is quick to evaluate during calc, set in completeInit.
+    PiecewiseLinearTable mCostTable;
+    
     void copy( const ResidueBiomassOutput& aOther );
 };
 
@@ -52,6 +52,7 @@ class Tabs;
 #include "technologies/include/ioutput.h"
 #include "util/base/include/value.h"
 #include "util/base/include/time_vector.h"
+#include "marketplace/include/cached_market.h"
 
 /*! 
  * \ingroup Objects
@@ -200,6 +201,10 @@ protected:
         DEFINE_VARIABLE( SIMPLE, "market-name", mMarketName, std::string )
     )
     
+    //! A pre-located market which has been cached from the marketplace for the
+    //! secondary good.
+    CachedMarket mCachedMarket;
+    
     void copy( const SecondaryOutput& aOther );
 };
 
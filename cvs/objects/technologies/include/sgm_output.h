@@ -49,10 +49,10 @@
 #include <xercesc/dom/DOMNode.hpp>
 
 class Tabs;
-class CachedMarket;
 
 #include "technologies/include/ioutput.h"
 #include "util/base/include/value.h"
+#include "marketplace/include/cached_market.h"
 
 /*! 
  * \ingroup Objects
@@ -175,7 +175,7 @@ protected:
     std::string mRegionName;
 
     //! A pre-located market which has been cached from the marketplace to add supply to.
-    std::auto_ptr<CachedMarket> mCachedMarket;
+    CachedMarket mCachedMarket;
 };
 
 #endif // _SGM_OUTPUT_H_
@@ -50,6 +50,7 @@
 #include "technologies/include/icapture_component.h"
 #include "util/base/include/time_vector.h"
 #include "util/base/include/value.h"
+#include "marketplace/include/cached_market.h"
 
 /*! 
  * \ingroup Objects
@@ -181,6 +182,14 @@ protected:
         //! Multiplicative non-energy cost penalty.
         DEFINE_VARIABLE( SIMPLE, "non-energy-penalty", mNonEnergyCostPenalty, double )
     )
+    
+    //! A pre-located market which has been cached from the marketplace for the
+    //! carbon storage.
+    CachedMarket mCachedStorageMarket;
+    
+    //! A pre-located market which has been cached from the marketplace for the
+    //! price of the target gas.
+    CachedMarket mCachedTargetGasMarket;
 };
 
 #endif // _STANDARD_CAPTURE_COMPONENT_H_
@@ -74,6 +74,8 @@ AgProductionTechnology::AgProductionTechnology( const string& aName, const int a
     mHarvestsPerYear = 1;
     mLandAllocator = 0;
     mProductLeaf = 0;
+    mCachedSubsidy = 0;
+    mCachedSubsidyPeriod = -1;
 }
 
 // ! Destructor
@@ -98,6 +100,8 @@ void AgProductionTechnology::copy( const AgProductionTechnology& aOther ) {
     // The following do not get copied as they are initialized through other means
     mLandAllocator = 0;
     mProductLeaf = 0;
+    mCachedSubsidy = 0;
+    mCachedSubsidyPeriod = -1;
 }
 
 //! Parses any input variables specific to derived classes
@@ -179,6 +183,15 @@ void AgProductionTechnology::initCalc( const string& aRegionName,
 {
     Technology::initCalc( aRegionName, aSectorName, aSubsectorInfo,
                           aDemographics, aPrevPeriodInfo, aPeriod );
+
+    // Locate the product market and read the subsidy, which is fixed for the
+    // period, so calcProfitRate does not need to look them up by name.
+    if( mProductionState[ aPeriod ]->isOperating() ){
+        mCachedMarket = scenario->getMarketplace()->locateMarket( aSectorName, aRegionName, aPeriod );
+        mCachedSubsidy = mCachedMarket.getMarketInfo( aSectorName, aRegionName, aPeriod, true )
+            ->getDouble( aRegionName + "subsidy", true );
+        mCachedSubsidyPeriod = aPeriod;
+    }
   
     const Modeltime* modeltime = scenario->getModeltime();
 
@@ -475,18 +488,17 @@ double AgProductionTechnology::calcProfitRate( const string& aRegionName,
                                                const int aPeriod ) const
 {
     // Calculate profit rate.
-    const Marketplace* marketplace = scenario->getMarketplace();
-
     // TODO: consider adding the residue biomass value to crop value
     // First, need to change residue biomass output as per unit of land
     // in order to prevent a simultaneity.  Then, we can include this value.
     double secondaryValue = calcSecondaryValue( aRegionName, aPeriod );
 
     // nonlandvariable cost units are now assumed to be in $/kg
-    double price = marketplace->getPrice( aProductName, aRegionName, aPeriod );
+    double price = mCachedMarket.getPrice( aProductName, aRegionName, aPeriod );
 
 	// subsidy in $/kg
-    double subsidy = marketplace->getMarketInfo( aProductName, aRegionName, aPeriod, true )->getDouble( aRegionName+"subsidy", true );
+    double subsidy = aPeriod == mCachedSubsidyPeriod ? mCachedSubsidy :
+        mCachedMarket.getMarketInfo( aProductName, aRegionName, aPeriod, true )->getDouble( aRegionName+"subsidy", true );
 
     // Compute cost of variable inputs (such as water and fertilizer)
     double inputCosts = getTotalInputCost( aRegionName, aProductName, aPeriod );
@@ -83,6 +83,7 @@ void FractionalSecondaryOutput::copy( const FractionalSecondaryOutput& aOther )
     
     delete mCostCurve;
     mCostCurve = aOther.mCostCurve ? aOther.mCostCurve->clone() : 0;
+    mCostTable = aOther.mCostTable;
 }
 
 const string& FractionalSecondaryOutput::getName() const
@@ -210,8 +211,9 @@ void FractionalSecondaryOutput::completeInit( const string& aSectorName,
         mainLog << "No fraction-produced read in for " << getXMLNameStatic() << " " << getName() << endl;
         abort();
     }
+    mCostTable.setCurve( mCostCurve );
 
-    if( mCostCurve->getMinY() > 0 ) {
+    if( mCostTable.getMinY() > 0 ) {
         ILogger& mainLog = ILogger::getLogger( "main_log" );
         mainLog.setLevel( ILogger::WARNING);
         mainLog << "Minimum fraction-produced greater than zero for " << getXMLNameStatic() << " " << getName() << endl;
@@ -226,7 +228,9 @@ void FractionalSecondaryOutput::initCalc( const string& aRegionName,
     // however there may still be some indirect behavior above the top of the curve as it affects
     // the primary good's economics.
     SectorUtils::setSupplyBehaviorBounds( getName(), mMarketName.empty() ? aRegionName : mMarketName,
-            mCostCurve->getMinX(), util::getLargeNumber(), aPeriod );
+            mCostTable.getMinX(), util::getLargeNumber(), aPeriod );
+
+    mCachedMarket = scenario->getMarketplace()->locateMarket( mName, mMarketName.empty() ? aRegionName : mMarketName, aPeriod );
 }
 
 
@@ -259,8 +263,7 @@ void FractionalSecondaryOutput::setPhysicalOutput( const double aPrimaryOutput,
      * \warning Adding to supply of an intermediate good will not work as intended, in that case a
      *          regular SecondaryOutput should be used which will subtract from demand.
      */
-    Marketplace* marketplace = scenario->getMarketplace();
-    marketplace->addToSupply( mName, mMarketName.empty() ? aRegionName : mMarketName,
+    mCachedMarket.addToSupply( mName, mMarketName.empty() ? aRegionName : mMarketName,
             mPhysicalOutputs[ aPeriod ], aPeriod, true );
 }
 
@@ -275,7 +278,7 @@ double FractionalSecondaryOutput::getValue( const string& aRegionName,
 {
     double secondaryGoodPrice = getMarketPrice( aRegionName, aPeriod );
     // do not allow extrapolation
-    double productionFraction = min( mCostCurve->getMaxY(), mCostCurve->getY( secondaryGoodPrice ) );
+    double productionFraction = min( mCostTable.getMaxY(), mCostTable.getY( secondaryGoodPrice ) );
 
     // The value of the secondary output is the market price multiplied by the
     // output ratio adjusted by the fractional production.
@@ -305,7 +308,7 @@ void FractionalSecondaryOutput::accept( IVisitor* aVisitor, const int aPeriod )
  * \return The market price.
  */
 double FractionalSecondaryOutput::getMarketPrice( const string& aRegionName, const int aPeriod ) const {
-    double price = scenario->getMarketplace()->getPrice( mName, mMarketName.empty() ? aRegionName : mMarketName, aPeriod, true );
+    double price = mCachedMarket.getPrice( mName, mMarketName.empty() ? aRegionName : mMarketName, aPeriod, true );
 
     // Market price should exist or there is not a sector with this good as the
     // primary output. This can be caused by incorrect input files.
@@ -333,7 +336,7 @@ double FractionalSecondaryOutput::calcPhysicalOutputInternal( const string& aReg
     double maxSecondaryOutput = aPrimaryOutput * mOutputRatio;
     double secondaryGoodPrice = getMarketPrice( aRegionName, aPeriod );
     // do not allow extrapolation
-    double productionFraction = min( mCostCurve->getMaxY(), mCostCurve->getY( secondaryGoodPrice ) );
+    double productionFraction = min( mCostTable.getMaxY(), mCostTable.getY( secondaryGoodPrice ) );
     return maxSecondaryOutput * productionFraction;
 }
 
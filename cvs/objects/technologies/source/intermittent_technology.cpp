@@ -313,6 +313,8 @@ void IntermittentTechnology::initCalc( const string& aRegionName,
                                               aRegionName, 0, 1, aPeriod );
     }
     initializeInputLocations( aRegionName, aSectorName, aPeriod );
+    mCachedElectricSectorMarket = scenario->getMarketplace()->locateMarket( mElectricSectorName,
+                                                                            mElectricSectorMarket, aPeriod );
 }
 
 void IntermittentTechnology::postCalc( const string& aRegionName,
@@ -344,7 +346,7 @@ void IntermittentTechnology::production( const string& aRegionName,
     
     // For the trial intermittent technology market, set the trial supply amount to
     // the ratio of intermittent-technology output to the electricity output.
-    double dependentSectorOutput = scenario->getMarketplace()->getDemand( mElectricSectorName, mElectricSectorMarket, aPeriod );
+    double dependentSectorOutput = mCachedElectricSectorMarket.getDemand( mElectricSectorName, mElectricSectorMarket, aPeriod );
 
     if ( dependentSectorOutput > 0 ){
         mIntermitOutTechRatio = std::min( getOutput( aPeriod ) / dependentSectorOutput, 1.0 );
@@ -214,6 +214,14 @@ void NukeFuelTechnology::initCalc( const string& aRegionName,
     for( InputIterator i = mInputs.begin(); i != mInputs.end(); ++i ){
         (*i)->setCoefficient( kgFissilePerGJ, aPeriod );
     }
+
+    Marketplace* marketplace = scenario->getMarketplace();
+    if( fertileFuelName != "none" ) {
+        mCachedFertileMarket = marketplace->locateMarket( fertileFuelName, aRegionName, aPeriod );
+    }
+    if( blanketFuelName != "none" ) {
+        mCachedBlanketMarket = marketplace->locateMarket( blanketFuelName, aRegionName, aPeriod );
+    }
 }
 void NukeFuelTechnology::completeInit( const string& aRegionName,
                                       const string& aSectorName,
@@ -326,17 +334,16 @@ void NukeFuelTechnology::production( const string& aRegionName,
         1, aPeriod, 0, mAlphaZero );
 
     // add demand for fertile material
-    Marketplace* marketplace = scenario->getMarketplace();
     if( fertileFuelName != "none" ) {
         mLastFertileValue = primaryOutput / getFertileEfficiency( aPeriod );
-        marketplace->addToDemand( fertileFuelName, aRegionName,
-                                  mLastFertileValue, aPeriod );
+        mCachedFertileMarket.addToDemand( fertileFuelName, aRegionName,
+                                          mLastFertileValue, aPeriod );
     }
     // add demand for blanket material
     if( blanketFuelName != "none" ) {
         mLastBlanketValue = primaryOutput / getBlanketEfficiency( aPeriod );
-        marketplace->addToDemand( blanketFuelName, aRegionName,
-                                  mLastBlanketValue, aPeriod );
+        mCachedBlanketMarket.addToDemand( blanketFuelName, aRegionName,
+                                          mLastBlanketValue, aPeriod );
     }
 
     // calculate by-products from technology (shk 10/11/04) mass of initial
@@ -187,6 +187,9 @@ void PowerPlantCaptureComponent::initCalc( const string& aRegionName,
                                            const string& aFuelName,
                                            const int aPeriod )
 {
+    const Marketplace* marketplace = scenario->getMarketplace();
+    mCachedStorageMarket = marketplace->locateMarket( mStorageMarket, aRegionName, aPeriod );
+    mCachedTargetGasMarket = marketplace->locateMarket( mTargetGas, aRegionName, aPeriod );
 }
 
 /**
@@ -205,13 +208,13 @@ double PowerPlantCaptureComponent::getStorageCost( const string& aRegionName,
     }
 
     // Check if there is a market for storage.
-    double storageMarketPrice = scenario->getMarketplace()->getPrice( mStorageMarket,
-                                                                      aRegionName,
-                                                                      aPeriod, true );
+    double storageMarketPrice = mCachedStorageMarket.getPrice( mStorageMarket,
+                                                               aRegionName,
+                                                               aPeriod, true );
     // Check if there is a carbon market.
-    double carbonMarketPrice = scenario->getMarketplace()->getPrice( mTargetGas,
-                                                                     aRegionName,
-                                                                     aPeriod, false );
+    double carbonMarketPrice = mCachedTargetGasMarket.getPrice( mTargetGas,
+                                                                aRegionName,
+                                                                aPeriod, false );
 
     // If there is no carbon market, return a large number to disable the
     // capture technology.
@@ -257,9 +260,8 @@ double PowerPlantCaptureComponent::calcSequesteredAmount( const string& aRegionN
         sequestered = removeFrac * aTotalEmissions;
         mSequesteredAmount[ aPeriod ] = sequestered;
         // set sequestered amount as demand side of carbon storage market
-        Marketplace* marketplace = scenario->getMarketplace();
-        marketplace->addToDemand( mStorageMarket, aRegionName, mSequesteredAmount[ aPeriod ],
-            aPeriod, false );
+        mCachedStorageMarket.addToDemand( mStorageMarket, aRegionName, mSequesteredAmount[ aPeriod ],
+                                          aPeriod, false );
     }
     return sequestered;
 }
@@ -90,6 +90,7 @@ void ResidueBiomassOutput::copy( const ResidueBiomassOutput& aOther ) {
     
     delete mCostCurve;
     mCostCurve = aOther.mCostCurve ? aOther.mCostCurve->clone() : 0;
+    mCostTable = aOther.mCostTable;
     
     // note results are not copied.
 }
@@ -146,8 +147,7 @@ IOutput::OutputList ResidueBiomassOutput::calcPhysicalOutput( const double aPrim
         return outputList;
     }
 
-    const Marketplace* marketplace = scenario->getMarketplace();
-    double price = marketplace->getPrice( getName(), aRegionName, aPeriod, true );
+    double price = mCachedMarket.getPrice( getName(), aRegionName, aPeriod, true );
 
     // If there is no market price, return
     if ( price == Marketplace::NO_MARKET_PRICE ) {
@@ -205,7 +205,7 @@ IOutput::OutputList ResidueBiomassOutput::calcPhysicalOutput( const double aPrim
 
     // Compute the fraction of the total possible supply that is
     // produced at the current biomass price 
-    mFractProduced = mCostCurve->getY( price );
+    mFractProduced = mCostTable.getY( price );
 
     // Compute the quantity of a crop residue biomass produced
     double resEnergy = mMaxBioEnergySupply * mFractProduced;
@@ -258,6 +258,7 @@ void ResidueBiomassOutput::completeInit( const std::string& aSectorName, const s
                                                                       aRegionName,
                                                                       getName(),
                                                                       aRegionName );
+    mCostTable.setCurve( mCostCurve );
 }
 
 double ResidueBiomassOutput::getEmissionsPerOutput( const std::string& aGHGName, const int aPeriod ) const
@@ -296,8 +297,8 @@ void ResidueBiomassOutput::initCalc( const std::string& aRegionName, const std::
                                      const int aPeriod )
 {
     assert( scenario != 0 );
-    const Marketplace* marketplace = scenario->getMarketplace();
-    const IInfo* productInfo = marketplace->getMarketInfo( getName(), aRegionName, aPeriod, false );
+    mCachedMarket = scenario->getMarketplace()->locateMarket( getName(), aRegionName, aPeriod );
+    const IInfo* productInfo = mCachedMarket.getMarketInfo( getName(), aRegionName, aPeriod, false );
 
     mCachedCO2Coef.set( productInfo ? productInfo->getDouble( "CO2Coef", false ) : 0 );
 }
@@ -328,8 +329,7 @@ void ResidueBiomassOutput::setPhysicalOutput( const double aPrimaryOutput, const
     mPhysicalOutputs[ aPeriod ].set( outputList.front().second );
 
     // Add output to the supply
-    Marketplace* marketplace = scenario->getMarketplace();
-    marketplace->addToSupply( getName(), aRegionName, mPhysicalOutputs[ aPeriod ],
+    mCachedMarket.addToSupply( getName(), aRegionName, mPhysicalOutputs[ aPeriod ],
             aPeriod, true );
 }
 
@@ -193,6 +193,8 @@ void SecondaryOutput::initCalc( const string& aRegionName,
     // CO2 coefficient and the ratio of output to the primary good.
     const double CO2Coef = FunctionUtils::getCO2Coef( mMarketName.empty() ? aRegionName : mMarketName, mName, aPeriod );
     mCachedCO2Coef.set( CO2Coef * mOutputRatio );
+
+    mCachedMarket = scenario->getMarketplace()->locateMarket( mName, mMarketName.empty() ? aRegionName : mMarketName, aPeriod );
 }
 
 
@@ -228,8 +230,7 @@ void SecondaryOutput::setPhysicalOutput( const double aPrimaryOutput,
     // because the sector which has this output as a primary will attempt to
     // fill all of demand. If this technology also added to supply, supply would
     // not equal demand.
-    Marketplace* marketplace = scenario->getMarketplace();
-    marketplace->addToDemand( mName, mMarketName.empty() ? aRegionName : mMarketName, mPhysicalOutputs[ aPeriod ], aPeriod, true );
+    mCachedMarket.addToDemand( mName, mMarketName.empty() ? aRegionName : mMarketName, mPhysicalOutputs[ aPeriod ], aPeriod, true );
 }
 
 double SecondaryOutput::getPhysicalOutput( const int aPeriod ) const
@@ -242,7 +243,7 @@ double SecondaryOutput::getValue( const string& aRegionName,
                                   const ICaptureComponent* aCaptureComponent,
                                   const int aPeriod ) const
 {
-    double price = scenario->getMarketplace()->getPrice( mName, mMarketName.empty() ? aRegionName : mMarketName, aPeriod, true );
+    double price = mCachedMarket.getPrice( mName, mMarketName.empty() ? aRegionName : mMarketName, aPeriod, true );
 
     // Market price should exist or there is not a sector with this good as the
     // primary output. This can be caused by incorrect input files.
@@ -178,6 +178,9 @@ void StandardCaptureComponent::initCalc( const string& aRegionName,
                                            const string& aFuelName,
                                            const int aPeriod )
 {
+    const Marketplace* marketplace = scenario->getMarketplace();
+    mCachedStorageMarket = marketplace->locateMarket( mStorageMarket, aRegionName, aPeriod );
+    mCachedTargetGasMarket = marketplace->locateMarket( mTargetGas, aRegionName, aPeriod );
 }
 
 /**
@@ -198,14 +201,14 @@ double StandardCaptureComponent::getStorageCost( const string& aRegionName,
     }
 
     // Check if there is a market for storage.
-    double storageMarketPrice = scenario->getMarketplace()->getPrice( mStorageMarket,
-                                                                      aRegionName,
-                                                                      aPeriod, false );
+    double storageMarketPrice = mCachedStorageMarket.getPrice( mStorageMarket,
+                                                               aRegionName,
+                                                               aPeriod, false );
     
     // Check if there is a carbon market.
-    double carbonMarketPrice = scenario->getMarketplace()->getPrice( mTargetGas,
-                                                                     aRegionName,
-                                                                     aPeriod, false );
+    double carbonMarketPrice = mCachedTargetGasMarket.getPrice( mTargetGas,
+                                                                aRegionName,
+                                                                aPeriod, false );
 
     // If there is no carbon market, return a large number to disable the
     // capture technology.
@@ -259,9 +262,8 @@ double StandardCaptureComponent::calcSequesteredAmount( const string& aRegionNam
         sequestered = removeFrac * aTotalEmissions;
         mSequesteredAmount[ aPeriod ] = sequestered;
         // set sequestered amount as demand side of carbon storage market
-        Marketplace* marketplace = scenario->getMarketplace();
-        marketplace->addToDemand( mStorageMarket, aRegionName, mSequesteredAmount[ aPeriod ], aPeriod,
-                                  false );
+        mCachedStorageMarket.addToDemand( mStorageMarket, aRegionName, mSequesteredAmount[ aPeriod ], aPeriod,
+                                          false );
     }
     return sequestered;
 }
@@ -0,0 +1,195 @@
+#ifndef _DETERMINISTIC_SUM_H_
+#define _DETERMINISTIC_SUM_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file deterministic_sum.h
+ * \ingroup Objects
+ * \brief The DeterministicSum class header file.
+ */
+
+#include <cmath>
+
+#if GCAM_PARALLEL_ENABLED
+#include <atomic>
+#endif
+
+#include "util/base/include/value.h"
+
+/*!
+ * \ingroup Objects
+ * \brief A running sum whose result does not depend on the order in which
+ *        values were added to it.
+ * \details Floating point addition is not associative so when several threads
+ *          add to the same total the result depends on how the work happened
+ *          to be scheduled.  This class instead splits each value into a fixed
+ *          number of limbs, each an integer multiple of a fixed power of two,
+ *          and keeps a separate total of each limb.  Sums of such limbs are
+ *          exact so long as the limb totals stay within the 53 bit mantissa of
+ *          a double.  Since every addition is exact each limb total, and
+ *          therefore the result, is bit for bit the same no matter the order of
+ *          the additions.
+ *
+ *          The limbs hold the parts of a value at or above 2^20, between 2^-20
+ *          and 2^20, and between 2^-60 and 2^-20.  Anything smaller than 2^-60
+ *          is dropped.  The two smaller limbs are below 2^40 units each so over
+ *          8000 of them may be added before their totals could lose precision.
+ *          The top limb is a multiple of 2^20 but is not otherwise bounded and
+ *          its total is only exact while it stays below 2^73 (about 9.4e21).
+ *          A value at or beyond that limit, or one which is not finite, is
+ *          added to the top limb whole rather than split.  Once the top limb
+ *          total reaches 2^73, either way, the result is no longer guaranteed
+ *          to be independent of the order of additions.
+ *
+ *          When GCAM_PARALLEL_ENABLED each limb is added with a compare and
+ *          swap rather than under a lock.  The limbs are Values so that they may
+ *          be collected as active state by ManageStateVariables and be copied
+ *          in to a scratch state during partial derivatives.  Reading the sum
+ *          while additions are ongoing is not supported, the flow graph ensures
+ *          all of the additions to a market are done before it is read.
+ */
+class DeterministicSum {
+    friend class ManageStateVariables;
+public:
+    DeterministicSum();
+    void reset();
+    void set( const double aValue );
+    void add( const double aValue );
+    double get() const;
+private:
+    //! The number of limbs each value is split into.
+    static const int NUM_LIMBS = 3;
+
+    //! The exponent of the power of two the largest limb is a multiple of.
+    static const int TOP_LIMB_EXPONENT = 20;
+
+    //! The number of bits of a value held by each of the smaller limbs.
+    static const int LIMB_BITS = 40;
+
+    //! The running total of each limb.
+    Value mLimbs[ NUM_LIMBS ];
+
+    static void addLimb( Value& aLimb, const double aValue );
+};
+
+inline DeterministicSum::DeterministicSum() {
+    reset();
+}
+
+//! Reset the sum to zero.
+inline void DeterministicSum::reset() {
+    for( int i = 0; i < NUM_LIMBS; ++i ) {
+        mLimbs[ i ].getInternal() = 0.0;
+    }
+}
+
+/*!
+ * \brief Reset the sum to the given value.
+ * \param aValue The new value of the sum.
+ */
+inline void DeterministicSum::set( const double aValue ) {
+    reset();
+    add( aValue );
+}
+
+/*!
+ * \brief Add a value to the sum.
+ * \details This may be called concurrently from several threads.  Values whose
+ *          magnitude is at least 2^73 are added to the top limb without
+ *          splitting as described in the class documentation.
+ * \param aValue The value to add.
+ */
+inline void DeterministicSum::add( const double aValue ) {
+    // The largest magnitude for which the top limb total is exact.  Note the
+    // comparison is written so that NaN also takes this path.
+    const double topLimbLimit = std::ldexp( 1.0, 53 + TOP_LIMB_EXPONENT );
+    if( !( std::fabs( aValue ) < topLimbLimit ) ) {
+        addLimb( mLimbs[ 0 ], aValue );
+        return;
+    }
+    double remainder = aValue;
+    for( int i = 0; i < NUM_LIMBS; ++i ) {
+        // Truncation keeps every limb the same sign as aValue and both it and
+        // the subtraction below are exact.
+        const int exponent = TOP_LIMB_EXPONENT - i * LIMB_BITS;
+        const double limb = std::ldexp( std::trunc( std::ldexp( remainder, -exponent ) ), exponent );
+        if( limb != 0.0 ) {
+            addLimb( mLimbs[ i ], limb );
+        }
+        remainder -= limb;
+    }
+}
+
+/*!
+ * \brief Get the current value of the sum.
+ * \details The limbs are combined smallest first in a fixed order.
+ * \return The sum of all values added since the last reset.
+ */
+inline double DeterministicSum::get() const {
+    double sum = 0.0;
+    for( int i = NUM_LIMBS - 1; i >= 0; --i ) {
+        sum += mLimbs[ i ].getInternal();
+    }
+    return sum;
+}
+
+/*!
+ * \brief Add a single limb to its running total.
+ * \param aLimb The running total to add to.
+ * \param aValue The limb to add which, for values below 2^73, is exactly
+ *        representable along with the total.
+ */
+inline void DeterministicSum::addLimb( Value& aLimb, const double aValue ) {
+    double& total = aLimb.getInternal();
+#if GCAM_PARALLEL_ENABLED
+    // C++14 has no way to do atomic operations on an existing double so we rely
+    // on std::atomic<double> sharing its layout which is the case with every
+    // compiler GCAM supports.
+    static_assert( sizeof( std::atomic<double> ) == sizeof( double ),
+                   "std::atomic<double> must have the same layout as double" );
+    std::atomic<double>& atomicTotal = reinterpret_cast<std::atomic<double>&>( total );
+    double expected = atomicTotal.load( std::memory_order_relaxed );
+    while( !atomicTotal.compare_exchange_weak( expected, expected + aValue, std::memory_order_relaxed ) ) {
+    }
+#else
+    total += aValue;
+#endif
+}
+
+#endif // _DETERMINISTIC_SUM_H_
@@ -44,14 +44,17 @@
  */
 
 #include <cassert>
-#include <forward_list>
+#include <cstdint>
+#include <map>
 #include <string>
+#include <vector>
 #include "util/base/include/definitions.h"
 
 class Value;
 
 #if GCAM_PARALLEL_ENABLED
 #include <tbb/task_arena.h>
+#include <tbb/concurrent_queue.h>
 #endif
 
 /*!
@@ -59,7 +62,7 @@ class Value;
  *        they can be managed and reset as appropriate.
  * \details All Data definitions marked as STATE will be searched for using GCAMFusion
  *          and only those that could possibly be changed during World.calc of the
- *          period for which this class was created will be managed as active state.
+ *          period this class is currently bound to will be managed as active state.
  *          The Value class is used in conjunction with this class such that the
  *          actual state data is stored in tightly packed arrays that can quickly
  *          get reset.  In addition the Value can be set at the same time from multiple
@@ -67,18 +70,70 @@ class Value;
  *          developers do not need to worry about any of this.  All they have to do
  *          is ensure they appropriately tag their STATE Data.
  *
+ *          Each collected Value is also given a key derived from the names (and
+ *          years) of the objects containing it.  These keys are saved in restart
+ *          files so that a restart can be matched back to the state of a run whose
+ *          inputs differ slightly, see loadRestartFile.
+ *
+ *          A single instance is kept by the Scenario for the whole run and is
+ *          bound to each period in turn with setPeriod and releasePeriod.  The
+ *          Values found for a period are remembered so that solving the same
+ *          period again, such as in the next target finder trial, does not need
+ *          to search the model again.  Any structural change to the model must
+ *          call clearCollectedState, see Scenario::completeInit.
+ *
  * \author Pralit Patel
  */
 class ManageStateVariables {
 public:
-    ManageStateVariables( const int aPeriod );
+    ManageStateVariables();
     ~ManageStateVariables();
     
+    void setPeriod( const int aPeriod );
+    
+    void releasePeriod();
+    
+    void clearCollectedState();
+    
     void copyState();
     
     void setPartialDeriv( const bool aIsPartialDeriv );
     
+    /*!
+     * \brief Binds a "scratch" state slot to the calling thread for the lifetime
+     *        of this object.
+     * \details Each task which calculates a partial derivative concurrently with
+     *          others should create one of these before calling copyState() and
+     *          keep it alive until it is done reading the results.  The binding that
+     *          was in place before construction is restored on destruction so that
+     *          handles may be nested if TBB happens to run one task inside another
+     *          on the same thread.  Constructing with a null manager does nothing
+     *          which allows callers to bind conditionally.
+     */
+    class StateHandle {
+    public:
+        explicit StateHandle( ManageStateVariables* aStateManager );
+        ~StateHandle();
+    private:
+        //! The state manager the slot was acquired from, may be null.
+        ManageStateVariables* mStateManager;
+        
+        //! The index into ManageStateVariables::mStateData bound by this handle.
+        int mSlot;
+        
+        //! The binding to restore when this handle is destroyed.
+        double* mPrevState;
+        
+        // Not implemented, handles can not be shared.
+        StateHandle( const StateHandle& );
+        StateHandle& operator=( const StateHandle& );
+    };
+    
 #if GCAM_PARALLEL_ENABLED
+    static double* getThreadState();
+    
+    static void setThreadState( double* aState );
+    
     //! A tbb task arena which is the closest tbb comes to a thread pool which we
     //! will insist parallel calculations use so that we can ensure that we have
     //! appropriately sized and allocated a slot in mStateData for each thread to
@@ -93,11 +148,36 @@ private:
     //! partial derivatives where before a new partial derivative is performed the
     //! "scratch" space is copied over by the "base" state.  Without GCAM_PARALLEL_ENABLED
     //! only a single "scratch" state will be allocated, when it is enabled there
-    //! will be as many as the max_concurrency the thread pool allows on the system
-    //! running the code.
+    //! will be one for the thread which calls setPartialDeriv plus as many as the
+    //! max_concurrency the thread pool allows on the system running the code.
     double** mStateData;
     
-    //! The period this state was collected for.
+    //! The number of doubles allocated for each slot in mStateData, including
+    //! the dirty page flags.  The arrays are kept from one period to the next
+    //! and only reallocated when a period needs more space.
+    size_t mStateCapacity;
+    
+#if GCAM_PARALLEL_ENABLED
+    //! The indices into mStateData which are not currently bound to a StateHandle.
+    tbb::concurrent_queue<int> mFreeStates;
+#endif
+    
+    //! The number of pages each state slot is divided into for the purposes of
+    //! dirty tracking.  Each slot in mStateData is followed by one flag per page
+    //! which Value sets when it writes into that page.
+    size_t mNumPages;
+    
+    //! Incremented each time a new round of partial derivatives begins as the
+    //! "base" state may have changed since the last round.
+    unsigned int mBaseVersion;
+    
+    //! The mBaseVersion each "scratch" slot was last fully copied from.  If it
+    //! does not match the current mBaseVersion copyState must copy everything,
+    //! otherwise only the dirty pages need to be restored.
+    std::vector<unsigned int> mStateVersion;
+    
+    //! The period this state was collected for or -1 if not currently bound
+    //! to a period.
     int mPeriodToCollect;
     
     //! The year corresponding to mPeriodToCollect converted ahead of time in the
@@ -112,17 +192,45 @@ private:
     //! be changed during World.calc( mPeriodToCollect ).
     size_t mNumCollected;
     
-    //! The list of individual Values flagged as STATE that could possibly be
-    //! changed during World.calc( mPeriodToCollect ).  We store them in a list
-    //! since searching via GCAMFusion is a relatively expensive operation and we
-    //! will need to take three passes at them:
+    //! The individual Values flagged as STATE that could possibly be changed
+    //! during World.calc( mPeriodToCollect ).  We keep them since searching via
+    //! GCAMFusion is a relatively expensive operation and we will need to take
+    //! several passes at them:
     //! - Figure out how many we have so what we can allocate enough memory for mStateData.
     //! - Copy the actual data from each Value to initialize the "base" state.
     //! - When we are done with this period copy the "base" state back into each Value.
-    std::forward_list<Value*> mStateValues;
+    //! - The next time mPeriodToCollect is calculated, see mCollectedState.
+    std::vector<Value*> mStateValues;
+    
+    //! The model object, as identified by IActivity::getStateOwner, that contained
+    //! each of the Values in mStateValues in the same order.  This is only needed
+    //! temporarily while collecting state to optionally reorder mStateValues.
+    std::vector<const void*> mStateOwners;
+    
+    //! A key identifying each of the Values in mStateValues in the same order
+    //! by its position in the model rather than in memory.  These are only kept
+    //! after collecting state if restart files are being read or written.
+    std::vector<uint64_t> mStateKeys;
+    
+    //! The Values and keys found for a period which has been released.
+    struct CollectedState {
+        std::vector<Value*> mValues;
+        std::vector<uint64_t> mKeys;
+    };
+    
+    //! The state collected for each period that has been calculated, by period.
+    //! Only kept if the configuration flag reuse-collected-state is set.
+    std::map<int, CollectedState> mCollectedState;
+    
+    //! Whether to remember the state collected for each period.
+    bool mShouldReuseState;
     
     void collectState();
     
+    void initState();
+    
+    void orderStateByActivity();
+    
     void resetState();
     
     std::string getRestartFileName() const;
@@ -131,6 +239,13 @@ private:
     
     void saveRestartFile();
     
+    const std::vector<uint64_t>& getStateKeys() const;
+    
+    void mapRestartState( const std::string& aRestartFileName,
+                          const uint64_t* aRestartKeys,
+                          const double* aRestartState,
+                          const size_t aNumRestartStates );
+    
     /*!
      * \brief A helper struct to provide a call back to GCAMFusion as it searches
      *        for data flagged STATE.
@@ -150,6 +265,37 @@ private:
         //! is found.
         bool mIgnoreCurrValue = false;
         
+        //! The outer most Sector, AResource, etc which contains the Data currently
+        //! being processed, or null if not in one.  This is reset when the
+        //! corresponding popFilterStep is found.
+        const void* mCurrOwner = 0;
+        
+        //! An entry in the path of containers leading to the Data currently
+        //! being processed.
+        struct PathStep {
+            //! The key identifying this container.
+            uint64_t mKey;
+            
+            //! The number of state Values found directly in this container.
+            unsigned int mNumValues;
+            
+            //! The number of containers found directly in this container by the
+            //! key of their name and year, used to tell apart containers which
+            //! are identified the same way such as technology vintages.
+            std::map<uint64_t, unsigned int> mNumChildren;
+        };
+        
+        //! The containers leading to the Data currently being processed, the
+        //! first being the root of the search.
+        std::vector<PathStep> mPath;
+        
+        void addStateValue( Value* aValue );
+        
+        template<typename ContainerType>
+        void pushPath( ContainerType* const& aData );
+        
+        void popPath();
+        
         // Templated callbacks for GCAMFusion
         template<typename DataType>
         void processData( DataType& aData );
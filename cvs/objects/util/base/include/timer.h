@@ -65,6 +65,7 @@ public:
     void start();
     void stop();
     double getTotalTimeDifference() const;
+    unsigned int getNumCalls() const;
     void print( std::ostream& aOut, const std::string& aTitle = "Time: " ) const;
 private:
     //! Time the timer started
@@ -79,6 +80,9 @@ private:
     
     //! The total time measured by this timer between all starts and stops.
     double mTotalTime;
+    
+    //! The number of times this timer was stopped after being started.
+    unsigned int mNumCalls;
 };
 
 /*!
@@ -109,6 +113,8 @@ public:
         EDFUN_POST,
         EDFUN_AN_RESET,
         WRITE_DATA,
+        COPY_STATE,
+        BSOLVE,
         END
     };
     
@@ -119,6 +125,10 @@ public:
     Timer& getTimer( const PredefinedTimers aTimerName );
     
     void printAllTimers( std::ostream& aOut ) const;
+    
+    static std::string getTimerName( const PredefinedTimers aTimerName );
+    
+    const std::map<std::string, Timer>& getNamedTimers() const;
 private:
     //! Private constructor to prevent multiple registries
     TimerRegistry();
@@ -0,0 +1,245 @@
+#ifndef _TRACE_RECORDER_H_
+#define _TRACE_RECORDER_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file trace_recorder.h
+ * \ingroup Objects
+ * \brief Header file for the TraceRecorder and TraceScope classes.
+ */
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <atomic>
+#include <iosfwd>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/core/noncopyable.hpp>
+
+#if GCAM_PARALLEL_ENABLED
+#include <tbb/spin_mutex.h>
+#endif
+
+/*!
+ * \ingroup Objects
+ * \brief Records nested, per thread timed scopes which can be written out in the
+ *        Chrome trace format.
+ * \details Where the TimerRegistry keeps a flat total of time for each timer this
+ *          class records each TraceScope as an individual event on the thread
+ *          which ran it so that nesting, load balance across threads and which
+ *          activities (region and sector) dominate the calculation can be seen.
+ *          The resulting file can be loaded in chrome://tracing or Perfetto.
+ *          Events are buffered per thread so recording does not contend between
+ *          threads.  To bound memory only the first mMaxEvents events are kept,
+ *          however the per thread summary of total time, self time (excluding
+ *          nested scopes) and number of calls of every scope is always complete.
+ *
+ *          Recording is disabled by default in which case a TraceScope costs a
+ *          single check of a flag.
+ */
+class TraceRecorder : private boost::noncopyable {
+    friend class TraceScope;
+public:
+    static TraceRecorder& getInstance();
+    
+    /*!
+     * \brief Whether scopes are currently being recorded.
+     * \return True if recording.
+     */
+    static bool isEnabled() {
+        return sEnabled;
+    }
+    
+    void setEnabled( const bool aEnabled, const size_t aMaxEvents );
+    
+    void recordCounter( const char* aName, const double aValue );
+    
+    void writeChromeTrace( std::ostream& aOut ) const;
+private:
+    //! A single completed scope.
+    struct TraceEvent {
+        //! The name of the scope.
+        std::string mName;
+        
+        //! The category of the scope.
+        const char* mCategory;
+        
+        //! The start of the scope in microseconds since the recorder was created.
+        long mStart;
+        
+        //! The duration of the scope in microseconds.
+        long mDuration;
+    };
+    
+    //! A single sample of a counter.
+    struct CounterEvent {
+        //! The name of the counter.
+        const char* mName;
+        
+        //! The time of the sample in microseconds since the recorder was created.
+        long mTime;
+        
+        //! The value of the counter.
+        double mValue;
+    };
+    
+    //! The aggregate statistics of all scopes with the same category and name.
+    struct ScopeStats {
+        ScopeStats():mSeconds( 0 ), mSelfSeconds( 0 ), mNumCalls( 0 ) {}
+        
+        //! The total time in the scope.
+        double mSeconds;
+        
+        //! The total time in the scope excluding nested scopes.
+        double mSelfSeconds;
+        
+        //! The number of times the scope was entered.
+        unsigned int mNumCalls;
+    };
+    
+    //! Everything recorded by a single thread.
+    struct ThreadTrace {
+        //! A sequential identifier for the thread.
+        int mThreadID;
+        
+        //! The recorded scopes in the order they completed.
+        std::vector<TraceEvent> mEvents;
+        
+        //! The recorded counter samples.
+        std::vector<CounterEvent> mCounters;
+        
+        //! The time spent in nested scopes of each currently open scope.
+        std::vector<double> mNestedSeconds;
+        
+        //! Summary statistics by category and name.
+        std::map<std::pair<std::string, std::string>, ScopeStats> mStats;
+    };
+    
+    TraceRecorder();
+    
+    ThreadTrace& getThreadTrace();
+    
+    long getMicroseconds( const boost::posix_time::ptime& aTime ) const;
+    
+    void beginScope();
+    
+    void endScope( const char* aCategory, const std::string& aName,
+                   const boost::posix_time::ptime& aStartTime );
+    
+    //! Flag indicating if scopes are being recorded.
+    static bool sEnabled;
+    
+    //! The trace of the current thread or null if it has not recorded anything.
+    static thread_local ThreadTrace* sThreadTrace;
+    
+    //! The time to which all recorded times are relative.
+    boost::posix_time::ptime mEpoch;
+    
+    //! The maximum number of individual events to keep.
+    size_t mMaxEvents;
+    
+    //! The number of individual events kept so far.
+    std::atomic<size_t> mNumEvents;
+    
+    //! The number of events which were not kept due to mMaxEvents.
+    std::atomic<size_t> mNumDropped;
+    
+    //! The traces of every thread which has recorded anything.  A list is used
+    //! so that each thread may keep a pointer to its own trace.
+    std::list<ThreadTrace> mThreadTraces;
+    
+#if GCAM_PARALLEL_ENABLED
+    //! Mutex protecting mThreadTraces when a new thread starts recording.
+    mutable tbb::spin_mutex mMutex;
+#endif
+};
+
+/*!
+ * \ingroup Objects
+ * \brief Records the lifetime of this object as a scope in the TraceRecorder.
+ * \details Scopes on the same thread nest by lifetime.  When the TraceRecorder
+ *          is disabled nothing is recorded and the name is not copied so callers
+ *          which need to build a name should only do so when
+ *          TraceRecorder::isEnabled().
+ */
+class TraceScope : private boost::noncopyable {
+public:
+    /*!
+     * \brief Constructor which begins the scope.
+     * \param aCategory The category of the scope, which must be a string literal.
+     * \param aName The name of the scope.
+     */
+    TraceScope( const char* aCategory, const char* aName ):mCategory( 0 ) {
+        if( TraceRecorder::isEnabled() ) {
+            start( aCategory, aName );
+        }
+    }
+    
+    /*!
+     * \brief Constructor which begins the scope.
+     * \param aCategory The category of the scope, which must be a string literal.
+     * \param aName The name of the scope.
+     */
+    TraceScope( const char* aCategory, const std::string& aName ):mCategory( 0 ) {
+        if( TraceRecorder::isEnabled() ) {
+            start( aCategory, aName );
+        }
+    }
+    
+    //! Destructor which ends the scope.
+    ~TraceScope() {
+        if( mCategory ) {
+            TraceRecorder::getInstance().endScope( mCategory, mName, mStartTime );
+        }
+    }
+private:
+    void start( const char* aCategory, const std::string& aName );
+    
+    //! The category of the scope or null if not recording.
+    const char* mCategory;
+    
+    //! The name of the scope.
+    std::string mName;
+    
+    //! The time the scope began.
+    boost::posix_time::ptime mStartTime;
+};
+
+#endif // _TRACE_RECORDER_H_
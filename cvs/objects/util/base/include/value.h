@@ -48,10 +48,6 @@
 #include <cassert>
 #include "util/base/include/util.h"
 
-#if GCAM_PARALLEL_ENABLED
-#include <tbb/enumerable_thread_specific.h>
-#endif
-
 /*! 
  * \ingroup Objects
  * \brief A class containing a single value in the model.
@@ -69,6 +65,7 @@
 
 class Value {
     friend class ManageStateVariables;
+    friend class DeterministicSum;
     /*!
      * \brief Output stream operator to print a Value.
      * \details Output stream operators allow classes to be printed using the <<
@@ -122,22 +119,28 @@ private:
     double mValue;
     //! A flag to indicate if this Value has been set to any value besides the default.
     bool mIsInit;
-#if !GCAM_PARALLEL_ENABLED
     typedef double* CentralValueType;
-#else
-    // When GCAM_PARALLEL_ENABLED each worker thread will have it's own slot of
-    // state assigned to it.  Note it is important that we use tbb::ets_key_per_instance
-    // which as it uses up a finite resource certainly qualifies as a performance
-    // critical use.
-    typedef tbb::enumerable_thread_specific<double*, tbb::cache_aligned_allocator<double*>, tbb::ets_key_per_instance> CentralValueType;
-#endif
     //! A static reference into ManageStateVariables::mStateData only used if mIsStateCopy
     //! is true.  Note we make this field static so that we can quickly swap state
     //! between a "base" state or some "scratch" value from a central location.
+#if !GCAM_PARALLEL_ENABLED
     static CentralValueType sCentralValue;
+#else
+    //! When GCAM_PARALLEL_ENABLED each task which needs "scratch" state binds a
+    //! slot to the thread it is running on for the duration of the task (see
+    //! ManageStateVariables::StateHandle) so that accessing state is a plain
+    //! indexed load.  A null binding indicates the thread is working on the
+    //! "base" state.
+    static thread_local CentralValueType sCentralValue;
+#endif
     //! A static reference into the "base" state of ManageStateVariables::mStateData
     //! mostly for convenience.
     static double* sBaseCentralValue;
+    //! The offset from the start of each state slot in ManageStateVariables::mStateData
+    //! to the flags which track which pages of that slot have been written to.
+    static size_t sDirtyFlagOffset;
+    //! The log2 of the number of state values tracked by each dirty flag.
+    static const unsigned int STATE_PAGE_SHIFT = 7;
     //! The index into sCentralValue that contains the data for this instance.
     unsigned int mCentralValueIndex;
     //! A flag to indicate if this instance of Value has been identified as active
@@ -180,17 +183,26 @@ inline void Value::init( const double aNewValue ){
 /*!
  * \brief An accessor method to get at the actual data held in this class.
  * \details This method will appropriately get the value locally or the centrally
- *          managed state if the mIsStateCopy flag is set.
+ *          managed state if the mIsStateCopy flag is set.  This version is only
+ *          used to modify the value so it also flags the page of centrally managed
+ *          state as dirty which allows ManageStateVariables::copyState to only
+ *          reset the pages of a scratch state which have actually changed.
  * \return A reference the the appropriate value represented by this class.
  */
 inline double& Value::getInternal() {
-    return mIsStateCopy ?
-#if !GCAM_PARALLEL_ENABLED
-        sCentralValue[mCentralValueIndex]
-#else
-        sCentralValue.local()[mCentralValueIndex]
+    if( mIsStateCopy ) {
+#if GCAM_PARALLEL_ENABLED
+        // Threads without a scratch state bound use the "base" state which is
+        // shared by every thread and whose dirty flags are never read so do
+        // not touch them.
+        if( !sCentralValue ) {
+            return sBaseCentralValue[ mCentralValueIndex ];
+        }
 #endif
-        : mValue;
+        reinterpret_cast<unsigned char*>( sCentralValue + sDirtyFlagOffset )[ mCentralValueIndex >> STATE_PAGE_SHIFT ] = 1;
+        return sCentralValue[ mCentralValueIndex ];
+    }
+    return mValue;
 }
 
 /*!
@@ -204,7 +216,7 @@ inline const double& Value::getInternal() const {
 #if !GCAM_PARALLEL_ENABLED
         sCentralValue[mCentralValueIndex]
 #else
-        sCentralValue.local()[mCentralValueIndex]
+        ( sCentralValue ? sCentralValue : sBaseCentralValue )[mCentralValueIndex]
 #endif
         : mValue;
 }
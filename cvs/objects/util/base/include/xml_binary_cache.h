@@ -0,0 +1,104 @@
+#ifndef _XML_BINARY_CACHE_H_
+#define _XML_BINARY_CACHE_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file xml_binary_cache.h
+ * \ingroup Objects
+ * \brief The XMLBinaryCache class header file.
+ */
+
+#include <string>
+#include <vector>
+#include <map>
+#include <xercesc/util/XercesDefs.hpp>
+
+XERCES_CPP_NAMESPACE_BEGIN
+class DOMNode;
+class DOMDocument;
+XERCES_CPP_NAMESPACE_END
+
+/*!
+ * \ingroup Objects
+ * \brief A cache of already validated XML input files in a compact binary form.
+ * \details Parsing and validating the large XML input files against the schema
+ *          dominates the time it takes to set up a scenario and is repeated for
+ *          each run even though the inputs rarely change.  When the xml-binary-cache
+ *          directory is set in the configuration each input file is stored in that
+ *          directory, after it has been successfully parsed and validated, as a
+ *          pre-order dump of its elements, attributes and text.  Subsequent parses
+ *          of the same file rebuild the DOM directly from the cache, skipping the
+ *          XML scanning and validation entirely.
+ *
+ *          Cache files are keyed by a hash of the contents of the input file so
+ *          they are implicitly invalidated when the input changes.  Note stale
+ *          cache files are never removed.
+ */
+class XMLBinaryCache {
+public:
+    static bool isEnabled();
+    
+    static std::string getCacheFileName( const std::string& aXMLFile );
+    
+    static xercesc::DOMDocument* read( const std::string& aCacheFile );
+    
+    static bool write( const std::string& aCacheFile, const xercesc::DOMDocument* aDocument );
+    
+private:
+    //! The string written at the start of each cache file.
+    static const char MAGIC[ 8 ];
+    
+    //! The version of the binary layout which must be incremented whenever
+    //! the layout changes.
+    static const unsigned int FORMAT_VERSION;
+    
+    //! The type used for the characters of all strings in the cache which is the
+    //! same as XMLCh so that they may be handed to Xerces directly.
+    typedef std::basic_string<XMLCh> CacheString;
+    
+    static unsigned long long hashFile( const std::string& aFile );
+    
+    static void writeNode( const xercesc::DOMNode* aNode, std::map<CacheString, unsigned int>& aNames,
+                           std::vector<char>& aBuffer );
+    
+    static bool readNode( const char*& aCurr, const char* aEnd, const std::vector<CacheString>& aNames,
+                          xercesc::DOMDocument* aDocument, xercesc::DOMNode* aParent );
+};
+
+#endif // _XML_BINARY_CACHE_H_
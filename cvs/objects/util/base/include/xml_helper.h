@@ -103,6 +103,8 @@
 #include "util/base/include/iparsable.h"
 #include "util/base/include/time_vector.h"
 #include "util/base/include/value.h"
+#include "util/base/include/xml_binary_cache.h"
+#include "util/base/include/xml_stream_parser.h"
 
 /*!
  * \ingroup Objects
@@ -1036,6 +1038,24 @@ void XMLWriteVector( const objects::PeriodVector<T>& aOutputVector,
 
 template <class T>
 bool XMLHelper<T>::parseXML( const std::string& aXMLFile, IParsable* aModelElement ) {
+    // Check if we have already validated this exact file and can rebuild the DOM
+    // from the binary cache instead.
+    const std::string cacheFile = XMLBinaryCache::isEnabled() ?
+        XMLBinaryCache::getCacheFileName( aXMLFile ) : "";
+    if( !cacheFile.empty() ) {
+        xercesc::DOMDocument* cachedDocument = XMLBinaryCache::read( cacheFile );
+        if( cachedDocument ) {
+            bool success = aModelElement->XMLParse( cachedDocument->getDocumentElement() );
+            cachedDocument->release();
+            return success;
+        }
+    }
+    else if( XMLStreamParser::isEnabled() ) {
+        // Ensure Xerces has been initialized before streaming.
+        XMLHelper<T>::getParser();
+        return XMLStreamParser::parse( aXMLFile, aModelElement );
+    }
+
     // Track the number of active parses to avoid destroying a document that causes other
     // documents to be parsed before its own parsing was complete.
     static unsigned int numParses = 0;
@@ -1060,6 +1080,12 @@ bool XMLHelper<T>::parseXML( const std::string& aXMLFile, IParsable* aModelEleme
         return false;
     }
 
+    // Save the validated document to the cache now as parsing it may cause other
+    // documents to be parsed with the same parser.
+    if( !cacheFile.empty() ) {
+        XMLBinaryCache::write( cacheFile, parser->getDocument() );
+    }
+
     bool success = aModelElement->XMLParse( parser->getDocument()->getDocumentElement() );
     // Cleanup parser memory if there are no active parses.
     if( --numParses == 0 ){
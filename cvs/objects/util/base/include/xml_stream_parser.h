@@ -0,0 +1,82 @@
+#ifndef _XML_STREAM_PARSER_H_
+#define _XML_STREAM_PARSER_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file xml_stream_parser.h
+ * \ingroup Objects
+ * \brief The XMLStreamParser class header file.
+ */
+
+#include <string>
+
+class IParsable;
+
+/*!
+ * \ingroup Objects
+ * \brief Parses an XML file with a streaming SAX parser handing it to the model
+ *        a piece at a time.
+ * \details The full DOM tree of the large input files dominates the memory used
+ *          while setting up a scenario.  When stream-xml-input is set in the
+ *          configuration this parser is used instead which only keeps in memory
+ *          a single child of a split container along with its ancestors.  Each
+ *          time such a child is complete the ancestors and that one child are
+ *          passed to the same XMLParse method the full document would have been
+ *          and then released.  Every other element is passed to XMLParse once
+ *          and complete.
+ *
+ *          Only the root and the containers which merge their children by name,
+ *          the world and the regions, are split which is safe for the same
+ *          reason several scenario components may add to the same region.
+ *          Containers are only split down
+ *          to depth xml-stream-depth (the root being depth zero), by default 3
+ *          which parses each child of a region on its own.  Whitespace between
+ *          the children of a split container is dropped.
+ *
+ *          Note the xml-binary-cache takes precedence when it is also set since
+ *          it needs the full document.
+ */
+class XMLStreamParser {
+public:
+    static bool isEnabled();
+    
+    static bool parse( const std::string& aXMLFile, IParsable* aModelElement );
+};
+
+#endif // _XML_STREAM_PARSER_H_
@@ -0,0 +1,151 @@
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+/*!
+ * \file child_process_pool.cpp
+ * \ingroup Objects
+ * \brief Source file for the runInChildProcesses function.
+ */
+
+#include "util/base/include/definitions.h"
+
+#if !defined(_WIN32)
+#include <map>
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "util/base/include/child_process_pool.h"
+#include "util/logger/include/ilogger.h"
+#include "util/logger/include/logger_factory.h"
+
+using namespace std;
+
+/*!
+ * \brief Run a number of independent tasks, each in its own forked child
+ *        process, with up to the given number running at once.
+ * \details A new child is started whenever one finishes until all tasks have
+ *          been started.  Each child calls the task with its index and exits,
+ *          never returning to the caller, so any results other than whether
+ *          the task succeeded must be passed back through files or shared
+ *          memory set up before this is called.  Children share the open files
+ *          of the caller, including the logs, so concurrent messages will be
+ *          interleaved.
+ *
+ *          The calling process must not have started any threads other than
+ *          the asynchronous log writers, which are stopped while children are
+ *          running, as they would not exist in the children.
+ * \param aNumTasks The number of tasks to run.
+ * \param aMaxRunning The maximum number of children to run at once.
+ * \param aTask The task to run in the child, returning whether it succeeded.
+ * \return Whether each task succeeded.  A task which could not be started,
+ *         exited abnormally, or threw an exception has failed.
+ */
+vector<bool> objects::runInChildProcesses( const unsigned int aNumTasks,
+                                           const unsigned int aMaxRunning,
+                                           const function<bool( const unsigned int )>& aTask )
+{
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    vector<bool> succeeded( aNumTasks, false );
+
+    // Writer threads do not survive a fork so log synchronously in this
+    // process while children are running.
+    LoggerFactory::stopWriters();
+
+    map<pid_t, unsigned int> running;
+    unsigned int next = 0;
+    while( next < aNumTasks || !running.empty() ){
+        while( running.size() < max( aMaxRunning, 1u ) && next < aNumTasks ){
+            cout.flush();
+            cerr.flush();
+            const pid_t pid = fork();
+            if( pid == 0 ){
+                // Child process, never returns to the caller.
+                int status = EXIT_FAILURE;
+                LoggerFactory::startWriters();
+                try {
+                    if( aTask( next ) ){
+                        status = EXIT_SUCCESS;
+                    }
+                }
+                catch( ... ){
+                    mainLog.setLevel( ILogger::ERROR );
+                    mainLog << "Unhandled exception in child process " << next << "." << endl;
+                }
+                LoggerFactory::stopWriters();
+                cout.flush();
+                cerr.flush();
+                _exit( status );
+            }
+            else if( pid < 0 ){
+                mainLog.setLevel( ILogger::WARNING );
+                mainLog << "Could not start child process " << next;
+                if( running.empty() ){
+                    // Nothing will finish to free up resources so give up on
+                    // this task.
+                    mainLog << ", skipping it." << endl;
+                    ++next;
+                }
+                else {
+                    mainLog << ", waiting for a running process to finish." << endl;
+                }
+                break;
+            }
+            running[ pid ] = next++;
+        }
+
+        if( running.empty() ){
+            continue;
+        }
+        int status;
+        const pid_t finished = waitpid( -1, &status, 0 );
+        if( finished < 0 ){
+            if( errno == EINTR ){
+                continue;
+            }
+            // No children are left to wait on.
+            break;
+        }
+        map<pid_t, unsigned int>::iterator finishedIter = running.find( finished );
+        if( finishedIter != running.end() ){
+            succeeded[ finishedIter->second ] = WIFEXITED( status ) && WEXITSTATUS( status ) == EXIT_SUCCESS;
+            running.erase( finishedIter );
+        }
+    }
+
+    LoggerFactory::startWriters();
+    return succeeded;
+}
+#endif
@@ -39,7 +39,23 @@
  */
 
 #include <cstring>
+#include <cstdio>
 #include <fstream>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <type_traits>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if USE_ZLIB
+#include <zlib.h>
+#endif
 
 #include "util/base/include/manage_state_variables.hpp"
 #include "util/base/include/value.h"
@@ -48,9 +64,13 @@
 #include "util/base/include/configuration.h"
 #include "util/base/include/gcam_fusion.hpp"
 #include "util/base/include/gcam_data_containers.h"
+#include "containers/include/world.h"
+#include "containers/include/iactivity.h"
+#include "util/base/include/iyeared.h"
+#include "util/base/include/timer.h"
+#include "util/base/include/trace_recorder.h"
 
 #if GCAM_PARALLEL_ENABLED
-#include <tbb/concurrent_queue.h>
 #include <tbb/task_scheduler_init.h>
 #endif
 
@@ -61,86 +81,196 @@ extern Scenario* scenario;
 // Note we must static initialize static class member variables in a cpp file and
 // since Value is header only and these particular fields are just as related to
 // ManageStateVariables it seems appropriate to initialize them to NULL here.
-Value::CentralValueType Value::sCentralValue( (double*)0 );
+#if !GCAM_PARALLEL_ENABLED
+Value::CentralValueType Value::sCentralValue( 0 );
+#else
+thread_local Value::CentralValueType Value::sCentralValue( 0 );
+#endif
 double* Value::sBaseCentralValue( 0 );
+size_t Value::sDirtyFlagOffset( 0 );
 
 #if GCAM_PARALLEL_ENABLED
-#define NUM_STATES tbb::task_scheduler_init::default_num_threads()+1
+// Size the "scratch" states (and the thread pool) by the concurrency the calling
+// thread is allowed so that limiting it with a task_scheduler_init is honored.
+#define NUM_STATES tbb::this_task_arena::max_concurrency()+2
 #else
 #define NUM_STATES 2
 #endif
 
-#if GCAM_PARALLEL_ENABLED
-/*!
- * \brief A helper functor to assign a state slot in ManageStateVariables::mStateData
- *        to each worker thread in ManageStateVariables::mThreadPool.  This functor
- *        will get called the first time a new thread accesses the thread local
- *        storage Value::sCentralValue that provides access to mStateData by thread
- *        from with in the Value class.
- */
-struct AssignThreadStateFun {
-    //! A reference to ManageStateVariables::mStateData.
-    double** mArr;
-    
-    //! The maximum number of states that have been allocated in mStateData.
-    const int mMaxStates;
-    
-    //! A thread safe queue that will have as values each index into mStateData
-    //! and as each new thread consumes it's next value implies that thread gets
-    //! assigned that state slot.
-    tbb::concurrent_queue<int> mThreadStateIndex;
-    
-    //! Constructor
-    AssignThreadStateFun( double** aArr, const int aMaxStates ):mArr( aArr ), mMaxStates( aMaxStates ) {
-        // initialize the state index slots starting from 1 as 0 is always the
-        // "base" state.
-        for( int i = 1; i < mMaxStates; ++i ) {
-            mThreadStateIndex.push( i );
+namespace {
+    /*!
+     * \brief Add the given bytes to a 64 bit FNV-1a hash.
+     * \details A fixed hash function is used rather than std::hash so that
+     *          keys written to restart files are the same on every platform.
+     */
+    uint64_t hashBytes( uint64_t aHash, const void* aBytes, const size_t aLength ) {
+        const unsigned char* bytes = static_cast<const unsigned char*>( aBytes );
+        for( size_t i = 0; i < aLength; ++i ) {
+            aHash ^= bytes[ i ];
+            aHash *= 1099511628211ULL;
         }
+        return aHash;
+    }
+    
+    //! The initial value of a FNV-1a hash.
+    const uint64_t HASH_OFFSET_BASIS = 14695981039346656037ULL;
+    
+    //! Detect containers which can be identified by name.
+    template<typename T, typename = void>
+    struct HasGetName : std::false_type {};
+    template<typename T>
+    struct HasGetName<T, decltype( (void)std::declval<const T&>().getName() )> : std::true_type {};
+    
+    template<typename T>
+    typename std::enable_if<HasGetName<T>::value, string>::type getContainerName( const T* aContainer ) {
+        return aContainer->getName();
     }
     
+    template<typename T>
+    typename std::enable_if<!HasGetName<T>::value, string>::type getContainerName( const T* aContainer ) {
+        return string();
+    }
+    
+    template<typename T>
+    typename std::enable_if<std::is_base_of<IYeared, T>::value, int>::type getContainerYear( const T* aContainer ) {
+        return aContainer->getYear();
+    }
+    
+    template<typename T>
+    typename std::enable_if<!std::is_base_of<IYeared, T>::value, int>::type getContainerYear( const T* aContainer ) {
+        return 0;
+    }
+    
+    //! Identifies a versioned restart file.  Restart files written before
+    //! versioning instead begin directly with the number of states.
+    const char RESTART_MAGIC[ 8 ] = { 'G', 'C', 'A', 'M', 'R', 'S', 'T', '\0' };
+    
+    //! The current restart file version.
+    const uint32_t RESTART_VERSION = 2;
+    
+    //! Restart file flag indicating the state data is compressed with zlib.
+    const uint32_t RESTART_COMPRESSED = 1;
+    
     /*!
-     * \brief The functor that gets called when a new thread accesses the thread local
-     *        storage Value::sCentralValue for the first time.  It will assign a unique
-     *        slot into ManageStateVariables::sCentralValue for this thread to use
-     *        for the duration of it's calculations.
-     * \return The unique slot of state that this thread can be guaranteed to use
-     *         free from interference from any other thread.
+     * \brief The header at the start of a versioned restart file.
+     * \details The header is followed by mNumStates state keys and then
+     *          mDataSize bytes of state data, either mNumStates doubles or
+     *          those doubles compressed.  Everything is written in the byte
+     *          order of the machine which wrote the file.  The header size is a
+     *          multiple of eight so that the keys and uncompressed data can be
+     *          used directly from a memory mapped file.
      */
-    double* operator()() {
-        int nextState;
-        bool gotState = mThreadStateIndex.try_pop( nextState );
-        if( !gotState ) {
-            ILogger& mainLog = ILogger::getLogger( "main_log" );
-            mainLog.setLevel( ILogger::SEVERE );
-            mainLog << "Failed to get an unused state to assign to a worker thread." << endl;
-            abort();
+    struct RestartHeader {
+        char mMagic[ 8 ];
+        uint32_t mVersion;
+        uint32_t mFlags;
+        uint64_t mNumStates;
+        uint64_t mFingerprint;
+        uint64_t mDataSize;
+    };
+    
+    /*!
+     * \brief The read only contents of a restart file.
+     * \details The file is memory mapped where possible to avoid copying it
+     *          and otherwise read in full.
+     */
+    class RestartFileContents {
+    public:
+        explicit RestartFileContents( const string& aFileName ):mData( 0 ), mSize( 0 ), mIsMapped( false ) {
+#if !defined(_WIN32)
+            const int fd = open( aFileName.c_str(), O_RDONLY );
+            if( fd >= 0 ) {
+                struct stat fileStat;
+                if( fstat( fd, &fileStat ) == 0 && fileStat.st_size > 0 ) {
+                    void* mapped = mmap( 0, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+                    if( mapped != MAP_FAILED ) {
+                        mData = static_cast<const char*>( mapped );
+                        mSize = fileStat.st_size;
+                        mIsMapped = true;
+                    }
+                }
+                close( fd );
+            }
+            if( mIsMapped ) {
+                return;
+            }
+#endif
+            ifstream file( aFileName.c_str(), ios_base::in | ios_base::binary );
+            if( file.is_open() ) {
+                // Note the buffer is of doubles to keep the data aligned.
+                file.seekg( 0, ios_base::end );
+                mSize = file.tellg();
+                file.seekg( 0, ios_base::beg );
+                mBuffer.resize( ( mSize + sizeof( double ) - 1 ) / sizeof( double ) );
+                file.read( reinterpret_cast<char*>( mBuffer.data() ), mSize );
+                mData = reinterpret_cast<const char*>( mBuffer.data() );
+                mSize = file.gcount();
+            }
         }
         
-        return mArr[ nextState ];
-    }
-};
+        ~RestartFileContents() {
+#if !defined(_WIN32)
+            if( mIsMapped ) {
+                munmap( const_cast<char*>( mData ), mSize );
+            }
 #endif
+        }
+        
+        bool isOpen() const {
+            return mData != 0;
+        }
+        
+        const char* getData() const {
+            return mData;
+        }
+        
+        size_t getSize() const {
+            return mSize;
+        }
+    private:
+        const char* mData;
+        size_t mSize;
+        bool mIsMapped;
+        vector<double> mBuffer;
+        
+        // Not implemented.
+        RestartFileContents( const RestartFileContents& );
+        RestartFileContents& operator=( const RestartFileContents& );
+    };
+}
+
 
 /*!
- * \brief Constructor which calls collectState() to begin the process to find all
- *        state data during the given model period and allocate memory to hold
- *        it in a "base" and "scratch" spaces.
- * \param aPeriod The model period to manage state in.
+ * \brief Constructor which allocates the state slots, the memory for the state
+ *        itself is not allocated until the first call to setPeriod.
  */
-ManageStateVariables::ManageStateVariables( const int aPeriod ):
+ManageStateVariables::ManageStateVariables():
 #if !GCAM_PARALLEL_ENABLED
 mStateData( new double*[ NUM_STATES ] ),
 #else
-mThreadPool(),
+mThreadPool( tbb::this_task_arena::max_concurrency() ),
 mStateData( new double*[ NUM_STATES ] ),
 #endif
-mPeriodToCollect( aPeriod ),
-mYearToCollect( scenario->getModeltime()->getper_to_yr( aPeriod ) ),
-mCCStartYear( mYearToCollect - scenario->getModeltime()->gettimestep( aPeriod ) + 1 ),
-mNumCollected( 0 )
+mStateCapacity( 0 ),
+mPeriodToCollect( -1 ),
+mYearToCollect( 0 ),
+mCCStartYear( 0 ),
+mNumCollected( 0 ),
+mNumPages( 0 ),
+mBaseVersion( 1 ),
+mStateVersion( NUM_STATES, 0 ),
+mShouldReuseState( Configuration::getInstance()->getBool( "reuse-collected-state", true, false ) )
 {
-    collectState();
+    for( size_t stateInd = 0; stateInd < mStateVersion.size(); ++stateInd ) {
+        mStateData[ stateInd ] = 0;
+    }
+#if GCAM_PARALLEL_ENABLED
+    // Slot 0 is always the "base" state and slot 1 is reserved for the thread
+    // which calls setPartialDeriv, the rest are available to StateHandles.
+    for( int stateInd = 2; stateInd < mStateVersion.size(); ++stateInd ) {
+        mFreeStates.push( stateInd );
+    }
+#endif
 }
 
 /*!
@@ -148,29 +278,95 @@ mNumCollected( 0 )
  *        "base" state back into the Value objects before we deallocate that memory.
  */
 ManageStateVariables::~ManageStateVariables() {
-    resetState();
-    for( size_t stateInd = 0; stateInd < NUM_STATES; ++stateInd ) {
+    releasePeriod();
+    for( size_t stateInd = 0; stateInd < mStateVersion.size(); ++stateInd ) {
         delete[] mStateData[ stateInd ];
     }
     delete[] mStateData;
-#if !GCAM_PARALLEL_ENABLED
+}
+
+/*!
+ * \brief Begin managing the state which could be changed during World.calc of the
+ *        given period.
+ * \details The Values are found by collectState() unless they were already found
+ *          the last time this period was calculated.  Any period currently bound is
+ *          released first.
+ * \param aPeriod The model period to manage state in.
+ */
+void ManageStateVariables::setPeriod( const int aPeriod ) {
+    releasePeriod();
+    
+    mPeriodToCollect = aPeriod;
+    mYearToCollect = scenario->getModeltime()->getper_to_yr( aPeriod );
+    mCCStartYear = mYearToCollect - scenario->getModeltime()->gettimestep( aPeriod ) + 1;
+    
+    auto collectedIter = mCollectedState.find( aPeriod );
+    if( collectedIter != mCollectedState.end() ) {
+        mStateValues.swap( (*collectedIter).second.mValues );
+        mStateKeys.swap( (*collectedIter).second.mKeys );
+        mCollectedState.erase( collectedIter );
+        mNumCollected = mStateValues.size();
+        
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::DEBUG );
+        mainLog << "Number of active state values: " << mNumCollected << " (reused)" << endl;
+    }
+    else {
+        collectState();
+    }
+    initState();
+}
+
+/*!
+ * \brief Copy the "base" state back into the Value objects and stop managing the
+ *        current period.
+ * \details The Values which were managed are kept for the next time this period
+ *          is set if reuse-collected-state is enabled.  This does nothing if no
+ *          period is currently bound.
+ */
+void ManageStateVariables::releasePeriod() {
+    if( mPeriodToCollect == -1 ) {
+        return;
+    }
+    
+    resetState();
     Value::sCentralValue = 0;
-#else
-    Value::sCentralValue.clear();
-#endif
     Value::sBaseCentralValue = 0;
+    
+    if( mShouldReuseState ) {
+        CollectedState& collected = mCollectedState[ mPeriodToCollect ];
+        collected.mValues.swap( mStateValues );
+        collected.mKeys.swap( mStateKeys );
+    }
+    mStateValues.clear();
+    mStateKeys.clear();
+    mNumCollected = 0;
+    mPeriodToCollect = -1;
 }
 
 /*!
- * \brief Search for all relevant STATE Values and allocate space for them in the
- *        central state data arrays.  The "base" state will get initialized as the
- *        actual value set in the individual Value objects before being collected.
+ * \brief Forget the Values collected for each period so that they are searched
+ *        for again.
+ * \details This must be called whenever the model objects which contain state are
+ *          added, removed, or reallocated.
+ */
+void ManageStateVariables::clearCollectedState() {
+    mCollectedState.clear();
+}
+
+/*!
+ * \brief Search for all relevant STATE Values for mPeriodToCollect and gather them
+ *        into mStateValues.
  */
 void ManageStateVariables::collectState() {
     // Set up the GCAM Fusion steps as well as the callback struct that will handle
     // the results from the search.
     DoCollect doCollectProc;
     doCollectProc.mParentClass = this;
+    DoCollect::PathStep root;
+    root.mKey = HASH_OFFSET_BASIS;
+    root.mNumValues = 0;
+    doCollectProc.mPath.push_back( root );
     // Note an empty string for the data name indicates match any name.  The first
     // step that does not match any name nor value indicates a "descendant" step
     // allowing for GCAM fusion to search at any depth to find Data of any name
@@ -184,15 +380,60 @@ void ManageStateVariables::collectState() {
     gatherState.startFilter( scenario );
     
     // DoCollect has now gathered all active state into the mStateValues list to
-    // allow faster/easier processing for the remaining tasks at hand.
+    // allow faster/easier processing for the remaining tasks at hand.  The state
+    // has historically been laid out in the reverse of the order it is found in
+    // which restart files without keys depend on.
+    reverse( mStateValues.begin(), mStateValues.end() );
+    reverse( mStateOwners.begin(), mStateOwners.end() );
+    reverse( mStateKeys.begin(), mStateKeys.end() );
     ILogger& mainLog = ILogger::getLogger( "main_log" );
     mainLog.setLevel( ILogger::DEBUG );
     mainLog << "Number of active state values: " << mNumCollected << endl;
-    // Allocate space for each active state value for each state slot.
-    for( size_t stateInd = 0; stateInd < NUM_STATES; ++stateInd ) {
-        mStateData[ stateInd ] = new double[ mNumCollected ];
+    
+    // Optionally lay out the state such that the Values calculated by each activity
+    // are contiguous in memory.  Note restart files from runs that made a different
+    // choice must be matched by key which is slower.
+    if( Configuration::getInstance()->getBool( "activity-ordered-state", false, false ) ) {
+        orderStateByActivity();
+    }
+    mStateOwners.clear();
+    const int restartPeriod = Configuration::getInstance()->getInt( "restart-period", -1, false );
+    const bool shouldLoadRestart = restartPeriod != -1 && mPeriodToCollect < restartPeriod;
+    if( !shouldLoadRestart && !Configuration::getInstance()->shouldWriteFile( "restart", false, false ) ) {
+        mStateKeys.clear();
     }
     
+    // clean up GCAMFusion related memory
+    for( auto filterStep : collectStateSteps ) {
+        delete filterStep;
+    }
+}
+
+/*!
+ * \brief Set up the central state data arrays for the Values in mStateValues.  The
+ *        "base" state will get initialized as the actual value set in the individual
+ *        Value objects.
+ */
+void ManageStateVariables::initState() {
+    // Make sure there is space for each active state value for each state slot
+    // followed by the dirty page flags for that slot.
+    mNumPages = ( mNumCollected >> Value::STATE_PAGE_SHIFT ) + 1;
+    const size_t flagSize = ( mNumPages + sizeof( double ) - 1 ) / sizeof( double );
+    if( mNumCollected + flagSize > mStateCapacity ) {
+        mStateCapacity = mNumCollected + flagSize;
+        for( size_t stateInd = 0; stateInd < mStateVersion.size(); ++stateInd ) {
+            delete[] mStateData[ stateInd ];
+            mStateData[ stateInd ] = new double[ mStateCapacity ];
+        }
+    }
+    for( size_t stateInd = 0; stateInd < mStateVersion.size(); ++stateInd ) {
+        memset( mStateData[ stateInd ] + mNumCollected, 0, flagSize * sizeof( double ) );
+    }
+    Value::sDirtyFlagOffset = mNumCollected;
+    // The scratch slots hold state from another period so they must all be fully
+    // copied before they are used.
+    ++mBaseVersion;
+    
     // We can now initialize the static Value references into mStateData for fast
     // access from within each Value object.
     setPartialDeriv( false );
@@ -200,24 +441,68 @@ void ManageStateVariables::collectState() {
 
     // Take another pass through the Value objects and copy the original data from
     // each one into the corresponding "base" state to initialize it.
-    mNumCollected = 0;
-    for( auto currValue : mStateValues ) {
+    for( size_t stateInd = 0; stateInd < mNumCollected; ++stateInd ) {
+        Value* currValue = mStateValues[ stateInd ];
         currValue->mIsStateCopy = true;
-        currValue->mCentralValueIndex = mNumCollected;
-        currValue->sBaseCentralValue[ mNumCollected ] = currValue->mValue;
-        ++mNumCollected;
+        currValue->mCentralValueIndex = stateInd;
+        currValue->sBaseCentralValue[ stateInd ] = currValue->mValue;
     }
     
     // if configured, reset initial state data from a restart file
     const int restartPeriod = Configuration::getInstance()->getInt( "restart-period", -1, false );
-    if(  restartPeriod != -1 && mPeriodToCollect < restartPeriod ) {
+    if( restartPeriod != -1 && mPeriodToCollect < restartPeriod ) {
         loadRestartFile();
     }
+}
+
+/*!
+ * \brief Reorder mStateValues to follow the World's global ordering of activities.
+ * \details The default order is simply the order GCAMFusion happened to find each
+ *          Value which interleaves state from many objects that are calculated at
+ *          different times.  Instead we sort the Values by the position of the first
+ *          activity in World::getGlobalOrdering that owns them so that each activity
+ *          reads and writes a contiguous block of state.  Values which are not owned
+ *          by any activity, such as the markets, are kept at the front in their
+ *          original order.
+ */
+void ManageStateVariables::orderStateByActivity() {
+    map<const void*, size_t> ownerRank;
+    const vector<IActivity*>& globalOrdering = scenario->getWorld()->getGlobalOrdering();
+    for( size_t activityInd = 0; activityInd < globalOrdering.size(); ++activityInd ) {
+        const void* owner = globalOrdering[ activityInd ]->getStateOwner();
+        if( owner ) {
+            // keep the first position only, such as for a sector's price activity
+            ownerRank.insert( make_pair( owner, activityInd + 1 ) );
+        }
+    }
     
-    // clean up GCAMFusion related memory
-    for( auto filterStep : collectStateSteps ) {
-        delete filterStep;
+    typedef pair<size_t, pair<Value*, uint64_t> > RankedValue;
+    vector<RankedValue> rankedValues;
+    rankedValues.reserve( mNumCollected );
+    auto ownerIter = mStateOwners.begin();
+    auto keyIter = mStateKeys.begin();
+    for( auto currValue : mStateValues ) {
+        auto rankIter = ownerRank.find( *ownerIter );
+        rankedValues.push_back( make_pair( rankIter != ownerRank.end() ? (*rankIter).second : 0,
+                                           make_pair( currValue, *keyIter ) ) );
+        ++ownerIter;
+        ++keyIter;
+    }
+    stable_sort( rankedValues.begin(), rankedValues.end(),
+                 []( const RankedValue& aLHS, const RankedValue& aRHS ) {
+                     return aLHS.first < aRHS.first;
+                 } );
+    
+    mStateValues.clear();
+    mStateKeys.clear();
+    for( auto rankedValue : rankedValues ) {
+        mStateValues.push_back( rankedValue.second.first );
+        mStateKeys.push_back( rankedValue.second.second );
     }
+    
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    mainLog.setLevel( ILogger::DEBUG );
+    mainLog << "Ordered state values by " << ownerRank.size() << " activity owners." << endl;
 }
 
 /*!
@@ -250,39 +535,132 @@ void ManageStateVariables::resetState() {
  * \details This method is typically called before starting a partial derivative
  *          calculation which will make changes in the "scratch" space.  Note when
  *          GCAM_PARALLEL_ENABLED the appropriate "scratch" space to reset is identified
- *          as the one assigned to the calling thread via the thread local Value::sCentralValue.
+ *          as the one bound to the calling thread via setPartialDeriv or a StateHandle.
+ *          Only the first copy into a slot in a round of partial derivatives copies
+ *          all of the state, after that only the pages the previous partial derivative
+ *          wrote to are restored as everything else must still match the "base" state.
  */
 void ManageStateVariables::copyState() {
+    Timer& copyTimer = TimerRegistry::getInstance().getTimer( TimerRegistry::COPY_STATE );
+    copyTimer.start();
+    TraceScope copyScope( "state", "copyState" );
 #if !GCAM_PARALLEL_ENABLED
-    memcpy( mStateData[1], mStateData[0], (sizeof( double)) * mNumCollected );
+    const int slot = 1;
 #else
-    memcpy( Value::sCentralValue.local(), mStateData[0], (sizeof( double)) * mNumCollected );
+    int slot = 1;
+    while( slot < mStateVersion.size() && mStateData[ slot ] != Value::sCentralValue ) {
+        ++slot;
+    }
+    if( slot == mStateVersion.size() ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::SEVERE );
+        mainLog << "Attempting to copy state on a thread with no scratch state bound." << endl;
+        abort();
+    }
 #endif
+    double* scratchState = mStateData[ slot ];
+    unsigned char* dirtyPages = reinterpret_cast<unsigned char*>( scratchState + mNumCollected );
+    if( mStateVersion[ slot ] != mBaseVersion ) {
+        memcpy( scratchState, mStateData[0], (sizeof( double)) * mNumCollected );
+        memset( dirtyPages, 0, mNumPages );
+        mStateVersion[ slot ] = mBaseVersion;
+    }
+    else {
+        const size_t pageSize = size_t( 1 ) << Value::STATE_PAGE_SHIFT;
+        for( size_t page = 0; page < mNumPages; ++page ) {
+            if( dirtyPages[ page ] ) {
+                const size_t start = page * pageSize;
+                memcpy( scratchState + start, mStateData[0] + start,
+                        (sizeof( double)) * min( pageSize, mNumCollected - start ) );
+                dirtyPages[ page ] = 0;
+            }
+        }
+    }
+    copyTimer.stop();
 }
 
 /*!
  * \brief Set up the Value classes static references into mStateData to appropriately
  *        point to the "base" state if aIsPartialDeriv is false or a "scratch"
  *        space if aIsPartialDeriv is true.
+ *          When GCAM_PARALLEL_ENABLED this only affects the calling thread which
+ *          gets the dedicated "scratch" slot 1, tasks that calculate partial
+ *          derivatives concurrently must each bind their own with a StateHandle.
  * \param aIsPartialDeriv The flag indicating if we are about to calculate a partial
  *                        derivative or not as set from the solution algorithm.
  */
 void ManageStateVariables::setPartialDeriv( const bool aIsPartialDeriv ) {
+    if( aIsPartialDeriv ) {
+        // the "base" state may have changed since the last round of partial
+        // derivatives so each scratch slot must do a full copy next time
+        ++mBaseVersion;
+    }
 #if !GCAM_PARALLEL_ENABLED
     Value::sCentralValue = mStateData[ aIsPartialDeriv ? 1 : 0 ];
 #else
-    if( !aIsPartialDeriv ) {
-        // Initialize the thread local storage to always access the "base" state.
-        Value::sCentralValue = Value::CentralValueType( mStateData[0] );
+    // A null binding indicates the "base" state.
+    Value::sCentralValue = aIsPartialDeriv ? mStateData[1] : 0;
+#endif
+}
+
+/*!
+ * \brief Acquire a "scratch" state slot and bind it to the calling thread.
+ * \param aStateManager The state manager to get the slot from or null to
+ *                      leave the current binding alone.
+ */
+ManageStateVariables::StateHandle::StateHandle( ManageStateVariables* aStateManager ):
+mStateManager( aStateManager ),
+mSlot( 1 ),
+mPrevState( Value::sCentralValue )
+{
+    if( !mStateManager ) {
+        return;
     }
-    else {
-        // Use the AssignThreadStateFun helper functor to uniquely assign a state
-        // slot to each worker thread.
-        Value::sCentralValue = Value::CentralValueType( AssignThreadStateFun( mStateData, NUM_STATES ) );
+#if GCAM_PARALLEL_ENABLED
+    if( !mStateManager->mFreeStates.try_pop( mSlot ) ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::SEVERE );
+        mainLog << "Failed to get an unused state to assign to a worker thread." << endl;
+        abort();
     }
 #endif
+    Value::sCentralValue = mStateManager->mStateData[ mSlot ];
 }
 
+/*!
+ * \brief Restore the previous binding and return the slot for another task to use.
+ */
+ManageStateVariables::StateHandle::~StateHandle() {
+    if( !mStateManager ) {
+        return;
+    }
+    Value::sCentralValue = mPrevState;
+#if GCAM_PARALLEL_ENABLED
+    mStateManager->mFreeStates.push( mSlot );
+#endif
+}
+
+#if GCAM_PARALLEL_ENABLED
+/*!
+ * \brief Get the state the calling thread is currently bound to.
+ * \details This is used to carry the binding from a thread that starts a flow
+ *          graph calculation into the flow graph nodes which may run on other
+ *          threads.
+ * \return The bound state or null if the thread is using the "base" state.
+ */
+double* ManageStateVariables::getThreadState() {
+    return Value::sCentralValue;
+}
+
+/*!
+ * \brief Bind the calling thread to the given state.
+ * \param aState The state as returned from getThreadState.
+ */
+void ManageStateVariables::setThreadState( double* aState ) {
+    Value::sCentralValue = aState;
+}
+#endif
+
 /*!
  * \brief Generate the appropriate restart file name to use.
  * \details This method will append the model period this instance was created
@@ -300,87 +678,250 @@ string ManageStateVariables::getRestartFileName() const {
 }
 
 /*!
- * \brief Load a restart file from disk directly into the "base" state.
- * \warning Very little error checking is done to ensure the state read in was generated
- *          from the exact same scenario.  All we can do in terms of error checking is
- *          check that the size of the data coming in is exactly the same size as mNumCollected.
+ * \brief Load a restart file from disk into the "base" state.
+ * \details The file is memory mapped where possible.  If the restart was
+ *          written from state collected identically to this run, which is
+ *          verified by comparing a fingerprint of the state keys, the data is
+ *          copied directly.  Otherwise each state is matched to the restart by
+ *          key, see mapRestartState.  Restart files written before versioning,
+ *          which have no keys, are still read so long as the number of states
+ *          is exactly the same as mNumCollected.
  * \sa ManageStateVariables::getRestartFileName
  * \sa ManageStateVariables::saveRestartFile
  */
 void ManageStateVariables::loadRestartFile() {
-    // read from the appropriate file which is in binary format
     const string restartFileName = getRestartFileName();
-    fstream restartFile( restartFileName.c_str(), ios_base::in | ios_base::binary );
+    RestartFileContents restartFile( restartFileName );
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
     
-    if( !restartFile.is_open() ) {
-        ILogger& mainLog = ILogger::getLogger( "main_log" );
+    if( !restartFile.isOpen() ) {
         mainLog.setLevel( ILogger::SEVERE );
         mainLog << "Could not open restart file: " << restartFileName << " for read." << endl;
         abort();
     }
     
-    size_t numStatesInRestart;
-    restartFile.read( reinterpret_cast<char*>( &numStatesInRestart ), sizeof( size_t ) );
-    if( numStatesInRestart != mNumCollected ) {
-        ILogger& mainLog = ILogger::getLogger( "main_log" );
+    const char* data = restartFile.getData();
+    const size_t fileSize = restartFile.getSize();
+    if( fileSize < sizeof( RestartHeader ) || memcmp( data, RESTART_MAGIC, sizeof( RESTART_MAGIC ) ) != 0 ) {
+        // An unversioned restart file which is just the number of states and
+        // then the state data.
+        size_t numStatesInRestart = 0;
+        if( fileSize >= sizeof( size_t ) ) {
+            memcpy( &numStatesInRestart, data, sizeof( size_t ) );
+        }
+        if( numStatesInRestart != mNumCollected ) {
+            mainLog.setLevel( ILogger::SEVERE );
+            mainLog << "Restart file: " << restartFileName << " differs in size, read: " << numStatesInRestart
+                    << ", expected: " << mNumCollected << endl;
+            abort();
+        }
+        const size_t numStatesRead = ( fileSize - sizeof( size_t ) ) / sizeof( double );
+        if( numStatesRead < numStatesInRestart ) {
+            mainLog.setLevel( ILogger::SEVERE );
+            mainLog << "Restart file: " << restartFileName << " has fewer states than expected, read: " << numStatesRead
+                    << ", expected: " << numStatesInRestart << endl;
+            abort();
+        }
+        if( fileSize != sizeof( size_t ) + sizeof( double ) * numStatesInRestart ) {
+            mainLog.setLevel( ILogger::SEVERE );
+            mainLog << "Restart file: " << restartFileName << " has more states than expected: " << numStatesInRestart << endl;
+            abort();
+        }
+        memcpy( mStateData[0], data + sizeof( size_t ), sizeof( double ) * numStatesInRestart );
+        return;
+    }
+    
+    RestartHeader header;
+    memcpy( &header, data, sizeof( RestartHeader ) );
+    if( header.mVersion != RESTART_VERSION ) {
         mainLog.setLevel( ILogger::SEVERE );
-        mainLog << "Restart file: " << restartFileName << " differs in size, read: " << numStatesInRestart
-                << ", expected: " << mNumCollected << endl;
+        mainLog << "Restart file: " << restartFileName << " has unsupported version " << header.mVersion
+                << ", expected: " << RESTART_VERSION << endl;
         abort();
     }
+    const size_t keysSize = sizeof( uint64_t ) * header.mNumStates;
+    if( fileSize != sizeof( RestartHeader ) + keysSize + header.mDataSize ) {
+        mainLog.setLevel( ILogger::SEVERE );
+        mainLog << "Restart file: " << restartFileName << " is truncated or corrupt, size: " << fileSize
+                << ", expected: " << sizeof( RestartHeader ) + keysSize + header.mDataSize << endl;
+        abort();
+    }
+    const uint64_t* restartKeys = reinterpret_cast<const uint64_t*>( data + sizeof( RestartHeader ) );
+    const double* restartState = reinterpret_cast<const double*>( data + sizeof( RestartHeader ) + keysSize );
     
-    // read the binary data directly into the "base" state
-    restartFile.read( reinterpret_cast<char*>( mStateData[0] ), sizeof( double ) * numStatesInRestart );
-    if( !restartFile ) {
-        ILogger& mainLog = ILogger::getLogger( "main_log" );
+    vector<double> uncompressedState;
+    if( header.mFlags & RESTART_COMPRESSED ) {
+#if USE_ZLIB
+        uncompressedState.resize( header.mNumStates );
+        uLongf uncompressedSize = sizeof( double ) * header.mNumStates;
+        if( uncompress( reinterpret_cast<Bytef*>( uncompressedState.data() ), &uncompressedSize,
+                        reinterpret_cast<const Bytef*>( restartState ), header.mDataSize ) != Z_OK
+            || uncompressedSize != sizeof( double ) * header.mNumStates )
+        {
+            mainLog.setLevel( ILogger::SEVERE );
+            mainLog << "Restart file: " << restartFileName << " could not be decompressed." << endl;
+            abort();
+        }
+        restartState = uncompressedState.data();
+#else
         mainLog.setLevel( ILogger::SEVERE );
-        mainLog << "Restart file: " << restartFileName << " has fewer states than expected, read: " << static_cast<size_t>( (restartFile.gcount() - sizeof(size_t)) / sizeof(double))
-                << ", expected: " << numStatesInRestart << endl;
+        mainLog << "Restart file: " << restartFileName << " is compressed which requires building with USE_ZLIB." << endl;
         abort();
+#endif
     }
-    if( restartFile.peek() != EOF ) {
-        ILogger& mainLog = ILogger::getLogger( "main_log" );
+    else if( header.mDataSize != sizeof( double ) * header.mNumStates ) {
         mainLog.setLevel( ILogger::SEVERE );
-        mainLog << "Restart file: " << restartFileName << " has more states than expected: " << numStatesInRestart << endl;
+        mainLog << "Restart file: " << restartFileName << " has " << header.mDataSize / sizeof( double )
+                << " states for " << header.mNumStates << " keys." << endl;
         abort();
     }
+    
+    const vector<uint64_t>& stateKeys = getStateKeys();
+    if( header.mNumStates == mNumCollected &&
+        header.mFingerprint == hashBytes( HASH_OFFSET_BASIS, stateKeys.data(), sizeof( uint64_t ) * stateKeys.size() ) )
+    {
+        // read the state directly into the "base" state
+        memcpy( mStateData[0], restartState, sizeof( double ) * mNumCollected );
+    }
+    else {
+        mapRestartState( restartFileName, restartKeys, restartState, header.mNumStates );
+    }
+}
 
-    restartFile.close();
+/*!
+ * \brief Copy state from a restart file which was not collected identically to
+ *        this run by matching the state keys.
+ * \details This happens when the restart was written with a different
+ *          activity-ordered-state setting, in which case every state will still
+ *          be matched, or when the inputs have changed.  In the latter case
+ *          states which are not found keep the value they were read in with,
+ *          however this is only allowed if the boolean configuration value
+ *          restart-partial-match is set as the model may then take longer to
+ *          solve or find a different solution.
+ * \param aRestartFileName The restart file name for reporting.
+ * \param aRestartKeys The state keys in the restart file.
+ * \param aRestartState The state data in the restart file.
+ * \param aNumRestartStates The number of states in the restart file.
+ */
+void ManageStateVariables::mapRestartState( const string& aRestartFileName,
+                                            const uint64_t* aRestartKeys,
+                                            const double* aRestartState,
+                                            const size_t aNumRestartStates )
+{
+    unordered_map<uint64_t, size_t> restartIndex( aNumRestartStates );
+    for( size_t i = 0; i < aNumRestartStates; ++i ) {
+        restartIndex.insert( make_pair( aRestartKeys[ i ], i ) );
+    }
+    
+    // Map into a copy so that nothing is changed if the match is rejected.
+    vector<double> mappedState( mStateData[0], mStateData[0] + mNumCollected );
+    size_t numMatched = 0;
+    size_t stateInd = 0;
+    for( auto currKey : mStateKeys ) {
+        auto restartIter = restartIndex.find( currKey );
+        if( restartIter != restartIndex.end() ) {
+            mappedState[ stateInd ] = aRestartState[ (*restartIter).second ];
+            ++numMatched;
+        }
+        ++stateInd;
+    }
+    
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    if( numMatched != mNumCollected || aNumRestartStates != mNumCollected ) {
+        if( !Configuration::getInstance()->getBool( "restart-partial-match", false, false ) ) {
+            mainLog.setLevel( ILogger::SEVERE );
+            mainLog << "Restart file: " << aRestartFileName << " does not match, found " << numMatched
+                    << " of " << mNumCollected << " states in " << aNumRestartStates << " restart states."
+                    << " Set restart-partial-match to use it anyway." << endl;
+            abort();
+        }
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "Restart file: " << aRestartFileName << " partially matched, found " << numMatched
+                << " of " << mNumCollected << " states, " << aNumRestartStates - numMatched
+                << " restart states were not used." << endl;
+    }
+    else {
+        mainLog.setLevel( ILogger::DEBUG );
+        mainLog << "Restart file: " << aRestartFileName << " matched by key." << endl;
+    }
+    copy( mappedState.begin(), mappedState.end(), mStateData[0] );
 }
 
 /*!
- * \brief Dump the contents of the "base" state array into a binary restart file.
- * \details The first value written is mNumCollected (size written: size_t) to help with do some error checking
- *          when we try to read it back in.  Then we just write the entire content of mStateData[0]
- *          (size written: double * mNumCollected).
+ * \brief Save the "base" state to a restart file.
+ * \details The file is written to a temporary name and then renamed so that a
+ *          run which reads it never sees a partially written file.  If the
+ *          boolean configuration value restart-compress is set and the model
+ *          was built with USE_ZLIB the state data is compressed.
  * \sa ManageStateVariables::getRestartFileName
+ * \sa ManageStateVariables::loadRestartFile
  */
 void ManageStateVariables::saveRestartFile() {
     const string restartFileName = getRestartFileName();
+    const string tempFileName = restartFileName + ".tmp";
     ILogger& mainLog = ILogger::getLogger( "main_log" );
     mainLog.setLevel( ILogger::DEBUG );
     mainLog << "Writing restart file: " << restartFileName << "... ";
-    fstream restartFile( restartFileName.c_str(), ios_base::out | ios_base::trunc | ios_base::binary );
+    fstream restartFile( tempFileName.c_str(), ios_base::out | ios_base::trunc | ios_base::binary );
     
     if( !restartFile.is_open() ) {
         ILogger& mainLog = ILogger::getLogger( "main_log" );
         mainLog.setLevel( ILogger::SEVERE );
-        mainLog << "Could not open restart file: " << restartFileName << " for write." << endl;
+        mainLog << "Could not open restart file: " << tempFileName << " for write." << endl;
         abort();
     }
     
-    // first write the total number of entries that should be expected to help with error
-    // checking on read in
-    restartFile.write( reinterpret_cast<char*>( &mNumCollected ), sizeof( size_t ) );
+    const vector<uint64_t>& stateKeys = getStateKeys();
+    RestartHeader header;
+    memcpy( header.mMagic, RESTART_MAGIC, sizeof( RESTART_MAGIC ) );
+    header.mVersion = RESTART_VERSION;
+    header.mFlags = 0;
+    header.mNumStates = mNumCollected;
+    header.mFingerprint = hashBytes( HASH_OFFSET_BASIS, stateKeys.data(), sizeof( uint64_t ) * stateKeys.size() );
+    header.mDataSize = sizeof( double ) * mNumCollected;
+    const char* stateData = reinterpret_cast<const char*>( mStateData[0] );
     
-    // write the entire contents of the "base" state
-    restartFile.write( reinterpret_cast<char*>( mStateData[0] ), sizeof( double ) * mNumCollected );
+    vector<char> compressedState;
+    if( Configuration::getInstance()->getBool( "restart-compress", false, false ) ) {
+#if USE_ZLIB
+        uLongf compressedSize = compressBound( header.mDataSize );
+        compressedState.resize( compressedSize );
+        if( compress2( reinterpret_cast<Bytef*>( compressedState.data() ), &compressedSize, reinterpret_cast<const Bytef*>( stateData ),
+                       header.mDataSize, Z_BEST_SPEED ) == Z_OK )
+        {
+            header.mFlags |= RESTART_COMPRESSED;
+            header.mDataSize = compressedSize;
+            stateData = compressedState.data();
+        }
+#else
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "restart-compress requires building with USE_ZLIB, writing uncompressed... ";
+        mainLog.setLevel( ILogger::DEBUG );
+#endif
+    }
     
+    restartFile.write( reinterpret_cast<const char*>( &header ), sizeof( RestartHeader ) );
+    restartFile.write( reinterpret_cast<const char*>( stateKeys.data() ), sizeof( uint64_t ) * stateKeys.size() );
+    restartFile.write( stateData, header.mDataSize );
     restartFile.close();
     
+    if( !restartFile || rename( tempFileName.c_str(), restartFileName.c_str() ) != 0 ) {
+        mainLog.setLevel( ILogger::SEVERE );
+        mainLog << "Could not write restart file: " << restartFileName << endl;
+        abort();
+    }
+    
     mainLog << "Done." << endl;
 }
 
+/*!
+ * \brief Get the key of each state in the same order as the "base" state.
+ * \return The state keys.
+ */
+const vector<uint64_t>& ManageStateVariables::getStateKeys() const {
+    return mStateKeys;
+}
+
 #if DEBUG_STATE
 void Value::doStateCheck() const {
     const bool isPartialDeriv = scenario->getMarketplace()->mIsDerivativeCalc;
@@ -393,6 +934,48 @@ void Value::doStateCheck() const {
 }
 #endif
 
+/*!
+ * \brief Add a Value to the list of active state along with the owner it was
+ *        found in.
+ * \param aValue The active state Value.
+ */
+void ManageStateVariables::DoCollect::addStateValue( Value* aValue ) {
+    // The key is the position of the Value within its container.
+    PathStep& container = mPath.back();
+    const unsigned int position = container.mNumValues++;
+    mParentClass->mStateValues.push_back( aValue );
+    mParentClass->mStateOwners.push_back( mCurrOwner );
+    mParentClass->mStateKeys.push_back( hashBytes( container.mKey, &position, sizeof( position ) ) );
+    ++mParentClass->mNumCollected;
+}
+
+/*!
+ * \brief Enter a container, giving it a key from its name and year if it has
+ *        them and the key of its parent.
+ * \param aData The container being entered.
+ */
+template<typename ContainerType>
+void ManageStateVariables::DoCollect::pushPath( ContainerType* const& aData ) {
+    const string name = getContainerName( aData );
+    const int year = getContainerYear( aData );
+    uint64_t id = hashBytes( HASH_OFFSET_BASIS, name.data(), name.size() );
+    id = hashBytes( id, &year, sizeof( year ) );
+    
+    // Containers with the same name and year in the same parent are told
+    // apart by the order they were found in.
+    PathStep& parent = mPath.back();
+    const unsigned int occurrence = parent.mNumChildren[ id ]++;
+    PathStep step;
+    step.mKey = hashBytes( hashBytes( parent.mKey, &id, sizeof( id ) ), &occurrence, sizeof( occurrence ) );
+    step.mNumValues = 0;
+    mPath.push_back( step );
+}
+
+//! Leave the current container.
+void ManageStateVariables::DoCollect::popPath() {
+    mPath.pop_back();
+}
+
 template<typename DataType>
 void ManageStateVariables::DoCollect::processData( DataType& aData ) {
 #if DEBUG_STATE
@@ -407,8 +990,7 @@ void ManageStateVariables::DoCollect::processData<Value>( Value& aData ) {
     // Any SINGLE value that is tagged is considered active so long as it is not
     // contained in a retired technology for instance.
     if( !mIgnoreCurrValue ) {
-        mParentClass->mStateValues.push_front( &aData );
-        ++mParentClass->mNumCollected;
+        addStateValue( &aData );
     }
 }
 
@@ -417,8 +999,7 @@ void ManageStateVariables::DoCollect::processData<objects::PeriodVector<Value> >
     // When an ARRAY of values are tagged only the Value in [ mPeriodToCollect] is
     // considered active.
     if( !mIgnoreCurrValue ) {
-        mParentClass->mStateValues.push_front( &aData[ mParentClass->mPeriodToCollect ] );
-        ++mParentClass->mNumCollected;
+        addStateValue( &aData[ mParentClass->mPeriodToCollect ] );
     }
 }
 
@@ -429,8 +1010,7 @@ void ManageStateVariables::DoCollect::processData<objects::TechVintageVector<Val
     
     // Note, mIgnoreCurrValue should take care of out of bounds here
     if( !mIgnoreCurrValue ) {
-        mParentClass->mStateValues.push_front( &aData[ mParentClass->mPeriodToCollect ] );
-        ++mParentClass->mNumCollected;
+        addStateValue( &aData[ mParentClass->mPeriodToCollect ] );
     }
 }
 
@@ -441,25 +1021,26 @@ void ManageStateVariables::DoCollect::processData<objects::YearVector<Value> >(
     // to be from [mCCStartYear, mYearToCollect])
     if( !mIgnoreCurrValue ) {
         for( int year = std::max( mParentClass->mCCStartYear, aData.getStartYear() ); year <= mParentClass->mYearToCollect; ++year ) {
-            mParentClass->mStateValues.push_front( &aData[ year ] );
-            ++mParentClass->mNumCollected;
+            addStateValue( &aData[ year ] );
         }
     }
 }
 
 template<typename DataType>
 void ManageStateVariables::DoCollect::pushFilterStep( const DataType& aData ) {
-    // ignore most steps
+    // most steps only need to be tracked for the state keys
+    pushPath( aData );
 }
 
 template<typename DataType>
 void ManageStateVariables::DoCollect::popFilterStep( const DataType& aData ) {
-    // ignore most steps
+    popPath();
 }
 
 
 template<>
 void ManageStateVariables::DoCollect::pushFilterStep<ITechnology*>( ITechnology* const& aData ) {
+    pushPath( aData );
     // Ignore any data set within a Technology that is not operating in the current
     // model period.
     if( !aData->isOperating( mParentClass->mPeriodToCollect ) ) {
@@ -471,19 +1052,118 @@ template<>
 void ManageStateVariables::DoCollect::popFilterStep<ITechnology*>( ITechnology* const& aData ) {
     // Moving out of the current Technology so reset the ignore flag.
     mIgnoreCurrValue = false;
+    popPath();
 }
 
 template<>
 void ManageStateVariables::DoCollect::pushFilterStep<Market*>( Market* const& aData ) {
+    pushPath( aData );
     // Ignore any data set within a Market which is not for the current model year.
     if( aData->getYear() != mParentClass->mYearToCollect ) {
         mIgnoreCurrValue = true;
     }
+#if GCAM_DETERMINISTIC_SUMS
+    // The running totals of supply and demand are not part of the data
+    // definitions so add them here.
+    else {
+        for( int i = 0; i < DeterministicSum::NUM_LIMBS; ++i ) {
+            addStateValue( &aData->mDemandSum.mLimbs[ i ] );
+            addStateValue( &aData->mSupplySum.mLimbs[ i ] );
+        }
+    }
+#endif
 }
 
 template<>
 void ManageStateVariables::DoCollect::popFilterStep<Market*>( Market* const& aData ) {
     // Moving out of the current Market so reset the ignore flag.
     mIgnoreCurrValue = false;
+    popPath();
 }
 
+// Keep track of the objects which are calculated by a single IActivity so that
+// their state may be grouped together.  Note we must be careful to use the same
+// pointer the activities will give in IActivity::getStateOwner.
+
+template<>
+void ManageStateVariables::DoCollect::pushFilterStep<Sector*>( Sector* const& aData ) {
+    pushPath( aData );
+    if( !mCurrOwner ) {
+        mCurrOwner = aData;
+    }
+}
+
+template<>
+void ManageStateVariables::DoCollect::popFilterStep<Sector*>( Sector* const& aData ) {
+    if( mCurrOwner == aData ) {
+        mCurrOwner = 0;
+    }
+    popPath();
+}
+
+template<>
+void ManageStateVariables::DoCollect::pushFilterStep<AResource*>( AResource* const& aData ) {
+    pushPath( aData );
+    if( !mCurrOwner ) {
+        mCurrOwner = aData;
+    }
+}
+
+template<>
+void ManageStateVariables::DoCollect::popFilterStep<AResource*>( AResource* const& aData ) {
+    if( mCurrOwner == aData ) {
+        mCurrOwner = 0;
+    }
+    popPath();
+}
+
+template<>
+void ManageStateVariables::DoCollect::pushFilterStep<LandAllocator*>( LandAllocator* const& aData ) {
+    pushPath( aData );
+    // The LandAllocatorActivity refers to the land allocator by its interface.
+    const ILandAllocator* landAllocator = aData;
+    if( !mCurrOwner ) {
+        mCurrOwner = landAllocator;
+    }
+}
+
+template<>
+void ManageStateVariables::DoCollect::popFilterStep<LandAllocator*>( LandAllocator* const& aData ) {
+    const ILandAllocator* landAllocator = aData;
+    if( mCurrOwner == landAllocator ) {
+        mCurrOwner = 0;
+    }
+    popPath();
+}
+
+template<>
+void ManageStateVariables::DoCollect::pushFilterStep<AFinalDemand*>( AFinalDemand* const& aData ) {
+    pushPath( aData );
+    if( !mCurrOwner ) {
+        mCurrOwner = aData;
+    }
+}
+
+template<>
+void ManageStateVariables::DoCollect::popFilterStep<AFinalDemand*>( AFinalDemand* const& aData ) {
+    if( mCurrOwner == aData ) {
+        mCurrOwner = 0;
+    }
+    popPath();
+}
+
+template<>
+void ManageStateVariables::DoCollect::pushFilterStep<Consumer*>( Consumer* const& aData ) {
+    pushPath( aData );
+    if( !mCurrOwner ) {
+        mCurrOwner = aData;
+    }
+}
+
+template<>
+void ManageStateVariables::DoCollect::popFilterStep<Consumer*>( Consumer* const& aData ) {
+    if( mCurrOwner == aData ) {
+        mCurrOwner = 0;
+    }
+    popPath();
+}
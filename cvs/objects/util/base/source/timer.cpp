@@ -47,7 +47,8 @@ using namespace boost::posix_time;
 
 //! Constructor
 Timer::Timer():mTotalTime( 0 ),
-mRunning( 0 )
+mRunning( 0 ),
+mNumCalls( 0 )
 {
 }
 
@@ -78,6 +79,7 @@ void Timer::stop(){
     if( --mRunning == 0 ) {
         time_duration diff = microsec_clock::universal_time() - mStartTime;
         mTotalTime += diff.total_seconds() + pow( 10.0, -time_duration::num_fractional_digits() ) * diff.fractional_seconds();
+        ++mNumCalls;
     }
     // guard against excessive stops
     mRunning = std::max( mRunning, 0 );
@@ -91,6 +93,15 @@ double Timer::getTotalTimeDifference() const {
     return mTotalTime;
 }
 
+/*!
+ * \brief Get the number of times this timer was stopped after being started.
+ * \details Nested or overlapping starts and stops are counted once.
+ * \return The number of timed intervals.
+ */
+unsigned int Timer::getNumCalls() const {
+    return mNumCalls;
+}
+
 /*! \brief Print the accumulated time.
  * \details This function prints the accumulated time on the timer.
  *          It *can* be called on a running timer to print a split.
@@ -161,51 +172,60 @@ Timer& TimerRegistry::getTimer( const string& aTimerName ) {
  */
 void TimerRegistry::printAllTimers( ostream& aOut ) const {
     for( int timer = 0; timer < END; ++timer ) {
-        string timerName;
-        switch( timer ) {
-            case FULLSCENARIO:
-                timerName = "Full Scenario";
-                break;
-            case BISECT:
-                timerName = "Bisection solver";
-                break;
-            case SOLVER:
-                timerName = "Broyden Solver";
-                break;
-            case JACOBIAN:
-                timerName = "Jacobian calcs";
-                break;
-            case EVAL_PART:
-                timerName = "Partial function evaluations";
-                break;
-            case EVAL_FULL:
-                timerName = "Full function evaluations";
-                break;
-            case JAC_PRE:
-                timerName = "Jacobian Preconditioner (overlaps with Jacobian)";
-                break;
-            case JAC_PRE_JAC:
-                timerName = "Jacobian Preconditioner Jacobian overlap";
-                break;
-            case EDFUN_MISC:
-                timerName = "EDFUN miscellaneous";
-                break;
-            case EDFUN_PRE:
-                timerName = "EDFUN before world->calc";
-                break;
-            case EDFUN_POST:
-                timerName = "EDFUN after world->calc";
-                break;
-            case EDFUN_AN_RESET:
-                timerName = "EDFUN affected nodes reset";
-                break;
-                
-            default: timerName = "Predefined timer";
-        }
-        mPredefinedTimers[ timer ].print( aOut, timerName );
+        mPredefinedTimers[ timer ].print( aOut, getTimerName( static_cast<PredefinedTimers>( timer ) ) );
     }
     
     for( map<string, Timer>::const_iterator it = mNamedTimers.begin(); it != mNamedTimers.end(); ++it ) {
         (*it).second.print( aOut, (*it).first );
     }
 }
+
+/*!
+ * \brief Get the descriptive name of a predefined timer.
+ * \param aTimerName The identifier of the timer.
+ * \return The name of the timer.
+ */
+string TimerRegistry::getTimerName( const PredefinedTimers aTimerName ) {
+    switch( aTimerName ) {
+        case FULLSCENARIO:
+            return "Full Scenario";
+        case BISECT:
+            return "Bisection solver";
+        case SOLVER:
+            return "Broyden Solver";
+        case JACOBIAN:
+            return "Jacobian calcs";
+        case EVAL_PART:
+            return "Partial function evaluations";
+        case EVAL_FULL:
+            return "Full function evaluations";
+        case JAC_PRE:
+            return "Jacobian Preconditioner (overlaps with Jacobian)";
+        case JAC_PRE_JAC:
+            return "Jacobian Preconditioner Jacobian overlap";
+        case EDFUN_MISC:
+            return "EDFUN miscellaneous";
+        case EDFUN_PRE:
+            return "EDFUN before world->calc";
+        case EDFUN_POST:
+            return "EDFUN after world->calc";
+        case EDFUN_AN_RESET:
+            return "EDFUN affected nodes reset";
+        case WRITE_DATA:
+            return "Write output data";
+        case COPY_STATE:
+            return "Copy state for partial derivatives";
+        case BSOLVE:
+            return "Broyden iterations (overlaps with Broyden Solver)";
+        default:
+            return "Predefined timer";
+    }
+}
+
+/*!
+ * \brief Get all timers which were registered by name.
+ * \return The named timers by name.
+ */
+const map<string, Timer>& TimerRegistry::getNamedTimers() const {
+    return mNamedTimers;
+}
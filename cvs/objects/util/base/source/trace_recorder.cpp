@@ -0,0 +1,248 @@
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file trace_recorder.cpp
+ * \ingroup Objects
+ * \brief TraceRecorder and TraceScope class source file.
+ */
+
+#include "util/base/include/definitions.h"
+#include <iostream>
+#include "util/base/include/trace_recorder.h"
+#include "util/logger/include/ilogger.h"
+
+using namespace std;
+using namespace boost::posix_time;
+
+bool TraceRecorder::sEnabled = false;
+thread_local TraceRecorder::ThreadTrace* TraceRecorder::sThreadTrace = 0;
+
+namespace {
+    /*!
+     * \brief Write a string as a quoted JSON string.
+     * \param aOut The stream to write to.
+     * \param aString The string to write.
+     */
+    void writeJSONString( ostream& aOut, const string& aString ) {
+        aOut << '"';
+        for( string::const_iterator it = aString.begin(); it != aString.end(); ++it ) {
+            if( *it == '"' || *it == '\\' ) {
+                aOut << '\\';
+            }
+            aOut << *it;
+        }
+        aOut << '"';
+    }
+}
+
+//! Constructor
+TraceRecorder::TraceRecorder():mEpoch( microsec_clock::universal_time() ),
+mMaxEvents( 0 ),
+mNumEvents( 0 ),
+mNumDropped( 0 )
+{
+}
+
+/*!
+ * \brief Get the singleton instance of the TraceRecorder.
+ * \return The TraceRecorder.
+ */
+TraceRecorder& TraceRecorder::getInstance() {
+    static TraceRecorder TRACE_RECORDER;
+    return TRACE_RECORDER;
+}
+
+/*!
+ * \brief Turn recording of scopes on or off.
+ * \details Anything already recorded is kept.  This should not be called while
+ *          scopes are open.
+ * \param aEnabled Whether to record scopes.
+ * \param aMaxEvents The maximum number of individual events to keep, after which
+ *                   only the summary statistics are updated.
+ */
+void TraceRecorder::setEnabled( const bool aEnabled, const size_t aMaxEvents ) {
+    sEnabled = aEnabled;
+    mMaxEvents = aMaxEvents;
+}
+
+/*!
+ * \brief Record the current value of a counter such as the number of calls to
+ *        World::calc.
+ * \param aName The name of the counter, which must be a string literal.
+ * \param aValue The current value.
+ */
+void TraceRecorder::recordCounter( const char* aName, const double aValue ) {
+    if( !sEnabled || mNumEvents >= mMaxEvents ) {
+        return;
+    }
+    ++mNumEvents;
+    CounterEvent counter = { aName, getMicroseconds( microsec_clock::universal_time() ), aValue };
+    getThreadTrace().mCounters.push_back( counter );
+}
+
+/*!
+ * \brief Get the trace for the calling thread, creating it if this is the first
+ *        time the thread has recorded anything.
+ * \return The trace of the calling thread.
+ */
+TraceRecorder::ThreadTrace& TraceRecorder::getThreadTrace() {
+    if( !sThreadTrace ) {
+#if GCAM_PARALLEL_ENABLED
+        tbb::spin_mutex::scoped_lock lock( mMutex );
+#endif
+        mThreadTraces.push_back( ThreadTrace() );
+        sThreadTrace = &mThreadTraces.back();
+        sThreadTrace->mThreadID = mThreadTraces.size();
+    }
+    return *sThreadTrace;
+}
+
+/*!
+ * \brief Convert a time to microseconds since the recorder was created.
+ * \param aTime The time to convert.
+ * \return The number of microseconds since mEpoch.
+ */
+long TraceRecorder::getMicroseconds( const ptime& aTime ) const {
+    return static_cast<long>( ( aTime - mEpoch ).total_microseconds() );
+}
+
+/*!
+ * \brief Note the start of a scope on the calling thread so that the time of
+ *        nested scopes can be excluded from its self time.
+ */
+void TraceRecorder::beginScope() {
+    getThreadTrace().mNestedSeconds.push_back( 0 );
+}
+
+/*!
+ * \brief Record a completed scope on the calling thread.
+ * \param aCategory The category of the scope.
+ * \param aName The name of the scope.
+ * \param aStartTime The time the scope began.
+ */
+void TraceRecorder::endScope( const char* aCategory, const string& aName, const ptime& aStartTime ) {
+    const ptime endTime = microsec_clock::universal_time();
+    ThreadTrace& trace = getThreadTrace();
+    const double seconds = ( endTime - aStartTime ).total_microseconds() / 1000000.0;
+    
+    // Attribute the time to the enclosing scope as nested time.
+    const double nestedSeconds = trace.mNestedSeconds.empty() ? 0.0 : trace.mNestedSeconds.back();
+    if( !trace.mNestedSeconds.empty() ) {
+        trace.mNestedSeconds.pop_back();
+    }
+    if( !trace.mNestedSeconds.empty() ) {
+        trace.mNestedSeconds.back() += seconds;
+    }
+    
+    ScopeStats& stats = trace.mStats[ make_pair( string( aCategory ), aName ) ];
+    stats.mSeconds += seconds;
+    stats.mSelfSeconds += seconds - nestedSeconds;
+    ++stats.mNumCalls;
+    
+    if( mNumEvents++ < mMaxEvents ) {
+        TraceEvent event = { aName, aCategory, getMicroseconds( aStartTime ),
+                             static_cast<long>( ( endTime - aStartTime ).total_microseconds() ) };
+        trace.mEvents.push_back( event );
+    }
+    else {
+        ++mNumDropped;
+    }
+}
+
+/*!
+ * \brief Write everything recorded in the Chrome trace event format.
+ * \details Scopes are written as complete ("X") events and counters as counter
+ *          ("C") events, each tagged with the thread which recorded it.  The
+ *          per thread summary statistics are written under the additional
+ *          gcamSummary key which trace viewers ignore.  This should not be
+ *          called while scopes are being recorded.
+ * \param aOut The stream to write to.
+ */
+void TraceRecorder::writeChromeTrace( ostream& aOut ) const {
+#if GCAM_PARALLEL_ENABLED
+    tbb::spin_mutex::scoped_lock lock( mMutex );
+#endif
+    if( mNumDropped > 0 ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "Trace only contains the first " << mMaxEvents << " events, " << mNumDropped
+                << " more are only included in the summary." << endl;
+    }
+    
+    aOut.precision( 9 );
+    aOut << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for( list<ThreadTrace>::const_iterator threadIt = mThreadTraces.begin(); threadIt != mThreadTraces.end(); ++threadIt ) {
+        aOut << ( first ? "" : "," ) << endl << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+             << threadIt->mThreadID << ",\"args\":{\"name\":\"thread " << threadIt->mThreadID << "\"}}";
+        first = false;
+        for( vector<TraceEvent>::const_iterator it = threadIt->mEvents.begin(); it != threadIt->mEvents.end(); ++it ) {
+            aOut << "," << endl << "{\"name\":";
+            writeJSONString( aOut, it->mName );
+            aOut << ",\"cat\":\"" << it->mCategory << "\",\"ph\":\"X\",\"ts\":" << it->mStart
+                 << ",\"dur\":" << it->mDuration << ",\"pid\":1,\"tid\":" << threadIt->mThreadID << "}";
+        }
+        for( vector<CounterEvent>::const_iterator it = threadIt->mCounters.begin(); it != threadIt->mCounters.end(); ++it ) {
+            aOut << "," << endl << "{\"name\":\"" << it->mName << "\",\"ph\":\"C\",\"ts\":" << it->mTime
+                 << ",\"pid\":1,\"args\":{\"value\":" << it->mValue << "}}";
+        }
+    }
+    aOut << "]," << endl << "\"gcamSummary\":[";
+    first = true;
+    for( list<ThreadTrace>::const_iterator threadIt = mThreadTraces.begin(); threadIt != mThreadTraces.end(); ++threadIt ) {
+        for( map<pair<string, string>, ScopeStats>::const_iterator it = threadIt->mStats.begin(); it != threadIt->mStats.end(); ++it ) {
+            aOut << ( first ? "" : "," ) << endl << "{\"tid\":" << threadIt->mThreadID << ",\"cat\":";
+            writeJSONString( aOut, it->first.first );
+            aOut << ",\"name\":";
+            writeJSONString( aOut, it->first.second );
+            aOut << ",\"calls\":" << it->second.mNumCalls << ",\"seconds\":" << it->second.mSeconds
+                 << ",\"selfSeconds\":" << it->second.mSelfSeconds << "}";
+            first = false;
+        }
+    }
+    aOut << "]}" << endl;
+}
+
+/*!
+ * \brief Begin recording the scope.
+ * \param aCategory The category of the scope.
+ * \param aName The name of the scope.
+ */
+void TraceScope::start( const char* aCategory, const string& aName ) {
+    mCategory = aCategory;
+    mName = aName;
+    TraceRecorder::getInstance().beginScope();
+    mStartTime = microsec_clock::universal_time();
+}
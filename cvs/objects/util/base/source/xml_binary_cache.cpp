@@ -0,0 +1,390 @@
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file xml_binary_cache.cpp
+ * \ingroup Objects
+ * \brief XMLBinaryCache class source file.
+ */
+
+#include "util/base/include/definitions.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <xercesc/dom/DOM.hpp>
+#include <xercesc/util/XMLUniDefs.hpp>
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "util/base/include/xml_binary_cache.h"
+#include "util/base/include/configuration.h"
+#include "util/logger/include/ilogger.h"
+
+using namespace std;
+using namespace xercesc;
+
+const char XMLBinaryCache::MAGIC[ 8 ] = { 'G', 'C', 'A', 'M', 'X', 'B', 'C', '\0' };
+const unsigned int XMLBinaryCache::FORMAT_VERSION = 1;
+
+namespace {
+    //! Node type tags used in the cache file.
+    const char ELEMENT_NODE_TAG = 'E';
+    const char TEXT_NODE_TAG = 'T';
+    
+    template<typename T>
+    void append( vector<char>& aBuffer, const T& aValue ) {
+        const char* bytes = reinterpret_cast<const char*>( &aValue );
+        aBuffer.insert( aBuffer.end(), bytes, bytes + sizeof( T ) );
+    }
+    
+    void appendString( vector<char>& aBuffer, const XMLCh* aString ) {
+        const uint32_t length = aString ? XMLString::stringLen( aString ) : 0;
+        append( aBuffer, length );
+        const char* bytes = reinterpret_cast<const char*>( aString );
+        aBuffer.insert( aBuffer.end(), bytes, bytes + length * sizeof( XMLCh ) );
+    }
+    
+    template<typename T>
+    bool extract( const char*& aCurr, const char* aEnd, T& aValue ) {
+        if( static_cast<size_t>( aEnd - aCurr ) < sizeof( T ) ) {
+            return false;
+        }
+        memcpy( &aValue, aCurr, sizeof( T ) );
+        aCurr += sizeof( T );
+        return true;
+    }
+    
+    template<typename StringType>
+    bool extractString( const char*& aCurr, const char* aEnd, StringType& aString ) {
+        uint32_t length;
+        if( !extract( aCurr, aEnd, length ) ||
+            static_cast<size_t>( aEnd - aCurr ) / sizeof( XMLCh ) < length )
+        {
+            return false;
+        }
+        aString.resize( length );
+        memcpy( &aString[ 0 ], aCurr, length * sizeof( XMLCh ) );
+        aCurr += length * sizeof( XMLCh );
+        return true;
+    }
+}
+
+/*!
+ * \brief Whether the configuration has requested input files be cached.
+ * \return True if the xml-binary-cache directory has been set.
+ */
+bool XMLBinaryCache::isEnabled() {
+    return !Configuration::getInstance()->getFile( "xml-binary-cache", "", false ).empty();
+}
+
+/*!
+ * \brief Get the name of the cache file which would hold the current contents
+ *        of the given XML file.
+ * \param aXMLFile The XML input file.
+ * \return The cache file name or an empty string if aXMLFile could not be read.
+ */
+string XMLBinaryCache::getCacheFileName( const string& aXMLFile ) {
+    ifstream xmlFile( aXMLFile.c_str(), ios_base::in | ios_base::binary );
+    if( !xmlFile.is_open() ) {
+        return "";
+    }
+    xmlFile.close();
+    
+    const string& cacheDir = Configuration::getInstance()->getFile( "xml-binary-cache", "", false );
+    const string::size_type nameStart = aXMLFile.find_last_of( "/\\" );
+    const string baseName = nameStart == string::npos ? aXMLFile : aXMLFile.substr( nameStart + 1 );
+    ostringstream cacheFile;
+    cacheFile << cacheDir << '/' << baseName << '.' << hex << setw( 16 ) << setfill( '0' )
+              << hashFile( aXMLFile ) << ".bin";
+    return cacheFile.str();
+}
+
+/*!
+ * \brief Calculate a 64-bit FNV-1a hash of the entire contents of a file.
+ * \param aFile The file to hash.
+ * \return The hash of the contents.
+ */
+unsigned long long XMLBinaryCache::hashFile( const string& aFile ) {
+    const unsigned long long FNV_OFFSET = 14695981039346656037ULL;
+    const unsigned long long FNV_PRIME = 1099511628211ULL;
+    unsigned long long hash = FNV_OFFSET;
+    
+    ifstream file( aFile.c_str(), ios_base::in | ios_base::binary );
+    vector<char> buffer( 1 << 20 );
+    while( file ) {
+        file.read( &buffer[ 0 ], buffer.size() );
+        const streamsize numRead = file.gcount();
+        for( streamsize i = 0; i < numRead; ++i ) {
+            hash ^= static_cast<unsigned char>( buffer[ i ] );
+            hash *= FNV_PRIME;
+        }
+    }
+    return hash;
+}
+
+/*!
+ * \brief Rebuild a DOM document from a cache file.
+ * \param aCacheFile The cache file name as generated by getCacheFileName.
+ * \return The document which the caller is responsible for releasing or null
+ *         if the cache file does not exist or could not be read in which case
+ *         the XML file must be parsed as usual.
+ */
+DOMDocument* XMLBinaryCache::read( const string& aCacheFile ) {
+    ifstream cacheFile( aCacheFile.c_str(), ios_base::in | ios_base::binary | ios_base::ate );
+    if( !cacheFile.is_open() ) {
+        return 0;
+    }
+    vector<char> buffer( static_cast<size_t>( cacheFile.tellg() ) );
+    cacheFile.seekg( 0 );
+    cacheFile.read( buffer.data(), buffer.size() );
+    cacheFile.close();
+    
+    const char* curr = buffer.data();
+    const char* end = curr + buffer.size();
+    uint32_t version = 0;
+    uint32_t numNames = 0;
+    bool valid = static_cast<size_t>( end - curr ) >= sizeof( MAGIC ) &&
+                 memcmp( curr, MAGIC, sizeof( MAGIC ) ) == 0;
+    if( valid ) {
+        curr += sizeof( MAGIC );
+        valid = extract( curr, end, version ) && version == FORMAT_VERSION &&
+                extract( curr, end, numNames );
+    }
+    
+    // The table of all element and attribute names which nodes refer to by index.
+    vector<CacheString> names;
+    for( uint32_t nameIndex = 0; valid && nameIndex < numNames; ++nameIndex ) {
+        names.push_back( CacheString() );
+        valid = extractString( curr, end, names.back() );
+    }
+    
+    // The root element is needed to create the document.
+    char tag = 0;
+    uint32_t rootName = 0;
+    valid = valid && extract( curr, end, tag ) && tag == ELEMENT_NODE_TAG &&
+            extract( curr, end, rootName ) && rootName < names.size();
+    DOMDocument* document = 0;
+    if( valid ) {
+        static const XMLCh coreFeature[] = { chLatin_C, chLatin_o, chLatin_r, chLatin_e, chNull };
+        DOMImplementation* domImpl = DOMImplementationRegistry::getDOMImplementation( coreFeature );
+        document = domImpl->createDocument( 0, names[ rootName ].c_str(), 0 );
+        // back up to let readNode process the root attributes and children
+        curr -= sizeof( tag ) + sizeof( rootName );
+        valid = readNode( curr, end, names, document, 0 ) && curr == end;
+    }
+    
+    if( !valid ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "Ignoring invalid XML binary cache file: " << aCacheFile << endl;
+        if( document ) {
+            document->release();
+        }
+        return 0;
+    }
+    return document;
+}
+
+/*!
+ * \brief Read a single node and all of its descendants from the cache buffer.
+ * \param aCurr The current position in the buffer which will be advanced past
+ *              the node.
+ * \param aEnd The end of the buffer.
+ * \param aNames The table of element and attribute names.
+ * \param aDocument The document to create nodes in.
+ * \param aParent The node to append the new node to or null to indicate this
+ *                is the document element which has already been created.
+ * \return Whether the node was read successfully.
+ */
+bool XMLBinaryCache::readNode( const char*& aCurr, const char* aEnd, const vector<CacheString>& aNames,
+                               DOMDocument* aDocument, DOMNode* aParent )
+{
+    char tag;
+    if( !extract( aCurr, aEnd, tag ) ) {
+        return false;
+    }
+    if( tag == TEXT_NODE_TAG ) {
+        CacheString text;
+        if( !extractString( aCurr, aEnd, text ) || !aParent ) {
+            return false;
+        }
+        aParent->appendChild( aDocument->createTextNode( text.c_str() ) );
+        return true;
+    }
+    
+    uint32_t nameIndex;
+    if( tag != ELEMENT_NODE_TAG || !extract( aCurr, aEnd, nameIndex ) || nameIndex >= aNames.size() ) {
+        return false;
+    }
+    DOMElement* element = aParent ? aDocument->createElement( aNames[ nameIndex ].c_str() )
+                                  : aDocument->getDocumentElement();
+    
+    uint32_t numAttrs;
+    if( !extract( aCurr, aEnd, numAttrs ) ) {
+        return false;
+    }
+    CacheString attrValue;
+    for( uint32_t attrIndex = 0; attrIndex < numAttrs; ++attrIndex ) {
+        uint32_t attrName;
+        if( !extract( aCurr, aEnd, attrName ) || attrName >= aNames.size() ||
+            !extractString( aCurr, aEnd, attrValue ) )
+        {
+            return false;
+        }
+        element->setAttribute( aNames[ attrName ].c_str(), attrValue.c_str() );
+    }
+    
+    uint32_t numChildren;
+    if( !extract( aCurr, aEnd, numChildren ) ) {
+        return false;
+    }
+    for( uint32_t childIndex = 0; childIndex < numChildren; ++childIndex ) {
+        if( !readNode( aCurr, aEnd, aNames, aDocument, element ) ) {
+            return false;
+        }
+    }
+    
+    if( aParent ) {
+        aParent->appendChild( element );
+    }
+    return true;
+}
+
+/*!
+ * \brief Write a parsed and validated document to a cache file.
+ * \details The file is written under a temporary name unique to this process
+ *          first and then renamed so that concurrent runs never see a partially
+ *          written cache.
+ * \param aCacheFile The cache file name as generated by getCacheFileName.
+ * \param aDocument The document to write.
+ * \return Whether the cache file was successfully written.
+ */
+bool XMLBinaryCache::write( const string& aCacheFile, const DOMDocument* aDocument ) {
+    map<CacheString, unsigned int> names;
+    vector<char> nodeBuffer;
+    writeNode( aDocument->getDocumentElement(), names, nodeBuffer );
+    
+    // Order the name table by index.
+    vector<const CacheString*> nameTable( names.size() );
+    for( map<CacheString, unsigned int>::const_iterator nameIter = names.begin(); nameIter != names.end(); ++nameIter ) {
+        nameTable[ (*nameIter).second ] = &(*nameIter).first;
+    }
+    vector<char> headerBuffer( MAGIC, MAGIC + sizeof( MAGIC ) );
+    append( headerBuffer, static_cast<uint32_t>( FORMAT_VERSION ) );
+    append( headerBuffer, static_cast<uint32_t>( nameTable.size() ) );
+    for( size_t nameIndex = 0; nameIndex < nameTable.size(); ++nameIndex ) {
+        appendString( headerBuffer, nameTable[ nameIndex ]->c_str() );
+    }
+    
+    // Include the process id so concurrent runs do not write the same file.
+#if defined(_WIN32)
+    const int pid = _getpid();
+#else
+    const int pid = getpid();
+#endif
+    stringstream tempFileName;
+    tempFileName << aCacheFile << '.' << pid << ".tmp";
+    const string tempFile = tempFileName.str();
+    ofstream cacheFile( tempFile.c_str(), ios_base::out | ios_base::trunc | ios_base::binary );
+    if( cacheFile.is_open() ) {
+        cacheFile.write( headerBuffer.data(), headerBuffer.size() );
+        cacheFile.write( nodeBuffer.data(), nodeBuffer.size() );
+        cacheFile.close();
+    }
+    if( !cacheFile || rename( tempFile.c_str(), aCacheFile.c_str() ) != 0 ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "Could not write XML binary cache file: " << aCacheFile << endl;
+        remove( tempFile.c_str() );
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief Append a node and all of its descendants to the cache buffer.
+ * \details Only element and text nodes are kept as those are the only nodes
+ *          XMLParse implementations look at.
+ * \param aNode The element or text node to write.
+ * \param aNames The table of element and attribute names which will be
+ *               updated with any new names.
+ * \param aBuffer The buffer to append to.
+ */
+void XMLBinaryCache::writeNode( const DOMNode* aNode, map<CacheString, unsigned int>& aNames,
+                                vector<char>& aBuffer )
+{
+    if( aNode->getNodeType() != DOMNode::ELEMENT_NODE ) {
+        append( aBuffer, TEXT_NODE_TAG );
+        appendString( aBuffer, aNode->getNodeValue() );
+        return;
+    }
+    
+    append( aBuffer, ELEMENT_NODE_TAG );
+    const unsigned int newIndex = aNames.size();
+    append( aBuffer, static_cast<uint32_t>( aNames.insert( make_pair( CacheString( aNode->getNodeName() ), newIndex ) ).first->second ) );
+    
+    const DOMNamedNodeMap* attrs = aNode->getAttributes();
+    append( aBuffer, static_cast<uint32_t>( attrs->getLength() ) );
+    for( XMLSize_t attrIndex = 0; attrIndex < attrs->getLength(); ++attrIndex ) {
+        const DOMNode* attr = attrs->item( attrIndex );
+        const unsigned int newAttrIndex = aNames.size();
+        append( aBuffer, static_cast<uint32_t>( aNames.insert( make_pair( CacheString( attr->getNodeName() ), newAttrIndex ) ).first->second ) );
+        appendString( aBuffer, attr->getNodeValue() );
+    }
+    
+    uint32_t numChildren = 0;
+    for( const DOMNode* child = aNode->getFirstChild(); child; child = child->getNextSibling() ) {
+        const DOMNode::NodeType childType = child->getNodeType();
+        if( childType == DOMNode::ELEMENT_NODE || childType == DOMNode::TEXT_NODE ||
+            childType == DOMNode::CDATA_SECTION_NODE )
+        {
+            ++numChildren;
+        }
+    }
+    append( aBuffer, numChildren );
+    for( const DOMNode* child = aNode->getFirstChild(); child; child = child->getNextSibling() ) {
+        const DOMNode::NodeType childType = child->getNodeType();
+        if( childType == DOMNode::ELEMENT_NODE || childType == DOMNode::TEXT_NODE ||
+            childType == DOMNode::CDATA_SECTION_NODE )
+        {
+            writeNode( child, aNames, aBuffer );
+        }
+    }
+}
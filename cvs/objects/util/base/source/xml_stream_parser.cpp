@@ -0,0 +1,287 @@
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file xml_stream_parser.cpp
+ * \ingroup Objects
+ * \brief XMLStreamParser class source file.
+ */
+
+#include "util/base/include/definitions.h"
+#include <memory>
+#include <vector>
+#include <xercesc/dom/DOMImplementation.hpp>
+#include <xercesc/dom/DOMDocument.hpp>
+#include <xercesc/dom/DOMElement.hpp>
+#include <xercesc/dom/DOMException.hpp>
+#include <xercesc/sax2/SAX2XMLReader.hpp>
+#include <xercesc/sax2/XMLReaderFactory.hpp>
+#include <xercesc/sax2/DefaultHandler.hpp>
+#include <xercesc/sax2/Attributes.hpp>
+#include <xercesc/util/XMLUni.hpp>
+#include <xercesc/util/XMLUniDefs.hpp>
+
+#include "util/base/include/xml_stream_parser.h"
+#include "util/base/include/xml_helper.h"
+#include "util/base/include/iparsable.h"
+#include "util/base/include/configuration.h"
+#include "containers/include/world.h"
+#include "containers/include/region_minicam.h"
+#include "containers/include/region_cge.h"
+
+using namespace std;
+using namespace xercesc;
+
+namespace {
+    /*!
+     * \brief Whether text is only whitespace and so is just formatting.
+     * \param aText The text to check.
+     * \return True if the text contains only whitespace.
+     */
+    bool isWhitespace( const basic_string<XMLCh>& aText ) {
+        for( basic_string<XMLCh>::const_iterator it = aText.begin(); it != aText.end(); ++it ) {
+            if( *it != chSpace && *it != chHTab && *it != chLF && *it != chCR ) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    /*!
+     * \brief Whether an element is a container which merges its children by
+     *        name and so may be passed to XMLParse one child at a time.
+     * \param aName The element name.
+     * \return True if the element may be split.
+     */
+    bool isSplitContainer( const string& aName ) {
+        return aName == World::getXMLNameStatic() || aName == RegionMiniCAM::getXMLNameStatic()
+            || aName == RegionCGE::getXMLNameStatic();
+    }
+    
+    /*!
+     * \brief The SAX callbacks which build up the partial DOM trees and hand them
+     *        off to the model as each one is completed.
+     */
+    class XMLStreamHandler : public DefaultHandler {
+    public:
+        XMLStreamHandler( IParsable* aModelElement, const size_t aChunkDepth );
+        ~XMLStreamHandler();
+        
+        virtual void startElement( const XMLCh* const aURI, const XMLCh* const aLocalName,
+                                   const XMLCh* const aQName, const Attributes& aAttrs );
+        virtual void endElement( const XMLCh* const aURI, const XMLCh* const aLocalName,
+                                 const XMLCh* const aQName );
+        virtual void characters( const XMLCh* const aChars, const XMLSize_t aLength );
+        
+        //! Whether every call to XMLParse was successful.
+        bool mSuccess;
+        
+    private:
+        /*!
+         * \brief An element which has been started but not ended.
+         */
+        struct OpenElement {
+            //! The element being built.
+            DOMElement* mElement;
+            
+            //! Whether the children of this element are parsed one at a time
+            //! rather than waiting for the whole element.
+            bool mIsSplit;
+            
+            //! Whether this element has been passed to XMLParse along with one
+            //! of its children.
+            bool mHasDispatched;
+        };
+        
+        //! The model element to pass each piece to.
+        IParsable* mModelElement;
+        
+        //! The maximum depth of the elements which may be split.
+        const size_t mChunkDepth;
+        
+        //! The document which holds the element currently being built and its
+        //! ancestors.
+        DOMDocument* mDocument;
+        
+        //! The stack of elements which have been started but not ended.
+        vector<OpenElement> mOpenElements;
+        
+        //! Text which has been read but not yet added to the current element as
+        //! the parser may deliver it in several calls.
+        basic_string<XMLCh> mPendingText;
+        
+        void dispatch();
+        
+        void flushText();
+    };
+    
+    XMLStreamHandler::XMLStreamHandler( IParsable* aModelElement, const size_t aChunkDepth ):
+    mSuccess( true ),
+    mModelElement( aModelElement ),
+    mChunkDepth( aChunkDepth ),
+    mDocument( DOMImplementation::getImplementation()->createDocument() )
+    {
+    }
+    
+    XMLStreamHandler::~XMLStreamHandler() {
+        mDocument->release();
+    }
+    
+    void XMLStreamHandler::startElement( const XMLCh* const aURI, const XMLCh* const aLocalName,
+                                         const XMLCh* const aQName, const Attributes& aAttrs )
+    {
+        flushText();
+        DOMElement* element = mDocument->createElement( aQName );
+        for( XMLSize_t attrIndex = 0; attrIndex < aAttrs.getLength(); ++attrIndex ) {
+            element->setAttribute( aAttrs.getQName( attrIndex ), aAttrs.getValue( attrIndex ) );
+        }
+        
+        // The root is always split.  Below it only containers which merge by
+        // name within a split parent are split, up to the chunk depth.
+        OpenElement openElement = { element, false, false };
+        const size_t depth = mOpenElements.size();
+        if( depth == 0 ) {
+            mDocument->appendChild( element );
+            openElement.mIsSplit = true;
+        }
+        else {
+            mOpenElements.back().mElement->appendChild( element );
+            openElement.mIsSplit = depth < mChunkDepth && mOpenElements.back().mIsSplit
+                && isSplitContainer( XMLHelper<string>::safeTranscode( aQName ) );
+        }
+        mOpenElements.push_back( openElement );
+    }
+    
+    void XMLStreamHandler::endElement( const XMLCh* const aURI, const XMLCh* const aLocalName,
+                                       const XMLCh* const aQName )
+    {
+        flushText();
+        const OpenElement closed = mOpenElements.back();
+        const bool isParentSplit = mOpenElements.size() == 1 || mOpenElements[ mOpenElements.size() - 2 ].mIsSplit;
+        
+        // A complete child of a split element is parsed exactly once along with
+        // its ancestors.  A split element has already been seen by XMLParse
+        // with each of its children unless it had none in which case it is
+        // parsed once on its own so it still gets created.
+        if( isParentSplit && ( !closed.mIsSplit || !closed.mHasDispatched ) ) {
+            dispatch();
+        }
+        mOpenElements.pop_back();
+        
+        // Once parsed we can release the element so it is not seen again with
+        // the next piece.  Children of an element which is not split are still
+        // part of the piece being built.
+        if( isParentSplit && !mOpenElements.empty() ) {
+            mOpenElements.back().mElement->removeChild( closed.mElement )->release();
+        }
+    }
+    
+    void XMLStreamHandler::characters( const XMLCh* const aChars, const XMLSize_t aLength ) {
+        mPendingText.append( aChars, aLength );
+    }
+    
+    /*!
+     * \brief Pass the document as it currently stands to the model element.
+     * \details Every open element is part of the document so is marked as having
+     *          been dispatched.
+     */
+    void XMLStreamHandler::dispatch() {
+        mSuccess = mModelElement->XMLParse( mDocument->getDocumentElement() ) && mSuccess;
+        for( vector<OpenElement>::iterator it = mOpenElements.begin(); it != mOpenElements.end(); ++it ) {
+            it->mHasDispatched = true;
+        }
+    }
+    
+    /*!
+     * \brief Add any pending text as a child of the current element.
+     * \details Whitespace between the children of a split element is dropped
+     *          since the split element is kept for the next piece and would
+     *          otherwise collect the formatting of the entire file.
+     */
+    void XMLStreamHandler::flushText() {
+        if( !mPendingText.empty() && !mOpenElements.empty() &&
+            !( mOpenElements.back().mIsSplit && isWhitespace( mPendingText ) ) )
+        {
+            mOpenElements.back().mElement->appendChild( mDocument->createTextNode( mPendingText.c_str() ) );
+        }
+        mPendingText.clear();
+    }
+}
+
+/*!
+ * \brief Whether the configuration has requested input files be streamed.
+ * \return True if stream-xml-input is set.
+ */
+bool XMLStreamParser::isEnabled() {
+    return Configuration::getInstance()->getBool( "stream-xml-input", false, false );
+}
+
+/*!
+ * \brief Parse the XML file passing it to the model element a piece at a time.
+ * \details The parser is set up with the same validation settings as the DOM
+ *          parser in XMLHelper.
+ * \param aXMLFile The name of the file to parse.
+ * \param aModelElement Element to call XMLParse on.
+ * \return Whether parsing was successful.
+ */
+bool XMLStreamParser::parse( const string& aXMLFile, IParsable* aModelElement ) {
+    const int chunkDepth = Configuration::getInstance()->getInt( "xml-stream-depth", 3, false );
+    XMLStreamHandler handler( aModelElement, max( chunkDepth, 1 ) );
+    auto_ptr<SAX2XMLReader> reader( XMLReaderFactory::createXMLReader() );
+    reader->setFeature( XMLUni::fgSAX2CoreNameSpaces, false );
+    reader->setFeature( XMLUni::fgSAX2CoreValidation, true );
+    reader->setFeature( XMLUni::fgXercesDynamic, false );
+    reader->setFeature( XMLUni::fgXercesSchema, true );
+    reader->setContentHandler( &handler );
+    reader->setErrorHandler( &handler );
+    try {
+        reader->parse( aXMLFile.c_str() );
+    } catch ( const XMLException& toCatch ) {
+        string message = XMLHelper<string>::safeTranscode( toCatch.getMessage() );
+        cout << "ERROR: XML Read Exception message is:" << endl << message << endl;
+        return false;
+    } catch ( const DOMException& toCatch ) {
+        string message = XMLHelper<string>::safeTranscode( toCatch.msg );
+        cout << "ERROR: XML Read Exception message is:" << endl << message << endl;
+        return false;
+    } catch ( const SAXException& toCatch ){
+        string message = XMLHelper<string>::safeTranscode( toCatch.getMessage() );
+        cout << "ERROR: XML Read Exception message is:" << endl << message << endl;
+        return false;
+    } catch (...) {
+        cout << "ERROR:Unexpected XML Read Exception." << endl;
+        return false;
+    }
+    return handler.mSuccess;
+}
@@ -0,0 +1,82 @@
+#ifndef _PIECEWISE_LINEAR_TABLE_H_
+#define _PIECEWISE_LINEAR_TABLE_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+* \file piecewise_linear_table.h
+* \ingroup Util
+* \brief The PiecewiseLinearTable class header file.
+*/
+
+#include <vector>
+
+class Curve;
+
+/*!
+* \ingroup Util
+* \brief A read only copy of the points of a Curve sorted by x which can be
+*        evaluated quickly.
+* \details PointSetCurve keeps its points as individually allocated DataPoints in
+*          the order they were read and so each getY scans all of them several
+*          times.  That is fine for reading and writing curves but too slow for
+*          curves evaluated during World::calc.  Objects which evaluate a curve in
+*          the calculation can build this table once the curve is complete and
+*          use it instead.  The x and y values are held in contiguous arrays and
+*          a value is found by binary search.  The results are identical to those
+*          of PointSetCurve, including linear extrapolation beyond the ends of
+*          the curve.
+*/
+class PiecewiseLinearTable {
+public:
+    PiecewiseLinearTable();
+    void setCurve( const Curve* aCurve );
+    double getY( const double aX ) const;
+    double getMaxX() const;
+    double getMinX() const;
+    double getMaxY() const;
+    double getMinY() const;
+private:
+    //! The x values of the points in increasing order.
+    std::vector<double> mX;
+    
+    //! The y values of the points in the same order as mX.
+    std::vector<double> mY;
+};
+
+#endif // _PIECEWISE_LINEAR_TABLE_H_
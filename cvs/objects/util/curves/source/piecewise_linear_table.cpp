@@ -0,0 +1,152 @@
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*! 
+* \file piecewise_linear_table.cpp
+* \ingroup Util
+* \brief PiecewiseLinearTable class source file.
+*/
+
+#include "util/base/include/definitions.h"
+#include <algorithm>
+#include <cfloat>
+#include "util/curves/include/piecewise_linear_table.h"
+#include "util/curves/include/curve.h"
+#include "util/base/include/util.h"
+
+using namespace std;
+
+//! Constructor which creates a table with no points.
+PiecewiseLinearTable::PiecewiseLinearTable() {
+}
+
+/*!
+ * \brief Replace the points of the table with the points of a curve.
+ * \details This must be called again if the curve is changed.
+ * \param aCurve The curve to copy or null to remove all points.
+ */
+void PiecewiseLinearTable::setCurve( const Curve* aCurve ) {
+    mX.clear();
+    mY.clear();
+    if( aCurve ) {
+        const Curve::SortedPairVector pairs = aCurve->getSortedPairs();
+        mX.reserve( pairs.size() );
+        mY.reserve( pairs.size() );
+        for( Curve::SortedPairVector::const_iterator it = pairs.begin(); it != pairs.end(); ++it ) {
+            mX.push_back( it->first );
+            mY.push_back( it->second );
+        }
+    }
+}
+
+/*!
+ * \brief Get the y value at the given x value.
+ * \details Values between points are linearly interpolated and values outside
+ *          the points are extrapolated from the first or last two points.  The
+ *          arithmetic is the same as PointSetCurve::getY so results are identical.
+ * \param aX The x value.
+ * \return The y value, or -DBL_MAX if there are no points.
+ */
+double PiecewiseLinearTable::getY( const double aX ) const {
+    const size_t numPoints = mX.size();
+    if( numPoints == 0 ) {
+        return -DBL_MAX;
+    }
+    
+    // Find the first point above aX, the point below is the one before it.
+    const size_t above = upper_bound( mX.begin(), mX.end(), aX ) - mX.begin();
+    if( above > 0 && util::isEqual( aX, mX[ above - 1 ] ) ) {
+        return mY[ above - 1 ];
+    }
+    if( above < numPoints && util::isEqual( aX, mX[ above ] ) ) {
+        return mY[ above ];
+    }
+    if( numPoints == 1 ) {
+        return mY[ 0 ];
+    }
+    
+    // Interpolate from the point below, or extrapolate from the nearest point
+    // towards the other end of the curve.
+    size_t i1;
+    size_t i2;
+    if( above == 0 ) {
+        i1 = 1;
+        i2 = 0;
+    }
+    else if( above == numPoints ) {
+        i1 = numPoints - 1;
+        i2 = numPoints - 2;
+    }
+    else {
+        i1 = above - 1;
+        i2 = above;
+    }
+    return ( aX - mX[ i1 ] ) * ( mY[ i2 ] - mY[ i1 ] ) / ( mX[ i2 ] - mX[ i1 ] ) + mY[ i1 ];
+}
+
+/*!
+ * \brief Get the largest x value.
+ * \return The largest x value, or -DBL_MAX if there are no points.
+ */
+double PiecewiseLinearTable::getMaxX() const {
+    return mX.empty() ? -DBL_MAX : mX.back();
+}
+
+/*!
+ * \brief Get the smallest x value.
+ * \return The smallest x value, or DBL_MAX if there are no points.
+ */
+double PiecewiseLinearTable::getMinX() const {
+    return mX.empty() ? DBL_MAX : mX.front();
+}
+
+/*!
+ * \brief Get the y value of the point with the largest x value.
+ * \details This matches PointSetCurve::getMaxY which is typically used on
+ *          monotonically increasing curves.
+ * \return The y value at the largest x, or -DBL_MAX if there are no points.
+ */
+double PiecewiseLinearTable::getMaxY() const {
+    return mY.empty() ? -DBL_MAX : mY.back();
+}
+
+/*!
+ * \brief Get the y value of the point with the smallest x value.
+ * \details This matches PointSetCurve::getMinY which is typically used on
+ *          monotonically increasing curves.
+ * \return The y value at the smallest x, or DBL_MAX if there are no points.
+ */
+double PiecewiseLinearTable::getMinY() const {
+    return mY.empty() ? DBL_MAX : mY.front();
+}
@@ -49,6 +49,17 @@
 
 #include <iostream>
 #include <string>
+
+/*!
+ * \brief The lowest warning level which is compiled into the model.
+ * \details Messages below this level are discarded regardless of the logger
+ *          configuration and checks against it can be removed by the compiler
+ *          entirely.  Defaults to keeping all levels.
+ */
+#ifndef GCAM_MIN_LOG_LEVEL
+#define GCAM_MIN_LOG_LEVEL 0
+#endif
+
 /*! 
 * \ingroup objects
 * \brief This is an abstract class which defines the interface to a Logger.
@@ -77,6 +88,18 @@ public:
     virtual WarningLevel setLevel( const WarningLevel newLevel ) = 0;
     virtual bool wouldPrint(ILogger::WarningLevel aLevel) const =0;
     static ILogger& getLogger( const std::string& aLoggerName );
+
+    /*!
+     * \brief Whether messages at the given level are compiled into the model.
+     * \details This is a compile time constant so that the expensive
+     *          preparation of messages which are never printed can be skipped
+     *          without even checking a logger.
+     * \param aLevel The warning level to check.
+     * \return Whether aLevel is at least GCAM_MIN_LOG_LEVEL.
+     */
+    static constexpr bool isLevelCompiled( const WarningLevel aLevel ) {
+        return aLevel >= GCAM_MIN_LOG_LEVEL;
+    }
 };
 
 #endif // _ILOGGER_H_
@@ -48,12 +48,16 @@
 */
 
 #include <iosfwd>
-#include <sstream>
+#include <string>
 #include <xercesc/dom/DOMNode.hpp>
 #include "util/logger/include/ilogger.h"
 
 #if GCAM_PARALLEL_ENABLED
+#include <atomic>
+#include <thread>
 #include <tbb/spin_mutex.h>
+#include <tbb/concurrent_queue.h>
+#include <tbb/enumerable_thread_specific.h>
 #endif
 
 // Forward definition of the Logger class.
@@ -116,6 +120,8 @@ public:
     ILogger::WarningLevel setLevel( const ILogger::WarningLevel newLevel );
     bool wouldPrint(ILogger::WarningLevel aLevel) const;
     void toDebugXML( std::ostream& out, Tabs* tabs ) const;
+    void startWriter();
+    void stopWriter();
 protected:
 	//! Logger name
     std::string mName;
@@ -140,18 +146,51 @@ protected:
 
 	//! Defines whether to print the warning level.
     bool mPrintLogWarningLevel;
+
+    //! Whether complete messages are handed off to a background writer thread.
+    bool mIsAsynchronous;
     Logger( const std::string& aFileName = "" );
     
 	//! Log a message with the given warning level.
-    virtual void logCompleteMessage( const std::string& aMessage ) = 0;
-    void printToScreenIfConfigured( const std::string& aMessage );
+    virtual void logCompleteMessage( const std::string& aMessage, const ILogger::WarningLevel aLevel ) = 0;
+    void printToScreenIfConfigured( const std::string& aMessage, const ILogger::WarningLevel aLevel );
     static void parseHeader( std::string& aHeader );
     static const std::string& convertLevelToString( ILogger::WarningLevel aLevel );
 private:
-	 //! Buffer which contains characters waiting to be printed.
-    std::stringstream mBuf;
 #if GCAM_PARALLEL_ENABLED
-    tbb::spin_mutex mMutex;  //<! mutex protecting mBuf
+    /*!
+     * \brief A complete message waiting to be written by the background writer.
+     */
+    struct QueuedMessage {
+        //! The message text without the trailing newline.
+        std::string mMessage;
+
+        //! The warning level which was set when the message was completed.
+        ILogger::WarningLevel mLevel;
+
+        //! Flag to set once the message is written, or null if nobody is waiting.
+        std::atomic<bool>* mWritten;
+
+        //! Whether this message is the request for the writer to stop.
+        bool mIsStop;
+    };
+
+	 //! Per thread buffers which contain characters waiting to be printed so
+	 //! that threads do not need to lock to receive each character.
+    tbb::enumerable_thread_specific<std::string> mBuf;
+
+    tbb::spin_mutex mMutex;  //<! mutex protecting the synchronous write
+
+    //! Queue of complete messages for the background writer.
+    tbb::concurrent_bounded_queue<QueuedMessage> mMessageQueue;
+
+    //! The background writer thread if the logger is asynchronous.
+    std::thread mWriterThread;
+
+    void writeQueuedMessages();
+#else
+	 //! Buffer which contains characters waiting to be printed.
+    std::string mBuf;
 #endif
 
 	 //! Underlying ofstream
@@ -66,7 +66,7 @@ class PlainTextLogger: public Logger {
     public:
     void open( const char[] = 0 );
     void close();
-    void logCompleteMessage( const std::string& aMessage );
+    void logCompleteMessage( const std::string& aMessage, const ILogger::WarningLevel aLevel );
 private:
     std::ofstream mLogFile; //!< The filestream to which data is written.
     PlainTextLogger( const std::string& aLoggerName ="" );
@@ -88,21 +88,40 @@ mCurrentWarningLevel( ILogger::DEBUG ),
 mFileName( aFileName ),
 mMinLogWarningLevel( ILogger::DEBUG ),
 mMinToScreenWarningLevel( ILogger::SEVERE ),
-mPrintLogWarningLevel( false ){
+mPrintLogWarningLevel( false ),
+mIsAsynchronous( false ){
     // Set the understream's parent to this Logger.
 	mUnderStream.setParent( this );
 }
 
 //! Virtual destructor
 Logger::~Logger() {
+#if GCAM_PARALLEL_ENABLED
+    /*! \pre The writer must be stopped before the derived logger is closed. */
+    assert( !mWriterThread.joinable() );
+#endif
 }
 
-//! Set the current warning level.
+/*!
+ * \brief Set the current warning level.
+ * \details When messages at the new level would not be printed the stream is
+ *          put into a failed state so that operator<< returns immediately
+ *          without formatting anything.  Setting a level which will be
+ *          printed restores the stream.
+ * \param aLevel The new warning level.
+ * \return The previous warning level.
+ */
 ILogger::WarningLevel Logger::setLevel( const ILogger::WarningLevel aLevel ){
     // Haven't bothered to protect this with a mutex, since doing so
     // doesn't actually solve the race condition.
     ILogger::WarningLevel oldLevel = mCurrentWarningLevel;
     mCurrentWarningLevel = aLevel;
+    if( wouldPrint( aLevel ) ) {
+        clear();
+    }
+    else {
+        setstate( ios_base::badbit );
+    }
     return oldLevel;
 }
 
@@ -112,43 +131,118 @@ ILogger::WarningLevel Logger::setLevel( const ILogger::WarningLevel aLevel ){
  */
 bool Logger::wouldPrint(ILogger::WarningLevel aLevel) const
 {
-    return aLevel >= mMinLogWarningLevel || aLevel >= mMinToScreenWarningLevel;
+    return ILogger::isLevelCompiled( aLevel ) &&
+        ( aLevel >= mMinLogWarningLevel || aLevel >= mMinToScreenWarningLevel );
 }
 
 //! Receive a single character from the underlying stream and buffer it, printing the buffer it is a newline.
 int Logger::receiveCharFromUnderStream( int ch ) {
     // Only receive the character or print to the screen if it needed.
-    if( mCurrentWarningLevel >= mMinLogWarningLevel || mCurrentWarningLevel >= mMinToScreenWarningLevel ){
-        // only really need to lock the mutex if we're going to do something.
+    const ILogger::WarningLevel currLevel = mCurrentWarningLevel;
+    if( wouldPrint( currLevel ) ){
 #if GCAM_PARALLEL_ENABLED
-        tbb::spin_mutex::scoped_lock lck( mMutex );
+        // Each thread assembles its own line so no lock is needed until the
+        // message is complete.
+        string& buf = mBuf.local();
+#else
+        string& buf = mBuf;
 #endif
         if( ch == '\n' ){
-            string tempString( mBuf.str() );
-            logCompleteMessage( tempString );
-            printToScreenIfConfigured( tempString );
+#if GCAM_PARALLEL_ENABLED
+            if( mWriterThread.joinable() ) {
+                // Hand the message off to the writer thread.  Errors are
+                // typically followed by an abort so wait for those to be
+                // written before returning.
+                atomic<bool> written( false );
+                QueuedMessage msg = { buf, currLevel, currLevel >= ILogger::ERROR ? &written : 0, false };
+                mMessageQueue.push( msg );
+                while( msg.mWritten && !written.load() ) {
+                    this_thread::yield();
+                }
+            }
+            else {
+                tbb::spin_mutex::scoped_lock lck( mMutex );
+                logCompleteMessage( buf, currLevel );
+                printToScreenIfConfigured( buf, currLevel );
+            }
+#else
+            logCompleteMessage( buf, currLevel );
+            printToScreenIfConfigured( buf, currLevel );
+#endif
 
-            // reset the stringstream buffer
-            mBuf.clear();       // Clear error flags, if any.
-            mBuf.str(std::string()); // clear out the data in the buffer.
+            // reset the buffer
+            buf.clear();
        }
         else {
             // The functions that perform the output will add the
             // newline, so we only want to insert non-newline
             // characters.
-            mBuf << ( char )ch;
+            buf += ( char )ch;
         }
     }
     return ch;
 }
 
+/*!
+ * \brief Start writing complete messages from a background thread if the
+ *        logger was configured to be asynchronous.
+ * \details Threads producing messages then only need to push each complete
+ *          message onto a concurrent queue rather than waiting on the file.
+ *          Asynchronous logging requires a parallel build and is ignored
+ *          otherwise.
+ * \pre The logger has been opened.
+ */
+void Logger::startWriter() {
+#if GCAM_PARALLEL_ENABLED
+    if( mIsAsynchronous && !mWriterThread.joinable() ) {
+        mWriterThread = thread( &Logger::writeQueuedMessages, this );
+    }
+#else
+    if( mIsAsynchronous ) {
+        cout << "Asynchronous logging for " << mName << " requires a parallel build, logging synchronously." << endl;
+    }
+#endif
+}
+
+/*!
+ * \brief Stop the background writer once all queued messages are written.
+ * \details This must be called before the logger is closed.
+ */
+void Logger::stopWriter() {
+#if GCAM_PARALLEL_ENABLED
+    if( mWriterThread.joinable() ) {
+        QueuedMessage stop = { string(), ILogger::DEBUG, 0, true };
+        mMessageQueue.push( stop );
+        mWriterThread.join();
+    }
+#endif
+}
+
+#if GCAM_PARALLEL_ENABLED
+//! Write messages from the queue in the order received until asked to stop.
+void Logger::writeQueuedMessages() {
+    QueuedMessage msg;
+    while( true ) {
+        mMessageQueue.pop( msg );
+        if( msg.mIsStop ) {
+            break;
+        }
+        logCompleteMessage( msg.mMessage, msg.mLevel );
+        printToScreenIfConfigured( msg.mMessage, msg.mLevel );
+        if( msg.mWritten ) {
+            msg.mWritten->store( true );
+        }
+    }
+}
+#endif
+
 //! Print the message to the screen if the Logger is configured to.
-void Logger::printToScreenIfConfigured( const string& aMessage ){
+void Logger::printToScreenIfConfigured( const string& aMessage, const ILogger::WarningLevel aLevel ){
 	// Decide whether to print the message
-	if ( mCurrentWarningLevel >= mMinToScreenWarningLevel ) {
+	if ( aLevel >= mMinToScreenWarningLevel ) {
 		// Print the warning level
-		if ( mPrintLogWarningLevel || mCurrentWarningLevel >= ILogger::ERROR ) {
-            cout << convertLevelToString( mCurrentWarningLevel ) << ":";
+		if ( mPrintLogWarningLevel || aLevel >= ILogger::ERROR ) {
+            cout << convertLevelToString( aLevel ) << ":";
 		}
 		cout << aMessage << endl;
 	}
@@ -184,6 +278,9 @@ void Logger::XMLParse( const DOMNode* aNode ){
 		else if ( nodeName == "headerMessage" ) {
 			mHeaderMessage = XMLHelper<string>::getValue( curr );
 		}
+		else if ( nodeName == "asynchronous" ) {
+			mIsAsynchronous = XMLHelper<bool>::getValue( curr );
+		}
 	}
 }
 
@@ -194,6 +291,7 @@ void Logger::toDebugXML( ostream& out, Tabs* tabs ) const {
 	XMLWriteElement( mMinLogWarningLevel, "minLogWarningLevel", out, tabs );
 	XMLWriteElement( mMinToScreenWarningLevel, "minToScreenWarningLevel", out, tabs );
 	XMLWriteElement( mPrintLogWarningLevel, "printLogWarningLevel", out, tabs );
+	XMLWriteElement( mIsAsynchronous, "asynchronous", out, tabs );
 	XMLWriteClosingTag( "Logger", out, tabs );
 }
 
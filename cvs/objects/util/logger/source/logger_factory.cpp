@@ -91,6 +91,7 @@ void LoggerFactory::XMLParse( const DOMNode* aRoot ){
 			
 			newLogger->XMLParse( curr );
 			newLogger->open();
+			newLogger->startWriter();
 			mLoggers[ newLogger->mName ] = newLogger;
 		}
 	}
@@ -120,11 +121,31 @@ Logger& LoggerFactory::getLogger( const string& aLoggerName ) {
 //! Cleans up the logger.
 void LoggerFactory::cleanUp() {
 	for( map<string,Logger*>::iterator logIter = mLoggers.begin(); logIter != mLoggers.end(); logIter++ ){
+		logIter->second->stopWriter();
 		logIter->second->close();
 		delete logIter->second;
 	}
 }
 
+/*!
+ * \brief Stop the background writers of all asynchronous loggers.
+ * \details Loggers log synchronously until startWriters is called. This must be
+ *          called before the process is forked as the writer threads would not
+ *          exist in the child.
+ */
+void LoggerFactory::stopWriters() {
+	for( map<string,Logger*>::iterator logIter = mLoggers.begin(); logIter != mLoggers.end(); ++logIter ){
+		logIter->second->stopWriter();
+	}
+}
+
+//! Restart the background writers of all asynchronous loggers.
+void LoggerFactory::startWriters() {
+	for( map<string,Logger*>::iterator logIter = mLoggers.begin(); logIter != mLoggers.end(); ++logIter ){
+		logIter->second->startWriter();
+	}
+}
+
 /*! \brief Writes out the LoggerFactory to an XML file. 
 *
 * \param aOut Output stream to write to.